@@ -0,0 +1,530 @@
+/**
+ * @file billar_bench.cpp
+ * @brief Mide el costo de los núcleos y de Sistema::Paso para varios N y fracciones de empaque.
+ *
+ * Para cada N (potencias de 10 entre `--N_min` y `--N_max`) y cada fracción de empaque
+ * se arma una caja cuadrada con bolas de radio fijo y se miden:
+ *  - `muevase`: Bola::Muevase sobre todas las bolas, una por una;
+ *  - `mueva_bolas`, `paredes_simple`, `paredes_robusto`: los núcleos vectoriales;
+ *  - `mueva_y_paredes`: movimiento y paredes robustas fusionados en una pasada;
+ *  - `mueva_y_paredes_simple`, `paso_celdas_simple`: lo mismo y Paso con celdas, con las
+ *    bolas en float (SistemaT<float>);
+ *  - `choque_elastico`: Bola::ChoqueElastico sobre pares que sí chocan;
+ *  - `paso_<motor>`: Sistema::Paso completo con Verlet y cada motor de choques;
+ *  - `paso_celdas_desordenado`, `paso_celdas_morton`: Paso con celdas tras barajar las
+ *    bolas (como tras una corrida larga), sin reordenar y reordenando por Morton;
+ *  - `reordene_morton`: barajar y reordenar por Morton (cota del costo de un reordenamiento).
+ *
+ * Cada medición repite la operación, duplicando las repeticiones hasta pasar
+ * `--segundos`, y reporta nanosegundos por bola y paso (y su inverso, bolas por
+ * nanosegundo, el rendimiento de los núcleos de movimiento), pares probados por paso y
+ * asignaciones de memoria por paso; en Linux, si el núcleo lo permite, también los
+ * fallos y referencias de caché por paso (contadores de perf_event). El resultado se escribe en JSON (`--salida`)
+ * junto con el commit, el nivel SIMD y los hilos, para comparar motores y versiones
+ * con scripts/comparar_bench.py.
+ */
+
+#include "Sistema.h"
+#include "Kernels.h"
+#include "Corrida.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifndef BILLAR_COMMIT
+#define BILLAR_COMMIT "desconocido"
+#endif
+
+// ==========================================================
+//                CONTEO DE ASIGNACIONES
+// ==========================================================
+
+namespace {
+std::atomic<std::uint64_t> asignaciones{0};      ///< Llamadas a operator new.
+std::atomic<std::uint64_t> bytes_asignados{0};   ///< Bytes pedidos a operator new.
+}
+
+void* operator new(std::size_t n) {
+    asignaciones.fetch_add(1, std::memory_order_relaxed);
+    bytes_asignados.fetch_add(n, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t n, std::align_val_t a) {
+    asignaciones.fetch_add(1, std::memory_order_relaxed);
+    bytes_asignados.fetch_add(n, std::memory_order_relaxed);
+    const std::size_t alineacion = std::max(static_cast<std::size_t>(a), sizeof(void*));
+    if (void* p = std::aligned_alloc(alineacion, (n + alineacion - 1) / alineacion * alineacion)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t n) { return operator new(n); }
+void* operator new[](std::size_t n, std::align_val_t a) { return operator new(n, a); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+// ==========================================================
+//                  CONTADORES DE HARDWARE
+// ==========================================================
+
+/**
+ * @class ContadoresCache
+ * @brief Fallos y referencias de caché del proceso (último nivel), vía perf_event_open.
+ *
+ * Si el sistema no los ofrece (otro sistema operativo, perf_event_paranoid alto,
+ * máquina virtual sin PMU) Disponible() es falso y las mediciones quedan en null.
+ */
+class ContadoresCache {
+    int fallos = -1;      ///< Descriptor del contador de fallos.
+    int referencias = -1; ///< Descriptor del contador de referencias.
+
+#ifdef __linux__
+    /** @brief Abre un contador de hardware del proceso actual (y sus hilos nuevos). */
+    static int Abra(std::uint64_t evento) {
+        perf_event_attr a{};
+        a.type = PERF_TYPE_HARDWARE;
+        a.size = sizeof(a);
+        a.config = evento;
+        a.disabled = 1;
+        a.inherit = 1;
+        a.exclude_kernel = 1;
+        a.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &a, 0, -1, -1, 0));
+    }
+#endif
+
+public:
+    ContadoresCache() {
+#ifdef __linux__
+        fallos = Abra(PERF_COUNT_HW_CACHE_MISSES);
+        referencias = Abra(PERF_COUNT_HW_CACHE_REFERENCES);
+#endif
+    }
+    ~ContadoresCache() {
+#ifdef __linux__
+        if (fallos >= 0) close(fallos);
+        if (referencias >= 0) close(referencias);
+#endif
+    }
+    ContadoresCache(const ContadoresCache&) = delete;
+    ContadoresCache& operator=(const ContadoresCache&) = delete;
+
+    /** @brief Indica si ambos contadores se pudieron abrir. */
+    bool Disponible() const { return fallos >= 0 && referencias >= 0; }
+
+    /** @brief Pone los contadores en cero y los activa. */
+    void Inicie() {
+#ifdef __linux__
+        if (!Disponible()) return;
+        for (int fd : {fallos, referencias}) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /**
+     * @brief Detiene los contadores y lee sus valores.
+     * @param f Fallos de caché.
+     * @param r Referencias a caché.
+     */
+    void Detenga(std::uint64_t& f, std::uint64_t& r) {
+        f = r = 0;
+#ifdef __linux__
+        if (!Disponible()) return;
+        for (int fd : {fallos, referencias})
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fallos, &f, sizeof(f)) != sizeof(f) || read(referencias, &r, sizeof(r)) != sizeof(r))
+            f = r = 0;
+#endif
+    }
+};
+
+/** @brief Contadores compartidos por todas las mediciones (se abren una sola vez). */
+ContadoresCache& Contadores() {
+    static ContadoresCache contadores;
+    return contadores;
+}
+
+// ==========================================================
+//                       MEDICIONES
+// ==========================================================
+
+const double RADIO = 0.2;  ///< Radio de todas las bolas.
+const double DT = 1e-3;    ///< Paso de tiempo de las mediciones.
+
+/**
+ * @struct OpcionesBench
+ * @brief Parámetros del barrido del benchmark.
+ */
+struct OpcionesBench {
+    long N_min = 100;                              ///< Menor N.
+    long N_max = 1000000;                          ///< Mayor N.
+    std::vector<double> fracciones{0.05, 0.2, 0.4}; ///< Fracciones de empaque N*pi*r^2/(W*H).
+    std::vector<std::string> motores{"fuerza_bruta", "celdas", "paralelo", "vecinos", "eventos"}; ///< Motores de Paso.
+    long N_max_fuerza_bruta = 10000;               ///< Mayor N para fuerza bruta y eventos (O(N^2) al iniciar).
+    int hilos = 1;                                 ///< Hilos de los núcleos y del motor paralelo.
+    std::string simd = "auto";                     ///< Nivel SIMD.
+    double segundos = 0.2;                         ///< Duración mínima de cada medición.
+    std::string salida = "bench.json";             ///< Archivo JSON.
+};
+
+/**
+ * @struct Medicion
+ * @brief Resultado de una medición.
+ */
+struct Medicion {
+    std::string prueba;               ///< Operación medida.
+    long N = 0;                       ///< Número de bolas.
+    double fraccion = 0.0;            ///< Fracción de empaque.
+    long repeticiones = 0;            ///< Repeticiones de la última tanda.
+    double ns_por_paso = 0.0;         ///< Tiempo por repetición.
+    double ns_por_bola_paso = 0.0;    ///< Tiempo por repetición y por bola (o por par en choque_elastico).
+    double bolas_por_ns = 0.0;        ///< Rendimiento: bolas (o pares) procesadas por nanosegundo.
+    double pares_por_paso = 0.0;      ///< Pares probados por repetición (solo Paso).
+    double asignaciones_por_paso = 0.0; ///< Llamadas a operator new por repetición.
+    double bytes_por_paso = 0.0;      ///< Bytes asignados por repetición.
+    double fallos_cache_por_paso = std::nan("");      ///< Fallos de caché por repetición (null sin contadores).
+    double referencias_cache_por_paso = std::nan(""); ///< Referencias a caché por repetición.
+};
+
+/**
+ * @brief Repite `operacion` duplicando las repeticiones hasta superar `segundos`.
+ *
+ * Una llamada previa sin medir calienta cachés y búferes internos. Se reporta la
+ * última tanda completa.
+ *
+ * @param operacion Operación a medir (una repetición).
+ * @param segundos Duración mínima de la tanda reportada.
+ * @param m Medición (se llenan repeticiones, tiempos y asignaciones).
+ */
+template <class Operacion>
+void Mida(Operacion operacion, double segundos, Medicion& m) {
+    operacion();
+    for (long n = 1;; n *= 2) {
+        const std::uint64_t a0 = asignaciones.load(), b0 = bytes_asignados.load();
+        Contadores().Inicie();
+        auto inicio = std::chrono::steady_clock::now();
+        for (long k = 0; k < n; ++k)
+            operacion();
+        double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        std::uint64_t fallos, referencias;
+        Contadores().Detenga(fallos, referencias);
+        if (t >= segundos || n >= (1L << 24)) {
+            m.repeticiones = n;
+            m.ns_por_paso = 1e9 * t / n;
+            m.asignaciones_por_paso = static_cast<double>(asignaciones.load() - a0) / n;
+            m.bytes_por_paso = static_cast<double>(bytes_asignados.load() - b0) / n;
+            if (Contadores().Disponible()) {
+                m.fallos_cache_por_paso = static_cast<double>(fallos) / n;
+                m.referencias_cache_por_paso = static_cast<double>(referencias) / n;
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Arma un sistema de N bolas en una caja cuadrada con la fracción de empaque dada.
+ * @param N Número de bolas.
+ * @param fraccion Fracción de empaque.
+ * @param op Opciones (hilos, SIMD).
+ * @param sim Sistema a llenar (double o float).
+ */
+template <class Real>
+void ArmeSistema(long N, double fraccion, const OpcionesBench& op, SistemaT<Real>& sim) {
+    const double lado = std::sqrt(N * M_PI * RADIO * RADIO / fraccion);
+    sim.DefinaCaja(lado, lado);
+    sim.Reserve(static_cast<int>(N));
+    sim.DefinaHilos(op.hilos);
+    sim.SeleccioneSimd(op.simd);
+    sim.DefinaReorden(0);
+    sim.DefinaSemilla(12345);
+    sim.InicialiceMaxwell(1.0, RADIO, 1.0);
+}
+
+/**
+ * @brief Arma N/2 pares de bolas superpuestas que se acercan, para medir ChoqueElastico.
+ * @param pares Número de pares.
+ * @return Bolas; el par k son las bolas 2k y 2k+1.
+ */
+Particulas ArmePares(long pares) {
+    Particulas P;
+    P.Redimensione(static_cast<std::size_t>(2 * pares));
+    for (long k = 0; k < pares; ++k) {
+        const double ang = 0.1 * (k % 63);
+        const double x0 = 10.0 * k, y0 = 0.0;
+        Bola(P, 2 * k).Inicie(x0, y0, std::cos(ang), std::sin(ang), 1.0, RADIO);
+        Bola(P, 2 * k + 1).Inicie(x0 + 1.9 * RADIO * std::cos(ang), y0 + 1.9 * RADIO * std::sin(ang),
+                                  -std::cos(ang), -std::sin(ang), 1.0, RADIO);
+    }
+    return P;
+}
+
+/**
+ * @brief Mide todas las operaciones para un N y una fracción.
+ * @param N Número de bolas.
+ * @param fraccion Fracción de empaque.
+ * @param op Opciones.
+ * @param nivel Nivel SIMD de los núcleos.
+ * @param mediciones Resultados (se agregan al final).
+ */
+void MidaCaso(long N, double fraccion, const OpcionesBench& op, NivelSimd nivel, std::vector<Medicion>& mediciones) {
+    Sistema base;
+    ArmeSistema(N, fraccion, op, base);
+    const Caja& caja = base.GetCaja();
+
+    auto Agregue = [&](const std::string& prueba, double por, auto operacion) {
+        Medicion m;
+        m.prueba = prueba;
+        m.N = N;
+        m.fraccion = fraccion;
+        Mida(operacion, op.segundos, m);
+        m.ns_por_bola_paso = m.ns_por_paso / por;
+        m.bolas_por_ns = m.ns_por_bola_paso > 0.0 ? 1.0 / m.ns_por_bola_paso : 0.0;
+        mediciones.push_back(m);
+        return &mediciones.back();
+    };
+    const std::size_t primera = mediciones.size();
+
+    // --- Núcleos sobre una copia de las bolas; dt alterna de signo para no salir de la caja ---
+    Particulas P = base.GetParticulas();
+    double signo = 1.0;
+    Agregue("muevase", static_cast<double>(N), [&]() {
+        signo = -signo;
+        for (long i = 0; i < N; ++i)
+            Bola(P, i).Muevase(signo * DT);
+    });
+    Agregue("mueva_bolas", static_cast<double>(N), [&]() {
+        signo = -signo;
+        MuevaBolas(P, signo * DT, nivel, op.hilos);
+    });
+    Agregue("paredes_simple", static_cast<double>(N), [&]() { ResuelvaParedesSimple(P, caja, nivel, op.hilos); });
+    Agregue("paredes_robusto", static_cast<double>(N), [&]() { ResuelvaParedesRobusto(P, caja, nivel, op.hilos); });
+    Agregue("mueva_y_paredes", static_cast<double>(N), [&]() {
+        signo = -signo;
+        MuevaYResuelvaParedes<true>(P, caja, signo * DT, nivel, op.hilos);
+    });
+
+    // --- Las mismas bolas en float: la mitad de bytes por bola ---
+    SistemaT<float> simple;
+    ArmeSistema(N, fraccion, op, simple);
+    ParticulasT<float> F = simple.GetParticulas();
+    Agregue("mueva_y_paredes_simple", static_cast<double>(N), [&]() {
+        signo = -signo;
+        MuevaYResuelvaParedes<true>(F, caja, signo * DT, nivel, op.hilos);
+    });
+    simple.SeleccioneMotorColisiones("celdas");
+    Medicion* paso_simple = Agregue("paso_celdas_simple", static_cast<double>(N), [&]() { simple.Paso(DT); });
+    if (simple.GetPasos() > 0)
+        paso_simple->pares_por_paso = static_cast<double>(simple.GetPruebasPares()) / simple.GetPasos();
+
+    // --- ChoqueElastico: se restaura el estado antes de cada tanda y se descuenta la copia ---
+    const long pares = std::max(1L, N / 2);
+    const Particulas original = ArmePares(pares);
+    Particulas Q = original;
+    auto Restaure = [&]() {
+        std::copy(original.x.begin(), original.x.end(), Q.x.begin());
+        std::copy(original.y.begin(), original.y.end(), Q.y.begin());
+        std::copy(original.vx.begin(), original.vx.end(), Q.vx.begin());
+        std::copy(original.vy.begin(), original.vy.end(), Q.vy.begin());
+    };
+    Medicion copia;
+    Mida(Restaure, op.segundos, copia);
+    Medicion* choque = Agregue("choque_elastico", static_cast<double>(pares), [&]() {
+        Restaure();
+        for (long k = 0; k < pares; ++k)
+            Bola(Q, 2 * k).ChoqueElastico(Bola(Q, 2 * k + 1));
+    });
+    choque->ns_por_paso = std::max(0.0, choque->ns_por_paso - copia.ns_por_paso);
+    choque->ns_por_bola_paso = choque->ns_por_paso / pares;
+    choque->bolas_por_ns = choque->ns_por_bola_paso > 0.0 ? 1.0 / choque->ns_por_bola_paso : 0.0;
+
+    // --- Sistema::Paso con cada motor ---
+    for (const std::string& motor : op.motores) {
+        const bool eventos = motor == "eventos";
+        if ((motor == "fuerza_bruta" || eventos) && N > op.N_max_fuerza_bruta)
+            continue;
+        Sistema sim = base;
+        sim.SeleccioneIntegrador(eventos ? "eventos" : "verlet");
+        if (!eventos) sim.SeleccioneMotorColisiones(motor);
+        const std::uint64_t pares0 = sim.GetPruebasPares();
+        const long pasos0 = sim.GetPasos();
+        Medicion* m = Agregue("paso_" + motor, static_cast<double>(N), [&]() { sim.Paso(DT); });
+        const long pasos = sim.GetPasos() - pasos0;
+        m->pares_por_paso = pasos > 0 ? static_cast<double>(sim.GetPruebasPares() - pares0) / pasos : 0.0;
+    }
+
+    // --- Orden de las bolas: barajadas contra reordenadas por Morton ---
+    std::vector<std::uint32_t> baraja(static_cast<std::size_t>(N));
+    for (long i = 0; i < N; ++i)
+        baraja[i] = static_cast<std::uint32_t>(i);
+    Xoshiro256 rng(2024);
+    for (long i = N - 1; i > 0; --i)
+        std::swap(baraja[i], baraja[rng() % static_cast<std::uint64_t>(i + 1)]);
+    for (const bool morton : {false, true}) {
+        Sistema sim = base;
+        sim.SeleccioneMotorColisiones("celdas");
+        sim.Reordene(baraja);
+        if (morton) {
+            sim.Reordene();
+            sim.DefinaReorden(100);
+        }
+        Agregue(morton ? "paso_celdas_morton" : "paso_celdas_desordenado", static_cast<double>(N),
+                [&]() { sim.Paso(DT); });
+    }
+    Sistema desordenado = base;
+    Agregue("reordene_morton", static_cast<double>(N), [&]() {
+        desordenado.Reordene(baraja);
+        desordenado.Reordene();
+    });
+
+    for (std::size_t k = primera; k < mediciones.size(); ++k) {
+        const Medicion& m = mediciones[k];
+        std::cerr << "  " << std::left << std::setw(24) << m.prueba << std::right << std::fixed
+                  << std::setprecision(3) << std::setw(12) << m.ns_por_bola_paso << " ns/bola/paso"
+                  << std::setw(10) << m.bolas_por_ns << " bolas/ns";
+        if (m.pares_por_paso > 0)
+            std::cerr << std::setw(14) << std::setprecision(1) << m.pares_por_paso << " pares/paso";
+        if (m.referencias_cache_por_paso > 0)
+            std::cerr << std::setw(8) << std::setprecision(1)
+                      << 100.0 * m.fallos_cache_por_paso / m.referencias_cache_por_paso << " % fallos de caché";
+        std::cerr << std::defaultfloat << "\n";
+    }
+}
+
+/** @brief Separa "a,b,c" en valores. */
+std::vector<std::string> Separe(const std::string& lista) {
+    std::vector<std::string> valores;
+    std::stringstream ss(lista);
+    std::string v;
+    while (std::getline(ss, v, ','))
+        if (!v.empty()) valores.push_back(v);
+    return valores;
+}
+
+/** @brief Lee las opciones `--clave valor`. */
+OpcionesBench LeaOpciones(int argc, char* argv[]) {
+    OpcionesBench op;
+    for (int i = 1; i < argc; ++i) {
+        std::string clave = argv[i];
+        if (clave == "--ayuda" || clave == "-h" || i + 1 >= argc)
+            throw std::invalid_argument("");
+        std::string valor = argv[++i];
+        if (clave == "--N_min") op.N_min = std::stol(valor);
+        else if (clave == "--N_max") op.N_max = std::stol(valor);
+        else if (clave == "--N_max_fuerza_bruta") op.N_max_fuerza_bruta = std::stol(valor);
+        else if (clave == "--hilos") op.hilos = std::stoi(valor);
+        else if (clave == "--simd") op.simd = valor;
+        else if (clave == "--segundos") op.segundos = std::stod(valor);
+        else if (clave == "--salida") op.salida = valor;
+        else if (clave == "--motores") op.motores = Separe(valor);
+        else if (clave == "--fracciones") {
+            op.fracciones.clear();
+            for (const std::string& f : Separe(valor))
+                op.fracciones.push_back(std::stod(f));
+        } else
+            throw std::invalid_argument("Opción desconocida: " + clave);
+    }
+    if (op.N_min < 2 || op.N_max < op.N_min)
+        throw std::invalid_argument("Se necesita 2 <= N_min <= N_max.");
+    for (double f : op.fracciones)
+        if (!(f > 0.0 && f < 0.7))
+            throw std::invalid_argument("Las fracciones de empaque deben estar en (0, 0.7).");
+    return op;
+}
+
+/** @brief Escribe el resultado en JSON. */
+void EscribaJson(std::ostream& f, const OpcionesBench& op, NivelSimd nivel, bool identicos,
+                 const std::vector<Medicion>& mediciones) {
+    f << "{\n"
+      << "  \"commit\": " << TextoJson(BILLAR_COMMIT) << ",\n"
+      << "  \"simd\": " << TextoJson(NombreNivelSimd(nivel)) << ",\n"
+      << "  \"hilos\": " << op.hilos << ",\n"
+      << "  \"radio\": " << RealJson(RADIO) << ",\n"
+      << "  \"dt\": " << RealJson(DT) << ",\n"
+      << "  \"kernels_identicos\": " << (identicos ? "true" : "false") << ",\n"
+      << "  \"contadores_cache\": " << (Contadores().Disponible() ? "true" : "false") << ",\n"
+      << "  \"mediciones\": [\n";
+    for (std::size_t k = 0; k < mediciones.size(); ++k) {
+        const Medicion& m = mediciones[k];
+        f << "    {\"prueba\": " << TextoJson(m.prueba) << ", \"N\": " << m.N
+          << ", \"fraccion\": " << RealJson(m.fraccion) << ", \"repeticiones\": " << m.repeticiones
+          << ", \"ns_por_paso\": " << RealJson(m.ns_por_paso)
+          << ", \"ns_por_bola_paso\": " << RealJson(m.ns_por_bola_paso)
+          << ", \"bolas_por_ns\": " << RealJson(m.bolas_por_ns)
+          << ", \"pares_por_paso\": " << RealJson(m.pares_por_paso)
+          << ", \"asignaciones_por_paso\": " << RealJson(m.asignaciones_por_paso)
+          << ", \"bytes_por_paso\": " << RealJson(m.bytes_por_paso)
+          << ", \"fallos_cache_por_paso\": " << RealJson(m.fallos_cache_por_paso)
+          << ", \"referencias_cache_por_paso\": " << RealJson(m.referencias_cache_por_paso) << "}"
+          << (k + 1 < mediciones.size() ? "," : "") << "\n";
+    }
+    f << "  ]\n}\n";
+}
+
+} // namespace
+
+/**
+ * @brief Ejecuta el barrido del benchmark y escribe el JSON.
+ * @return 0 si terminó; 1 si las opciones no son válidas o los núcleos no coinciden.
+ */
+int main(int argc, char* argv[]) {
+    OpcionesBench op;
+    try {
+        op = LeaOpciones(argc, argv);
+    } catch (const std::exception& e) {
+        if (*e.what()) std::cerr << "Error: " << e.what() << "\n";
+        std::cerr << "Uso: " << argv[0] << " [--N_min 100] [--N_max 1000000] [--fracciones 0.05,0.2,0.4]\n"
+                  << "       [--motores fuerza_bruta,celdas,paralelo,vecinos,eventos] [--N_max_fuerza_bruta 10000]\n"
+                  << "       [--hilos 1] [--simd auto] [--segundos 0.2] [--salida bench.json]\n";
+        return 1;
+    }
+    const NivelSimd nivel = NivelSimdDesdeNombre(op.simd);
+
+    // Un núcleo vectorial que no da los mismos bits que el escalar invalida la comparación.
+    Sistema prueba;
+    ArmeSistema(1000, 0.2, op, prueba);
+    const bool identicos = KernelsIdenticos(prueba.GetParticulas(), prueba.GetCaja(), DT, nivel);
+    if (!identicos)
+        std::cerr << "ADVERTENCIA: los núcleos " << NombreNivelSimd(nivel) << " no coinciden con los escalares.\n";
+
+    std::vector<Medicion> mediciones;
+    for (long N = op.N_min; N <= op.N_max; N *= 10) {
+        for (double fraccion : op.fracciones) {
+            std::cerr << "N = " << N << ", fraccion = " << fraccion << "\n";
+            MidaCaso(N, fraccion, op, nivel, mediciones);
+        }
+    }
+
+    std::ofstream f(op.salida);
+    EscribaJson(f, op, nivel, identicos, mediciones);
+    std::cerr << "Resultados en " << op.salida << "\n";
+    return identicos ? 0 : 1;
+}
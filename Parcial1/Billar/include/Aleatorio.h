@@ -0,0 +1,110 @@
+/**
+ * @file Aleatorio.h
+ * @brief Generador xoshiro256** con saltos para obtener flujos independientes.
+ *
+ * El estado son cuatro enteros de 64 bits que se siembran con SplitMix64, así una
+ * misma semilla da la misma secuencia en cualquier compilador y biblioteca estándar.
+ * `Salte()` avanza 2^128 números: tomando el generador, saltando, tomando otra copia,
+ * etc., cada bloque de trabajo recibe un flujo propio que no se solapa con los demás.
+ * Las conversiones a real (`Uniforme`, `Normal`) también son propias por la misma razón:
+ * las distribuciones de `<random>` cambian de una biblioteca a otra.
+ */
+
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @class Xoshiro256
+ * @brief Generador xoshiro256** (Blackman y Vigna); cumple UniformRandomBitGenerator.
+ */
+class Xoshiro256 {
+private:
+    std::uint64_t s[4]; ///< Estado del generador.
+
+    /** @brief Rotación a la izquierda de 64 bits. */
+    static std::uint64_t Rote(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    /** @brief Aplica un polinomio de salto (cuatro palabras) al estado. */
+    void Aplique(const std::uint64_t polinomio[4]);
+
+public:
+    using result_type = std::uint64_t;
+
+    /**
+     * @brief Crea el generador sembrado con `semilla`.
+     * @param semilla Semilla (cualquier valor, incluido 0).
+     */
+    explicit Xoshiro256(std::uint64_t semilla = 0) { Siembre(semilla); }
+
+    /**
+     * @brief Reinicia el estado a partir de una semilla con SplitMix64.
+     * @param semilla Semilla.
+     */
+    void Siembre(std::uint64_t semilla);
+
+    /** @brief Retorna el siguiente entero de 64 bits. */
+    std::uint64_t operator()() {
+        const std::uint64_t resultado = Rote(s[1] * 5, 7) * 9;
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = Rote(s[3], 45);
+        return resultado;
+    }
+
+    /** @brief Real uniforme en [0, 1) con 53 bits de resolución. */
+    double Uniforme() { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+
+    /**
+     * @brief Par de normales estándar independientes (método polar de Marsaglia).
+     *
+     * Evita el seno y el coseno de Box–Muller a cambio de rechazar el 21 % de los
+     * puntos; sigue siendo determinista porque el rechazo depende solo del flujo.
+     *
+     * @param a Primera normal.
+     * @param b Segunda normal.
+     */
+    void Normales(double& a, double& b) {
+        double u, v, q;
+        do {
+            u = 2.0 * Uniforme() - 1.0;
+            v = 2.0 * Uniforme() - 1.0;
+            q = u * u + v * v;
+        } while (q >= 1.0 || q == 0.0);
+        const double f = std::sqrt(-2.0 * std::log(q) / q);
+        a = u * f;
+        b = v * f;
+    }
+
+    /** @brief Avanza 2^128 números: separa un flujo para otro bloque o hilo. */
+    void Salte();
+
+    /** @brief Avanza 2^192 números: separa grupos de 2^64 flujos de Salte(). */
+    void SalteLargo();
+
+    /** @brief Retorna la palabra k del estado (para checkpoints). */
+    std::uint64_t Estado(int k) const { return s[k]; }
+
+    /**
+     * @brief Reemplaza el estado completo.
+     * @param estado Cuatro palabras, no todas cero.
+     * @throws std::invalid_argument Si todas las palabras son cero.
+     */
+    void DefinaEstado(const std::uint64_t estado[4]);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    friend bool operator==(const Xoshiro256& a, const Xoshiro256& b) {
+        return a.s[0] == b.s[0] && a.s[1] == b.s[1] && a.s[2] == b.s[2] && a.s[3] == b.s[3];
+    }
+};
+
+#endif
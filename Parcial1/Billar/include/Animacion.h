@@ -0,0 +1,173 @@
+/**
+ * @file Animacion.h
+ * @brief Dibuja la caja y las bolas en un lienzo de píxeles y las guarda como GIF o video crudo.
+ *
+ * La animación se produce durante la corrida: EscritorAnimacion es un Escritor más, así
+ * que recibe los cuadros en el hilo del escritor asíncrono y la simulación no espera.
+ * El lienzo usa una paleta fija de 32 colores (fondo, borde y 16 tonos de rapidez, del
+ * azul lento al rojo rápido), que es la que necesita el GIF; para el video crudo se
+ * traduce a RGB de 24 bits.
+ */
+
+#ifndef ANIMACION_H
+#define ANIMACION_H
+
+#include "Trayectoria.h"
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/** @brief Color RGB de 24 bits. */
+using ColorRGB = std::array<std::uint8_t, 3>;
+
+/**
+ * @class Lienzo
+ * @brief Imagen de ancho x alto píxeles con un índice de paleta por píxel.
+ */
+class Lienzo {
+private:
+    int ancho, alto;                  ///< Dimensiones en píxeles.
+    std::vector<std::uint8_t> indices; ///< Índice de paleta de cada píxel, por filas desde arriba.
+
+public:
+    static constexpr int COLORES = 32;      ///< Tamaño de la paleta.
+    static constexpr std::uint8_t FONDO = 0; ///< Índice del fondo (blanco).
+    static constexpr std::uint8_t BORDE = 1; ///< Índice del borde de la caja (negro).
+    static constexpr std::uint8_t RAPIDEZ = 2; ///< Primer índice de la escala de rapidez.
+    static constexpr int TONOS = 16;         ///< Tonos de la escala de rapidez.
+
+    /**
+     * @brief Crea un lienzo relleno con el fondo.
+     * @param ancho,alto Dimensiones en píxeles.
+     * @throws std::invalid_argument Si alguna dimensión no es positiva.
+     */
+    Lienzo(int ancho, int alto);
+
+    /** @brief Retorna la paleta (COLORES entradas). */
+    static const std::array<ColorRGB, COLORES>& Paleta();
+
+    /** @brief Llena todo el lienzo con un color. */
+    void Limpie(std::uint8_t color);
+
+    /**
+     * @brief Dibuja el contorno de un rectángulo de `grosor` píxeles hacia adentro.
+     * @param x0,y0 Esquina superior izquierda.
+     * @param x1,y1 Esquina inferior derecha (exclusiva).
+     * @param grosor Grosor en píxeles.
+     * @param color Índice de paleta.
+     */
+    void Contorno(int x0, int y0, int x1, int y1, int grosor, std::uint8_t color);
+
+    /**
+     * @brief Rellena un disco; se pintan los píxeles cuyo centro cae dentro.
+     *
+     * Un disco de radio menor que un píxel se dibuja como el píxel que contiene su centro.
+     *
+     * @param cx,cy Centro en píxeles (y hacia abajo).
+     * @param r Radio en píxeles.
+     * @param color Índice de paleta.
+     */
+    void Disco(double cx, double cy, double r, std::uint8_t color);
+
+    /**
+     * @brief Traduce el lienzo a RGB de 24 bits.
+     * @param rgb Salida: 3 bytes por píxel, por filas desde arriba.
+     */
+    void ComoRGB(std::vector<std::uint8_t>& rgb) const;
+
+    int GetAncho() const { return ancho; } ///< Retorna el ancho en píxeles.
+    int GetAlto() const { return alto; }   ///< Retorna el alto en píxeles.
+    const std::vector<std::uint8_t>& GetIndices() const { return indices; } ///< Retorna los índices de paleta.
+};
+
+/**
+ * @class CodificadorGif
+ * @brief Escribe un GIF89a animado que se repite indefinidamente, cuadro por cuadro.
+ *
+ * Cada cuadro se comprime con LZW de códigos variables (hasta 12 bits) y se
+ * escribe completo, sin transparencias.
+ */
+class CodificadorGif {
+private:
+    std::ofstream f;                 ///< Archivo de salida.
+    int ancho, alto;                 ///< Dimensiones en píxeles.
+    int retardo;                     ///< Centésimas de segundo entre cuadros.
+    std::vector<std::uint16_t> hijos; ///< Árbol del diccionario LZW: hijos[código * COLORES + color].
+    std::vector<std::uint8_t> datos; ///< Cuadro comprimido, antes de partirlo en bloques.
+    std::uint32_t acumulado = 0;     ///< Bits pendientes de escribir.
+    int bits_acumulados = 0;         ///< Número de bits pendientes.
+
+    void EscribaCodigo(std::uint32_t codigo, int bits);
+
+public:
+    /**
+     * @brief Abre el archivo y escribe la cabecera, la paleta y la extensión de repetición.
+     * @param ruta Ruta del archivo.
+     * @param ancho,alto Dimensiones en píxeles (hasta 65535).
+     * @param retardo Centésimas de segundo entre cuadros.
+     * @throws std::invalid_argument Si las dimensiones no caben en el formato.
+     * @throws std::runtime_error Si no se puede abrir el archivo.
+     */
+    CodificadorGif(const std::string& ruta, int ancho, int alto, int retardo = 5);
+
+    /**
+     * @brief Comprime y escribe un cuadro.
+     * @param lienzo Lienzo con las dimensiones del GIF.
+     * @throws std::invalid_argument Si las dimensiones no coinciden.
+     */
+    void Agregue(const Lienzo& lienzo);
+
+    /** @brief Escribe el final del GIF y cierra el archivo. */
+    void Cierre();
+};
+
+/**
+ * @class EscritorAnimacion
+ * @brief Escritor que dibuja cada cuadro y lo agrega a un GIF o a un video PPM crudo.
+ *
+ * El video crudo es una secuencia de imágenes PPM (P6) concatenadas, que por ejemplo
+ * `ffmpeg -f image2pipe -framerate 20 -c:v ppm -i animacion.ppm animacion.mp4`
+ * convierte a MP4. La caja ocupa todo el ancho pedido, con `y` hacia arriba; el color
+ * de cada bola indica su rapidez entre 0 y `v_escala`.
+ */
+class EscritorAnimacion : public Escritor {
+private:
+    Lienzo lienzo;               ///< Imagen del cuadro actual.
+    CabeceraTrayectoria cab;     ///< Caja, radio y número de bolas.
+    double escala;               ///< Píxeles por unidad de longitud.
+    int margen;                  ///< Grosor del borde de la caja en píxeles.
+    int muestreo;                ///< Se dibuja uno de cada `muestreo` cuadros.
+    double v_escala;             ///< Rapidez del tono más rojo.
+    long recibidos = 0;          ///< Cuadros recibidos.
+    std::unique_ptr<CodificadorGif> gif; ///< Codificador (formato "gif").
+    std::ofstream ppm;           ///< Archivo de video crudo (formato "ppm").
+    std::vector<std::uint8_t> rgb; ///< Cuadro en RGB, reutilizado.
+
+    void Dibuje(const Cuadro& c);
+
+public:
+    /**
+     * @brief Prepara el lienzo y abre el archivo.
+     * @param ruta Ruta del archivo.
+     * @param cab Parámetros de la corrida (caja, radio, N, dt_frame).
+     * @param formato "gif" o "ppm".
+     * @param ancho Ancho de la imagen en píxeles.
+     * @param muestreo Se dibuja uno de cada `muestreo` cuadros (al menos 1).
+     * @param v_escala Rapidez que corresponde al tono más rojo.
+     * @throws std::invalid_argument Si el formato no existe o la caja no tiene área.
+     * @throws std::runtime_error Si no se puede abrir el archivo.
+     */
+    EscritorAnimacion(const std::string& ruta, const CabeceraTrayectoria& cab, const std::string& formato,
+                      int ancho, int muestreo, double v_escala);
+
+    void Escriba(const Cuadro& c) override;
+    void Cierre() override;
+
+    /** @brief Retorna el lienzo (el último cuadro dibujado). */
+    const Lienzo& GetLienzo() const { return lienzo; }
+};
+
+#endif
@@ -2,32 +2,43 @@
  * @file Bola.h
  * @brief Define la clase Bola que representa una partícula (bola) en el sistema de billar.
  * 
- * Esta clase contiene la posición, velocidad, masa y radio de una bola, 
- * así como los métodos necesarios para moverla y resolver colisiones con otras bolas o con las paredes.
+ * La posición, velocidad, masa y radio de cada bola viven en los arreglos de
+ * Particulas; Bola es una vista liviana sobre una de ellas con los métodos
+ * necesarios para moverla y resolver colisiones con otras bolas o con las paredes.
  */
 
 #ifndef BOLA_H
 #define BOLA_H
 
 #include "Caja.h"
+#include "Particulas.h"
+#include "Instrumentacion.h"
+#include <cstddef>
 
 /**
- * @class Bola
+ * @class BolaT
  * @brief Representa una bola en una simulación de billar 2D.
  * 
  * Cada bola posee propiedades físicas básicas (posición, velocidad, masa y radio)
  * y puede interactuar elásticamente con otras bolas y con las paredes de una caja.
+ * La vista solo guarda un puntero al almacenamiento y un índice, así que copiarla
+ * es barato y las modificaciones se hacen directamente sobre el sistema.
+ * Los choques se calculan en el tipo `Real` del almacenamiento; los tiempos de
+ * choque del motor por eventos siempre en double.
  */
-class Bola {
+template <class Real>
+class BolaT {
 private:
-    double x, y;   ///< Posición (x, y) de la bola en el plano.
-    double vx, vy; ///< Componentes de la velocidad (vx, vy).
-    double m;      ///< Masa de la bola.
-    double r;      ///< Radio de la bola.
+    ParticulasT<Real>* P; ///< Almacenamiento de las bolas.
+    std::size_t i; ///< Índice de esta bola dentro de P.
 
 public:
-    /** @brief Constructor por defecto. Inicializa una bola en el origen con masa y radio por defecto. */
-    Bola();
+    /**
+     * @brief Crea una vista sobre la bola i de un almacenamiento.
+     * @param P_ Almacenamiento de las bolas.
+     * @param i_ Índice de la bola.
+     */
+    BolaT(ParticulasT<Real>& P_, std::size_t i_) : P(&P_), i(i_) {}
 
     /**
      * @brief Inicializa los parámetros físicos de la bola.
@@ -69,17 +80,55 @@ public:
      * @brief Resuelve una colisión elástica con otra bola.
      * 
      * Conserva el momento lineal y la energía cinética en el sistema de dos bolas.
-     * @param otra Referencia a la otra bola.
+     * @param otra Vista de la otra bola.
+     * @return Bits de EfectoChoque con lo que se hizo (para la instrumentación).
+     */
+    unsigned ChoqueElastico(BolaT otra);
+
+    /**
+     * @brief Aplica el impulso de un choque elástico entre dos bolas en contacto exacto.
+     *
+     * A diferencia de ChoqueElastico, no verifica la superposición ni corrige posiciones;
+     * lo usa el motor por eventos, que avanza las bolas justo hasta el instante de contacto.
+     *
+     * @param otra Vista de la otra bola.
+     */
+    void ChoqueContacto(BolaT otra);
+
+    /**
+     * @brief Calcula el tiempo que falta para que esta bola toque a otra.
+     *
+     * Ambas bolas deben estar sincronizadas al mismo instante.
+     *
+     * @param otra Otra bola.
+     * @return Tiempo hasta el contacto (0 si ya se solapan y se acercan), o infinito si no chocan.
+     */
+    double TiempoChoque(const BolaT& otra) const;
+
+    /**
+     * @brief Calcula el tiempo que falta para tocar una pared de la caja.
+     * @param C Caja de la simulación.
+     * @param eje_x Si es verdadero, considera las paredes verticales (eje x); si no, las horizontales.
+     * @return Tiempo hasta el contacto, o infinito si la bola no se mueve en ese eje.
      */
-    void ChoqueElastico(Bola& otra);
+    double TiempoPared(const Caja& C, bool eje_x) const;
+
+    /** @brief Invierte la componente vx (rebote exacto contra una pared vertical). */
+    void ReboteX() { P->vx[i] = -P->vx[i]; }
+
+    /** @brief Invierte la componente vy (rebote exacto contra una pared horizontal). */
+    void ReboteY() { P->vy[i] = -P->vy[i]; }
 
     // ===== Getters =====
-    double Getx() const { return x; } ///< Retorna la coordenada x.
-    double Gety() const { return y; } ///< Retorna la coordenada y.
-    double Getvx() const { return vx; } ///< Retorna la componente vx.
-    double Getvy() const { return vy; } ///< Retorna la componente vy.
-    double Getm() const { return m; } ///< Retorna la masa.
-    double Getr() const { return r; } ///< Retorna el radio.
+    Real Getx() const { return P->x[i]; } ///< Retorna la coordenada x.
+    Real Gety() const { return P->y[i]; } ///< Retorna la coordenada y.
+    Real Getvx() const { return P->vx[i]; } ///< Retorna la componente vx.
+    Real Getvy() const { return P->vy[i]; } ///< Retorna la componente vy.
+    Real Getm() const { return P->m[i]; } ///< Retorna la masa.
+    Real Getr() const { return P->r[i]; } ///< Retorna el radio.
 };
 
+/** @brief Vista sobre una bola en doble precisión. */
+using Bola = BolaT<double>;
+
 #endif
@@ -0,0 +1,141 @@
+/**
+ * @file Celdas.h
+ * @brief Define la clase Celdas, una rejilla uniforme de celdas para la fase amplia de colisiones.
+ *
+ * La rejilla divide la caja en celdas cuadradas de lado al menos igual al diámetro
+ * de la bola más grande, de modo que dos bolas en contacto siempre ocupan la misma
+ * celda o celdas vecinas. Así solo se prueban los pares cercanos y el costo por paso
+ * crece linealmente con N a densidad fija.
+ */
+
+#ifndef CELDAS_H
+#define CELDAS_H
+
+#include "Caja.h"
+#include "Particulas.h"
+#include "Instrumentacion.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class Celdas
+ * @brief Lista de celdas (cell list) reconstruida en cada paso.
+ *
+ * Las bolas se ordenan por celda con un ordenamiento por conteo estable, por lo que
+ * dentro de cada celda aparecen en orden creciente de índice. Los métodos que reciben
+ * bolas están instanciados para double y float en Celdas.cpp.
+ */
+class Celdas {
+private:
+    double lx = 1.0, ly = 1.0;  ///< Dimensiones de cada celda (ambas mayores o iguales al lado mínimo).
+    double x0 = 0.0;            ///< Abscisa del borde izquierdo de la rejilla.
+    int nx = 1, ny = 1;         ///< Número de celdas en x y en y.
+    std::vector<int> inicio;    ///< Desplazamiento de cada celda en `indices` (tamaño nx*ny + 1).
+    std::vector<int> indices;   ///< Índices de bolas ordenados por celda.
+    std::vector<int> celda;     ///< Celda asignada a cada bola.
+    std::vector<int> lleno;     ///< Posición de escritura por celda durante la construcción.
+    std::vector<unsigned char> pendiente; ///< Bolas cuyo recorrido serial puede tener contactos (ResuelvaChoquesOrdenado).
+
+public:
+    /**
+     * @brief Ajusta la geometría de la rejilla a la caja.
+     * @param C Caja de la simulación.
+     * @param lado_min Lado mínimo de celda (normalmente el diámetro máximo).
+     * @param origen_x Abscisa del borde izquierdo; una franja de la caja (Dominio) usa su propio borde.
+     */
+    void Defina(const Caja& C, double lado_min, double origen_x = 0.0);
+
+    /**
+     * @brief Asigna cada bola a su celda.
+     * @param bolas Bolas del sistema.
+     */
+    template <class Real>
+    void Construya(const ParticulasT<Real>& bolas);
+
+    /**
+     * @brief Resuelve los choques probando solo bolas en celdas vecinas.
+     *
+     * Para cada bola i (en orden creciente) se prueban las bolas j > i de su celda
+     * y de las ocho celdas adyacentes, igual que el recorrido por fuerza bruta.
+     *
+     * @param bolas Bolas del sistema.
+     * @return Pares (i, j) probados y, con la instrumentación, el efecto de los choques.
+     */
+    template <class Real>
+    ConteoChoques ResuelvaChoques(ParticulasT<Real>& bolas) const;
+
+    /**
+     * @brief Asigna cada bola a su celda usando varios hilos.
+     *
+     * Las celdas se llenan con contadores atómicos, así que el orden dentro de cada
+     * celda depende de la planificación de los hilos. En modo determinista cada celda
+     * se ordena después por índice, lo que hace el resultado independiente del número
+     * de hilos.
+     *
+     * @param bolas Bolas del sistema.
+     * @param hilos Número de hilos.
+     * @param determinista Si es verdadero, ordena cada celda por índice.
+     */
+    template <class Real>
+    void ConstruyaParalelo(const ParticulasT<Real>& bolas, int hilos, bool determinista);
+
+    /**
+     * @brief Resuelve los choques en paralelo con un coloreo de bloques de 2x2 celdas.
+     *
+     * Un bloque solo toca bolas de sus celdas y del anillo de celdas que lo rodea.
+     * Los bloques se pintan con cuatro colores según la paridad de su fila y columna;
+     * dos bloques del mismo color están separados por al menos un bloque, de modo que
+     * ningún par de hilos escribe la misma bola dentro de una fase. Las cuatro fases
+     * se ejecutan una tras otra.
+     *
+     * @param bolas Bolas del sistema (ya asignadas con ConstruyaParalelo).
+     * @param hilos Número de hilos.
+     * @return Pares (i, j) probados y, con la instrumentación, el efecto de los choques.
+     */
+    template <class Real>
+    ConteoChoques ResuelvaChoquesParalelo(ParticulasT<Real>& bolas, int hilos) const;
+
+    /**
+     * @brief Resuelve los choques en paralelo con el mismo resultado bit a bit que ResuelvaChoques.
+     *
+     * Primero varios hilos marcan las bolas i que se superponen con alguna vecina j > i.
+     * Luego un solo hilo recorre las bolas en orden creciente y, solo para las marcadas,
+     * prueba sus pares igual que ResuelvaChoques. Cada corrección de posición marca las
+     * bolas movidas y sus vecinas de índice menor, que aún no se han recorrido, porque
+     * sus pares pudieron empezar a superponerse. Una bola sin marca tiene ella y sus
+     * vecinas j > i en la posición inicial, sin superposición, así que el recorrido
+     * serial no la habría cambiado. Los contactos son pocos y la pasada serial es corta.
+     *
+     * @param bolas Bolas del sistema (asignadas con Construya o ConstruyaParalelo determinista).
+     * @param hilos Número de hilos de la búsqueda de candidatas.
+     * @return Pares (i, j) probados por la búsqueda y, con la instrumentación, el efecto de los choques.
+     */
+    template <class Real>
+    ConteoChoques ResuelvaChoquesOrdenado(ParticulasT<Real>& bolas, int hilos);
+
+    /**
+     * @brief Llama a `visite(j)` para cada bola j de la celda de i y de sus ocho vecinas.
+     *
+     * Incluye a la propia i y a las bolas de índice menor; el llamador filtra.
+     *
+     * @param i Bola (ya asignada con Construya).
+     * @param visite Función llamada con cada índice j.
+     */
+    template <class Visitante>
+    void RecorraVecinas(int i, Visitante visite) const {
+        const int cx = celda[i] % nx;
+        const int cy = celda[i] / nx;
+        for (int ey = std::max(cy - 1, 0); ey <= std::min(cy + 1, ny - 1); ++ey)
+            for (int ex = std::max(cx - 1, 0); ex <= std::min(cx + 1, nx - 1); ++ex) {
+                const int c = ey * nx + ex;
+                for (int k = inicio[c]; k < inicio[c + 1]; ++k)
+                    visite(indices[k]);
+            }
+    }
+
+    int GetNx() const { return nx; } ///< Retorna el número de celdas en x.
+    int GetNy() const { return ny; } ///< Retorna el número de celdas en y.
+};
+
+#endif
@@ -0,0 +1,164 @@
+/**
+ * @file Columnar.h
+ * @brief Define el almacenamiento columnar por bloques de las series de tiempo de cada bola.
+ *
+ * Los cuadros se agrupan en bloques de `cuadros_por_bloque` cuadros, un número que sale de
+ * un presupuesto de memoria para el bloque en construcción. Dentro de cada bloque
+ * se guardan primero los tiempos y luego cuatro columnas (x, y, vx, vy); cada columna
+ * contiene, bola por bola, los valores consecutivos de esa bola en el bloque. Así:
+ * - la trayectoria de una bola son dos lecturas contiguas (x e y) por bloque;
+ * - las velocidades de todas las bolas en un cuadro salen de una sola lectura contigua
+ *   (columnas vx y vy) del bloque que lo contiene.
+ *
+ * Estructura del archivo (little-endian, float64):
+ * - Cabecera de 64 bytes: magia "BILLARCL", versión (uint32), cuadros_por_bloque (uint32),
+ *   N (uint64), W, H, R_BOLA, dt_frame (float64) y 8 bytes reservados.
+ * - Bloques: t[k], x[N][k], y[N][k], vx[N][k], vy[N][k], con k cuadros en el bloque.
+ * - Índice: por bloque (primer cuadro uint64, cuadros uint64, desplazamiento uint64),
+ *   seguido de número de bloques, número de cuadros y desplazamiento del índice (uint64)
+ *   y la magia "BCOLINDX".
+ */
+
+#ifndef COLUMNAR_H
+#define COLUMNAR_H
+
+#include "Trayectoria.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @enum Campo
+ * @brief Columna del almacenamiento columnar.
+ */
+enum class Campo { X = 0, Y = 1, VX = 2, VY = 3 };
+
+/**
+ * @struct BloqueColumnar
+ * @brief Entrada del índice: ubicación de un bloque de cuadros.
+ */
+struct BloqueColumnar {
+    std::uint64_t primer_cuadro;  ///< Número del primer cuadro del bloque.
+    std::uint64_t cuadros;        ///< Cuadros en el bloque.
+    std::uint64_t desplazamiento; ///< Byte donde empieza el bloque.
+};
+
+/**
+ * @class EscritorColumnar
+ * @brief Acumula cuadros en memoria y escribe un bloque columnar cada `cuadros_por_bloque`.
+ */
+class EscritorColumnar : public Escritor {
+private:
+    std::ofstream f;                    ///< Archivo de salida.
+    std::uint64_t N;                    ///< Número de bolas.
+    std::uint32_t cuadros_por_bloque;   ///< Cuadros por bloque completo.
+    std::uint32_t en_bloque = 0;        ///< Cuadros acumulados en el bloque actual.
+    std::uint64_t cuadros = 0;          ///< Cuadros escritos o acumulados.
+    std::uint64_t bytes = 64;           ///< Posición actual en el archivo.
+    std::vector<double> bloque;         ///< Bloque en construcción (t y las cuatro columnas).
+    std::vector<BloqueColumnar> indice; ///< Bloques escritos.
+
+    /** @brief Escribe el bloque acumulado (si tiene cuadros). */
+    void VacieBloque();
+
+public:
+    /**
+     * @brief Cuadros por bloque que caben en un presupuesto de bytes.
+     *
+     * Cada cuadro ocupa 8·(1 + 4N) bytes en el bloque, así que
+     * K = clamp(presupuesto / (8·(1 + 4N)), 1, maximo).
+     *
+     * @param N Número de bolas.
+     * @param presupuesto Bytes disponibles para el bloque en construcción.
+     * @param maximo Cuadros por bloque como máximo.
+     */
+    static std::uint32_t CuadrosPorBloque(std::uint64_t N, std::uint64_t presupuesto, std::uint32_t maximo = 64);
+
+    /**
+     * @brief Abre el archivo y escribe la cabecera.
+     * @param ruta Ruta del archivo.
+     * @param cab Parámetros de la corrida.
+     * @param presupuesto Bytes para el bloque en construcción (por defecto 64 MiB).
+     * @param maximo Cuadros por bloque como máximo.
+     * @throws std::invalid_argument Si maximo es 0.
+     * @throws std::runtime_error Si no se puede abrir el archivo.
+     */
+    EscritorColumnar(const std::string& ruta, const CabeceraTrayectoria& cab,
+                     std::uint64_t presupuesto = std::uint64_t{64} << 20, std::uint32_t maximo = 64);
+
+    /**
+     * @brief Transpone el cuadro dentro del bloque actual; escribe el bloque si se llena.
+     * @param c Cuadro con N bolas.
+     * @throws std::invalid_argument Si el cuadro no tiene N bolas.
+     */
+    void Escriba(const Cuadro& c) override;
+
+    /** @brief Escribe el último bloque (parcial), el índice y cierra el archivo. */
+    void Cierre() override;
+};
+
+/**
+ * @class LectorColumnar
+ * @brief Lee columnas o cuadros de un archivo columnar sin recorrerlo completo.
+ */
+class LectorColumnar {
+private:
+    mutable std::ifstream f;            ///< Archivo de entrada.
+    CabeceraTrayectoria cab;            ///< Parámetros de la corrida.
+    std::uint64_t num_cuadros = 0;      ///< Cuadros en el archivo.
+    std::vector<BloqueColumnar> indice; ///< Bloques del archivo.
+
+    /** @brief Lee n valores float64 desde el byte dado. */
+    void LeaDoubles(std::uint64_t desplazamiento, double* destino, std::size_t n) const;
+
+    /** @brief Retorna el bloque que contiene el cuadro k. */
+    const BloqueColumnar& BloqueDe(std::uint64_t k) const;
+
+public:
+    /**
+     * @brief Abre el archivo, valida la cabecera y lee el índice.
+     * @param ruta Ruta del archivo.
+     * @throws std::runtime_error Si el archivo no es columnar o no tiene índice.
+     */
+    explicit LectorColumnar(const std::string& ruta);
+
+    /** @brief Retorna los parámetros de la corrida. */
+    const CabeceraTrayectoria& GetCabecera() const { return cab; }
+
+    /** @brief Retorna el número de cuadros del archivo. */
+    std::uint64_t NumCuadros() const { return num_cuadros; }
+
+    /**
+     * @brief Lee los tiempos de todos los cuadros (una lectura por bloque).
+     * @return Vector de tiempos.
+     */
+    std::vector<double> Tiempos() const;
+
+    /**
+     * @brief Lee la serie de tiempo completa de una columna de una bola.
+     * @param i Índice de la bola.
+     * @param campo Columna a leer.
+     * @return Vector con un valor por cuadro.
+     * @throws std::out_of_range Si i no es una bola del archivo.
+     */
+    std::vector<double> Serie(std::size_t i, Campo campo) const;
+
+    /**
+     * @brief Lee las velocidades de todas las bolas en un cuadro.
+     * @param k Número de cuadro.
+     * @param vx,vy Vectores de destino (se redimensionan a N).
+     * @throws std::out_of_range Si k no es un cuadro del archivo.
+     */
+    void Velocidades(std::uint64_t k, std::vector<double>& vx, std::vector<double>& vy) const;
+
+    /**
+     * @brief Reconstruye el cuadro k completo.
+     * @param k Número de cuadro.
+     * @param c Cuadro de destino.
+     * @throws std::out_of_range Si k no es un cuadro del archivo.
+     */
+    void Lea(std::uint64_t k, Cuadro& c) const;
+};
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file Compresion.h
+ * @brief Define el formato comprimido de trayectorias y su escritor y lector.
+ *
+ * Las posiciones se cuantizan con un paso igual al doble de la tolerancia pedida
+ * (error máximo = tolerancia) y se codifican como el residuo respecto a la
+ * predicción x_anterior + vx_anterior*dt_frame, en zigzag y varint. Las velocidades
+ * se guardan sin pérdida: se hace XOR con el valor del cuadro anterior, los ceros
+ * seguidos se cuentan como una corrida y los valores distintos guardan solo sus
+ * bytes significativos. Cada `intervalo_clave` cuadros se escribe un cuadro clave,
+ * que no depende de los anteriores, y al cerrar se agrega un índice de cuadros clave
+ * para poder saltar a cualquier cuadro.
+ *
+ * Estructura del archivo (little-endian):
+ * - Cabecera de 64 bytes: magia "BILLARCZ", versión (uint32), intervalo_clave (uint32),
+ *   N (uint64), W, H, R_BOLA, dt_frame y tolerancia (float64).
+ * - Cuadros: tipo (uint8: 0 clave, 1 delta), t (float64), bytes de datos (uint32) y datos.
+ * - Índice: por cada cuadro clave (número de cuadro uint64, desplazamiento uint64, t float64),
+ *   seguido de número de entradas, número de cuadros y desplazamiento del índice (uint64)
+ *   y la magia "BCZINDEX".
+ */
+
+#ifndef COMPRESION_H
+#define COMPRESION_H
+
+#include "Trayectoria.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct EntradaIndice
+ * @brief Ubicación de un cuadro clave dentro del archivo comprimido.
+ */
+struct EntradaIndice {
+    std::uint64_t cuadro;        ///< Número del cuadro (desde 0).
+    std::uint64_t desplazamiento; ///< Byte donde empieza el registro del cuadro.
+    double t;                    ///< Instante del cuadro.
+};
+
+/**
+ * @class EscritorComprimido
+ * @brief Escribe la trayectoria en el formato comprimido.
+ */
+class EscritorComprimido : public Escritor {
+private:
+    std::ofstream f;                    ///< Archivo de salida.
+    std::uint64_t N;                    ///< Número de bolas.
+    double paso;                        ///< Paso de cuantización de posiciones.
+    double desplazamiento_pred;         ///< dt_frame / paso, para predecir posiciones.
+    std::uint32_t intervalo_clave;      ///< Cuadros entre cuadros clave.
+    std::uint64_t cuadros = 0;          ///< Cuadros escritos.
+    std::uint64_t bytes = 64;           ///< Posición actual en el archivo.
+    std::vector<std::int64_t> qx, qy;   ///< Posiciones cuantizadas del cuadro anterior.
+    std::vector<std::uint64_t> bvx, bvy; ///< Bits de las velocidades del cuadro anterior.
+    std::vector<std::uint8_t> buffer;   ///< Registro del cuadro en construcción.
+    std::vector<EntradaIndice> indice;  ///< Cuadros clave escritos.
+
+public:
+    /**
+     * @brief Abre el archivo y escribe la cabecera.
+     * @param ruta Ruta del archivo.
+     * @param cab Parámetros de la corrida.
+     * @param tolerancia Error máximo admitido en las posiciones.
+     * @param intervalo_clave Cuadros entre cuadros clave.
+     * @throws std::invalid_argument Si la tolerancia no es positiva o el intervalo es 0.
+     * @throws std::runtime_error Si no se puede abrir el archivo.
+     */
+    EscritorComprimido(const std::string& ruta, const CabeceraTrayectoria& cab,
+                       double tolerancia, std::uint32_t intervalo_clave = 100);
+
+    /**
+     * @brief Codifica un cuadro y lo escribe con una sola llamada.
+     * @param c Cuadro con N bolas.
+     * @throws std::invalid_argument Si el cuadro no tiene N bolas.
+     */
+    void Escriba(const Cuadro& c) override;
+
+    /** @brief Escribe el índice de cuadros clave y cierra el archivo. */
+    void Cierre() override;
+
+    /** @brief Retorna los bytes escritos hasta ahora (sin el índice). */
+    std::uint64_t GetBytes() const { return bytes; }
+};
+
+/**
+ * @class LectorComprimido
+ * @brief Decodifica un archivo comprimido a cuadros.
+ *
+ * La lectura secuencial decodifica cada cuadro a partir del anterior; la lectura
+ * de un cuadro arbitrario salta al cuadro clave previo y decodifica desde ahí.
+ * Si el archivo no tiene índice (p. ej. la corrida se interrumpió), se reconstruye
+ * recorriendo las cabeceras de los cuadros.
+ */
+class LectorComprimido {
+private:
+    std::ifstream f;                     ///< Archivo de entrada.
+    CabeceraTrayectoria cab;             ///< Parámetros de la corrida.
+    double tolerancia;                   ///< Tolerancia de cuantización.
+    double paso;                         ///< Paso de cuantización.
+    double desplazamiento_pred;          ///< dt_frame / paso.
+    std::uint64_t num_cuadros = 0;       ///< Cuadros en el archivo.
+    std::uint64_t fin_datos = 0;         ///< Byte donde terminan los cuadros.
+    std::vector<EntradaIndice> indice;   ///< Cuadros clave.
+    std::uint64_t siguiente = 0;         ///< Número del próximo cuadro secuencial.
+    std::uint64_t posicion = 64;         ///< Byte del próximo cuadro secuencial.
+    std::vector<std::int64_t> qx, qy;    ///< Estado de posiciones cuantizadas.
+    std::vector<std::uint64_t> bvx, bvy; ///< Estado de bits de velocidad.
+    std::vector<std::uint8_t> buffer;    ///< Datos del cuadro leído.
+
+    /** @brief Lee el índice final o lo reconstruye recorriendo el archivo. */
+    void CargueIndice();
+
+public:
+    /**
+     * @brief Abre el archivo y lee la cabecera y el índice.
+     * @param ruta Ruta del archivo.
+     * @throws std::runtime_error Si el archivo no existe o no es un archivo comprimido válido.
+     */
+    explicit LectorComprimido(const std::string& ruta);
+
+    /** @brief Retorna los parámetros de la corrida. */
+    const CabeceraTrayectoria& GetCabecera() const { return cab; }
+
+    /** @brief Retorna la tolerancia de cuantización de las posiciones. */
+    double GetTolerancia() const { return tolerancia; }
+
+    /** @brief Retorna el número de cuadros del archivo. */
+    std::uint64_t NumCuadros() const { return num_cuadros; }
+
+    /** @brief Retorna los cuadros clave (para búsquedas por tiempo). */
+    const std::vector<EntradaIndice>& GetIndice() const { return indice; }
+
+    /**
+     * @brief Decodifica el siguiente cuadro.
+     * @param c Cuadro de destino.
+     * @return false si ya no hay más cuadros.
+     * @throws std::runtime_error Si los datos están corruptos.
+     */
+    bool Siguiente(Cuadro& c);
+
+    /**
+     * @brief Decodifica el cuadro k saltando al cuadro clave anterior.
+     * @param k Número de cuadro.
+     * @param c Cuadro de destino.
+     * @throws std::out_of_range Si k no es un cuadro del archivo.
+     */
+    void Lea(std::uint64_t k, Cuadro& c);
+};
+
+#endif
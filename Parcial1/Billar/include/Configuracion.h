@@ -0,0 +1,147 @@
+/**
+ * @file Configuracion.h
+ * @brief Define los parámetros de una corrida y su lectura desde la línea de comandos o un archivo.
+ *
+ * Todos los parámetros tienen un nombre (`N`, `tf`, `dt_sim`, `integrador`, ...) que se usa
+ * igual en la línea de comandos (`--N 400`), en los archivos de configuración (`N = 400`)
+ * y en el resumen JSON. Un barrido (`--barrido N=100,200,400`) genera una corrida por cada
+ * combinación de valores.
+ */
+
+#ifndef CONFIGURACION_H
+#define CONFIGURACION_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct Configuracion
+ * @brief Parámetros completos de una corrida.
+ */
+struct Configuracion {
+    int N = 100;                       ///< Número de bolas.
+    double tf = 10.0;                  ///< Tiempo final de simulación.
+    double W = 10.0;                   ///< Ancho de la caja.
+    double H = 10.0;                   ///< Alto de la caja.
+    double dt_sim = 0.001;             ///< Paso interno de integración (sin paso adaptativo).
+    double cfl = 0.0;                  ///< Desplazamiento máximo por paso en radios (0: paso fijo dt_sim).
+    double dt_frame = 0.01;            ///< Intervalo entre cuadros de salida.
+    double m = 1.0;                    ///< Masa de cada bola.
+    double r = 0.2;                    ///< Radio de cada bola.
+    double vmax = 4.0;                 ///< Velocidad máxima inicial.
+    std::string inicial = "rejilla";   ///< "rejilla" (rapidez uniforme hasta vmax) o "maxwell".
+    double kT = 4.0;                   ///< Temperatura inicial con "maxwell" (k_B = 1).
+    std::string integrador = "verlet"; ///< "euler", "verlet" o "eventos".
+    std::string motor = "celdas";      ///< "fuerza_bruta", "celdas", "paralelo" o "vecinos".
+    double piel = 0.1;                 ///< Piel de las listas de vecinos (motor "vecinos").
+    int hilos = 1;                     ///< Hilos del motor paralelo y los núcleos vectoriales.
+    bool determinista = true;          ///< El motor paralelo reproduce bit a bit al motor "celdas".
+    std::string simd = "auto";         ///< "auto", "escalar", "avx2" o "avx512".
+    std::string precision = "doble";   ///< "doble", "simple" (bolas en float) o "validacion" (ambas a la par).
+    std::string formato = "binario64"; ///< "texto", "binario32", "binario64", "comprimido", "columnar" o "ninguno".
+    double tolerancia = 1e-4;          ///< Tolerancia de posición del formato comprimido.
+    std::string animacion = "ninguna"; ///< "ninguna", "gif" o "ppm" (video crudo), dibujada durante la corrida.
+    int pixeles = 480;                 ///< Ancho en píxeles de la animación.
+    int salida_cada = 1;               ///< Se escribe uno de cada salida_cada cuadros.
+    std::string trazadores;            ///< Ids de las bolas escritas, p. ej. "0-99,512" (vacío: todas).
+    std::string region;                ///< Región escrita "x0,y0,x1,y1" (vacío: toda la caja).
+    std::uint64_t semilla = 0;         ///< Semilla de las condiciones iniciales (0: la hora).
+    int replicas = 1;                  ///< Réplicas independientes del ensamble (1: corrida normal).
+    std::string salida = "../results"; ///< Directorio de salida.
+    std::string reanude;               ///< Checkpoint desde el cual continuar (vacío: corrida nueva).
+    int checkpoint_cada = 100;         ///< Cuadros entre checkpoints (0: solo al final).
+    int reorden_cada = 100;            ///< Pasos entre reordenamientos de Morton de las bolas (0: nunca).
+    int resumen_cada = 0;              ///< Cuadros entre líneas de instrumentación en stderr (0: ninguna).
+    int balance_cada = 1000;           ///< Pasos entre resincronizaciones de energía y momento (0: solo al final).
+    double deriva_maxima = 1e-6;       ///< Deriva relativa que dispara la alarma (0: sin alarma).
+};
+
+/**
+ * @struct Barrido
+ * @brief Lista de valores que toma un parámetro en un barrido.
+ */
+struct Barrido {
+    std::string clave;                ///< Nombre del parámetro.
+    std::vector<std::string> valores; ///< Valores, en el orden dado.
+};
+
+/**
+ * @struct OpcionesLinea
+ * @brief Resultado de leer la línea de comandos.
+ */
+struct OpcionesLinea {
+    Configuracion base;            ///< Parámetros comunes a todas las corridas.
+    std::vector<Barrido> barridos; ///< Parámetros barridos (producto cartesiano).
+    int trabajos = 0;              ///< Hilos (0: uno en barridos, todos los núcleos en ensambles).
+    bool ayuda = false;            ///< Se pidió la ayuda.
+};
+
+/**
+ * @brief Asigna un parámetro a partir de su nombre y su valor en texto.
+ * @param c Configuración a modificar.
+ * @param clave Nombre del parámetro.
+ * @param valor Valor en texto.
+ * @throws std::invalid_argument Si la clave no existe o el valor no es válido.
+ */
+void AsigneParametro(Configuracion& c, const std::string& clave, const std::string& valor);
+
+/**
+ * @brief Lee un archivo de configuración de líneas `clave = valor`.
+ *
+ * Las líneas vacías y lo que sigue a `#` se ignoran. Una línea
+ * `barrido clave = v1, v2, ...` agrega un barrido.
+ *
+ * @param ruta Ruta del archivo.
+ * @param c Configuración a modificar.
+ * @param barridos Barridos encontrados (se agregan al final).
+ * @throws std::invalid_argument Si una línea no es válida.
+ * @throws std::runtime_error Si el archivo no se puede abrir.
+ */
+void CargueConfiguracion(const std::string& ruta, Configuracion& c, std::vector<Barrido>& barridos);
+
+/**
+ * @brief Lee las opciones de la línea de comandos.
+ *
+ * Opciones: `--config archivo`, `--<clave> valor`, `--barrido clave=v1,v2,...`,
+ * `--trabajos K` y `--ayuda`. Se aplican en orden, así una opción posterior
+ * reemplaza a la del archivo.
+ *
+ * @param argc,argv Argumentos del programa.
+ * @return Opciones leídas.
+ * @throws std::invalid_argument Si una opción no es válida.
+ */
+OpcionesLinea LeaLineaComandos(int argc, char* argv[]);
+
+/**
+ * @brief Genera una configuración por cada combinación de valores de los barridos.
+ * @param base Parámetros comunes.
+ * @param barridos Parámetros barridos; el último varía más rápido.
+ * @return Configuraciones (una sola si no hay barridos).
+ * @throws std::invalid_argument Si algún valor no es válido.
+ */
+std::vector<Configuracion> ExpandaBarridos(const Configuracion& base, const std::vector<Barrido>& barridos);
+
+/**
+ * @brief Retorna todos los parámetros como pares (clave, valor en texto).
+ * @param c Configuración.
+ */
+std::vector<std::pair<std::string, std::string>> Parametros(const Configuracion& c);
+
+/**
+ * @brief Escribe la configuración en el formato de archivo (`clave = valor`).
+ * @param f Flujo de salida.
+ * @param c Configuración.
+ */
+void EscribaConfiguracion(std::ostream& f, const Configuracion& c);
+
+/**
+ * @brief Escribe la ayuda de la línea de comandos.
+ * @param f Flujo de salida.
+ * @param programa Nombre del ejecutable.
+ */
+void EscribaAyuda(std::ostream& f, const std::string& programa);
+
+#endif
@@ -0,0 +1,222 @@
+/**
+ * @file Corrida.h
+ * @brief Ejecuta corridas completas sin interacción y resume sus resultados.
+ *
+ * Una corrida arma el Sistema a partir de una Configuracion (o de un checkpoint),
+ * avanza hasta `tf` escribiendo cuadros, observables y checkpoints en su directorio,
+ * y retorna el tiempo de ejecución y el rendimiento. Un barrido ejecuta varias corridas
+ * en hilos y escribe `resumen.json` con una entrada por corrida.
+ */
+
+#ifndef CORRIDA_H
+#define CORRIDA_H
+
+#include "Configuracion.h"
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+template <class Real>
+class SistemaT;
+class Escritor;
+struct CabeceraTrayectoria;
+
+/**
+ * @struct ResultadoCorrida
+ * @brief Tiempos, rendimiento y observables de una corrida.
+ */
+struct ResultadoCorrida {
+    bool exito = false;             ///< La corrida terminó sin errores.
+    std::string error;              ///< Mensaje de error si no tuvo éxito.
+    std::string directorio;         ///< Directorio de salida de la corrida.
+    std::string ruta_trayectoria;   ///< Archivo de trayectoria (vacío con formato "ninguno").
+    std::string ruta_animacion;     ///< Archivo de la animación (vacío con animacion = "ninguna").
+    double segundos = 0.0;          ///< Tiempo de pared del bucle de simulación.
+    double segundos_espera_io = 0.0; ///< Tiempo que la simulación esperó al escritor.
+    long pasos = 0;                 ///< Llamadas a Sistema::Paso.
+    long cuadros = 0;               ///< Cuadros simulados.
+    long cuadros_escritos = 0;      ///< Cuadros entregados a los escritores (uno de cada salida_cada).
+    std::string ruta_conteo;        ///< Conteo de bolas por cuadro dentro de la región (vacío sin región).
+    std::uint64_t eventos = 0;      ///< Eventos procesados (integrador por eventos).
+    double bolas_pasos_por_segundo = 0.0; ///< N * pasos / segundos.
+    double t_inicial = 0.0;         ///< Tiempo simulado al empezar.
+    double t_final = 0.0;           ///< Tiempo simulado al terminar.
+    double energia_inicial = 0.0;   ///< Energía cinética al empezar.
+    double energia_final = 0.0;     ///< Energía cinética al terminar.
+    double temperatura = 0.0;       ///< Temperatura cinética media.
+    double chi2_maxwell = 0.0;      ///< Chi-cuadrado contra Maxwell–Boltzmann.
+    int grados_maxwell = 0;         ///< Grados de libertad de la prueba.
+    double dt_medio = 0.0;          ///< Paso medio con paso adaptativo (0 con paso fijo).
+    double dt_minimo = 0.0;         ///< Menor paso adaptativo.
+    double dt_maximo = 0.0;         ///< Mayor paso adaptativo.
+    std::uint64_t construcciones_vecinos = 0; ///< Construcciones de las listas de vecinos.
+    double vecinos_por_bola = 0.0;  ///< Largo medio de las listas de vecinos por bola.
+    double validacion_energia = 0.0; ///< Mayor |E_simple - E_doble| / E_doble entre cuadros (precision = validacion).
+    double validacion_momento = 0.0; ///< Mayor |p_simple - p_doble| / Σ m|v| entre cuadros.
+    double validacion_temperatura = 0.0; ///< Diferencia relativa de la temperatura media.
+    double validacion_chi2 = 0.0;   ///< Diferencia relativa del chi-cuadrado de Maxwell–Boltzmann.
+    double impulso_izquierda = 0.0; ///< Impulso recibido por la pared x = 0 durante la corrida.
+    double impulso_derecha = 0.0;   ///< Impulso recibido por la pared x = W.
+    double impulso_abajo = 0.0;     ///< Impulso recibido por la pared y = 0.
+    double impulso_arriba = 0.0;    ///< Impulso recibido por la pared y = H.
+    double presion = 0.0;           ///< Impulso total / (perímetro * tiempo simulado).
+    double compresibilidad = 0.0;   ///< P W H / (N kT), con kT la temperatura media (1 para un gas ideal).
+    double deriva_energia = 0.0;    ///< Mayor deriva relativa de la energía llevada paso a paso.
+    double deriva_momento = 0.0;    ///< Mayor deriva relativa del momento llevado paso a paso.
+    std::uint64_t resincronizaciones = 0; ///< Veces que el balance se comparó con una suma completa.
+    std::uint64_t alarmas_deriva = 0; ///< Resincronizaciones con deriva sobre deriva_maxima.
+};
+
+/**
+ * @brief Calcula la capacidad máxima de bolas en la caja
+ * @param W Ancho de la caja
+ * @param H Alto de la caja
+ * @param r Radio de cada bola
+ * @return Número máximo de bolas que caben en la caja
+ */
+int CalcularCapacidadMaxima(double W, double H, double r);
+
+/**
+ * @brief Arma el estado inicial de una corrida.
+ *
+ * Con `reanude` carga el checkpoint; si no, crea la caja y la rejilla de bolas.
+ * En ambos casos aplica hilos, determinismo, núcleo vectorial e intervalo de reordenamiento.
+ * Las funciones que reciben un sistema están instanciadas para double y float.
+ *
+ * @param sim Sistema recién construido.
+ * @param c Parámetros de la corrida.
+ * @param semilla Semilla de las condiciones iniciales (0: no se cambia).
+ */
+template <class Real>
+void PrepareSistema(SistemaT<Real>& sim, const Configuracion& c, std::uint64_t semilla);
+
+/**
+ * @brief Retorna los pasos de dt_sim que forman un cuadro de dt_frame (al menos uno).
+ * @param c Parámetros de la corrida.
+ */
+long PasosPorCuadro(const Configuracion& c);
+
+/**
+ * @brief Avanza el sistema un cuadro de dt_frame.
+ *
+ * Con `cfl` > 0 el paso se adapta a la rapidez máxima (Sistema::AvanceAdaptativo);
+ * si no, se dan PasosPorCuadro pasos de dt_sim. El integrador por eventos avanza
+ * el cuadro en un solo paso.
+ *
+ * @param sim Sistema.
+ * @param c Parámetros de la corrida.
+ * @return Pasos dados.
+ */
+template <class Real>
+long AvanceCuadro(SistemaT<Real>& sim, const Configuracion& c);
+
+/**
+ * @brief Intervalo de observables para Sistema::DefinaObservables: una muestra por cuadro.
+ * @param sim Sistema ya preparado (se consulta el integrador).
+ * @param c Parámetros de la corrida.
+ */
+template <class Real>
+int IntervaloObservables(const SistemaT<Real>& sim, const Configuracion& c);
+
+/**
+ * @brief Límite superior del histograma de rapideces (Sistema::DefinaObservables).
+ *
+ * Tres veces la rapidez típica inicial: vmax con la rejilla, sqrt(2 kT / m) con Maxwell,
+ * o la rapidez máxima de las bolas al reanudar un checkpoint o si las anteriores son 0.
+ * Depende solo de la configuración en corridas nuevas, así que todas las réplicas de un
+ * ensamble comparten los intervalos.
+ *
+ * @param sim Sistema ya preparado.
+ * @param c Parámetros de la corrida.
+ * @return Límite positivo.
+ */
+template <class Real>
+double RapidezMaximaHistograma(const SistemaT<Real>& sim, const Configuracion& c);
+
+/**
+ * @brief Crea el escritor de trayectorias del formato pedido.
+ * @param formato "texto", "binario32", "binario64", "comprimido", "columnar" o "ninguno".
+ * @param base Ruta sin extensión.
+ * @param cab Parámetros de la corrida.
+ * @param tolerancia Tolerancia del formato comprimido.
+ * @param ruta Ruta del archivo creado (salida).
+ * @return Escritor, o nulo con el formato "ninguno".
+ * @throws std::invalid_argument Si el formato no existe.
+ */
+std::unique_ptr<Escritor> CreeEscritor(const std::string& formato, const std::string& base,
+                                       const CabeceraTrayectoria& cab, double tolerancia, std::string& ruta);
+
+/**
+ * @brief Crea el escritor de la animación (EscritorAnimacion) pedida en `c.animacion`.
+ *
+ * Con más de 500 cuadros se dibuja uno de cada cuadros/300.
+ *
+ * @param c Parámetros de la corrida (animacion, pixeles, tf, dt_frame, vmax, kT, m).
+ * @param cab Caja, radio y número de bolas.
+ * @param base Ruta sin extensión (se agrega ".gif" o ".ppm").
+ * @param ruta Ruta del archivo creado (salida).
+ * @return Escritor, o nulo con animacion = "ninguna".
+ */
+std::unique_ptr<Escritor> CreeAnimacion(const Configuracion& c, const CabeceraTrayectoria& cab,
+                                        const std::string& base, std::string& ruta);
+
+/**
+ * @brief Ejecuta una corrida completa sin pedir nada al usuario.
+ *
+ * Escribe en `directorio` la trayectoria (`trayectorias.*`, o `trayectorias_reanudada.*`
+ * si se continúa un checkpoint), la animación (`animacion.gif` o `animacion.ppm`) si se
+ * pidió, `observables.dat`, `checkpoint.bin` y `parametros.cfg`.
+ * Con `precision = validacion` avanza además una copia en float a la par y escribe
+ * `validacion.dat` con la diferencia de energía y momento en cada cuadro.
+ * Los errores se reportan en el resultado en lugar de lanzarse.
+ *
+ * @param c Parámetros de la corrida.
+ * @param directorio Directorio de salida (se crea si no existe).
+ * @param progreso Si es true, muestra el porcentaje de avance en la consola.
+ * @return Resultado de la corrida.
+ */
+ResultadoCorrida EjecuteCorrida(const Configuracion& c, const std::string& directorio, bool progreso = false);
+
+/**
+ * @brief Ejecuta varias corridas, hasta `trabajos` a la vez.
+ *
+ * Con una sola corrida se usa su directorio `salida`; con varias, cada una
+ * usa `salida/corrida_XXX` según su posición en la lista.
+ *
+ * @param corridas Configuraciones a ejecutar.
+ * @param trabajos Corridas simultáneas.
+ * @return Resultados en el mismo orden que `corridas`.
+ */
+std::vector<ResultadoCorrida> EjecuteBarrido(const std::vector<Configuracion>& corridas, int trabajos);
+
+/**
+ * @brief Escapa un texto como cadena JSON (con comillas).
+ * @param s Texto.
+ */
+std::string TextoJson(const std::string& s);
+
+/**
+ * @brief Escribe un real como número JSON (`null` si no es finito).
+ * @param v Valor.
+ */
+std::string RealJson(double v);
+
+/**
+ * @brief Escribe los parámetros de una configuración como objeto JSON.
+ * @param f Flujo de salida.
+ * @param c Configuración.
+ */
+void EscribaParametrosJson(std::ostream& f, const Configuracion& c);
+
+/**
+ * @brief Escribe el resumen de un barrido en JSON.
+ * @param f Flujo de salida.
+ * @param corridas Configuraciones.
+ * @param resultados Resultados, en el mismo orden.
+ */
+void EscribaResumenJson(std::ostream& f, const std::vector<Configuracion>& corridas,
+                        const std::vector<ResultadoCorrida>& resultados);
+
+#endif
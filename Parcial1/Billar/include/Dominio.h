@@ -0,0 +1,152 @@
+/**
+ * @file Dominio.h
+ * @brief Define la clase Dominio, una franja vertical de la caja asignada a un proceso MPI.
+ *
+ * La caja se corta en `P` franjas de igual ancho, una por rango. Cada rango mueve
+ * solo sus bolas; las que cruzan el borde de la franja migran al vecino. Para
+ * resolver los choques que cruzan un borde, cada rango envía a su vecino izquierdo
+ * copias fantasma de las bolas que están a menos de un halo (el diámetro máximo)
+ * de su borde izquierdo. El rango izquierdo resuelve esos pares, una sola vez, y
+ * devuelve al dueño el estado final de cada fantasma que chocó.
+ */
+
+#ifndef DOMINIO_H
+#define DOMINIO_H
+
+#include "Caja.h"
+#include "Celdas.h"
+#include "Kernels.h"
+#include "Particulas.h"
+#include "Trayectoria.h"
+#include <mpi.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ContadoresDominio
+ * @brief Trabajo y comunicación acumulados por un rango.
+ */
+struct ContadoresDominio {
+    long pasos = 0;                   ///< Pasos dados.
+    std::uint64_t migraciones = 0;    ///< Bolas recibidas de un vecino.
+    std::uint64_t fantasmas = 0;      ///< Copias fantasma recibidas (suma sobre los pasos).
+    std::uint64_t pruebas_pares = 0;  ///< Pares (i, j) probados.
+    double segundos_comunicacion = 0.0; ///< Tiempo de pared en los intercambios con los vecinos.
+};
+
+/**
+ * @class Dominio
+ * @brief Bolas de una franja [x0, x1) de la caja y su intercambio con las franjas vecinas.
+ *
+ * Los choques de un paso se resuelven en tres fases: primero los pares dentro de cada
+ * franja (todos los rangos a la vez) y luego los pares que cruzan los bordes, primero
+ * los bordes pares (entre los rangos 0-1, 2-3, ...) y después los impares. Ninguna
+ * bola participa en dos fases simultáneas, así que cada choque se aplica sobre el
+ * estado ya actualizado por los anteriores y la energía se conserva igual que en un
+ * solo proceso.
+ */
+class Dominio {
+private:
+    MPI_Comm comunicador;       ///< Comunicador de los rangos.
+    int rango = 0, rangos = 1;  ///< Rango propio y número de rangos.
+    int izquierda, derecha;     ///< Rangos vecinos (MPI_PROC_NULL en los extremos).
+    Caja caja;                  ///< Caja completa (las paredes son globales).
+    double x0 = 0.0, x1 = 0.0;  ///< Bordes de la franja propia.
+    double halo = 0.0;          ///< Ancho de la capa de fantasmas (diámetro máximo).
+    bool espejo = true;         ///< Paredes robustas (Verlet) o simples (Euler).
+    NivelSimd nivel_simd = NivelSimdDisponible(); ///< Instrucciones del movimiento y las paredes.
+    int intervalo_reorden = 0;  ///< Pasos entre reordenamientos de Morton (0: nunca).
+
+    ParticulasT<double> bolas;  ///< Bolas propias.
+    ParticulasT<double> borde;  ///< Bolas propias junto al borde derecho seguidas de los fantasmas.
+    Celdas celdas;              ///< Rejilla sobre la franja.
+    Celdas celdas_borde;        ///< Rejilla de dos columnas sobre [x1 - halo, x1 + halo).
+    double tiempo = 0.0;        ///< Tiempo simulado.
+    ContadoresDominio contadores; ///< Trabajo y comunicación acumulados.
+
+    std::vector<std::uint32_t> enviadas;     ///< Bolas propias enviadas como fantasmas en la fase actual.
+    std::vector<std::uint32_t> zona;         ///< Bolas propias copiadas en `borde`.
+    std::vector<double> a_izquierda, a_derecha; ///< Búferes de envío.
+    std::vector<double> de_izquierda, de_derecha; ///< Búferes de recepción.
+    std::vector<std::uint32_t> orden;        ///< Permutación de Morton, reutilizada.
+
+    void Empaque(std::size_t i, std::vector<double>& buffer) const;
+    void Intercambie();
+    void Migre();
+    void ResuelvaBorde(int paridad);
+
+public:
+    /**
+     * @brief Asigna a este rango su franja de la caja, todavía sin bolas.
+     * @param C Caja completa.
+     * @param integrador "verlet" (paredes robustas) o "euler" (paredes simples).
+     * @param comm Comunicador; las franjas se asignan por rango, de izquierda a derecha.
+     * @throws std::invalid_argument Si el integrador no es válido.
+     */
+    Dominio(const Caja& C, const std::string& integrador, MPI_Comm comm);
+
+    /**
+     * @brief Toma las bolas propias y calcula el halo con el radio máximo de todos los rangos.
+     *
+     * Cada rango genera o lee solo sus bolas, las que tienen x en [GetDesde(), GetHasta()),
+     * con GenereFranja o LeaFranjaCheckpoint; ningún rango guarda el estado completo.
+     * Es colectivo.
+     *
+     * @param propias Bolas de la franja.
+     * @throws std::invalid_argument Si las franjas son más angostas que el halo.
+     */
+    void Cargue(ParticulasT<double> propias);
+
+    /** @brief Fija el nivel SIMD del movimiento y las paredes. */
+    void DefinaSimd(NivelSimd nivel) { nivel_simd = nivel; }
+
+    /** @brief Reordena las bolas propias por curva de Morton cada `pasos` pasos (0: nunca). */
+    void DefinaReorden(int pasos) { intervalo_reorden = pasos; }
+
+    /** @brief Fija el tiempo simulado (por ejemplo al continuar un checkpoint). */
+    void DefinaTiempo(double t) { tiempo = t; }
+
+    /**
+     * @brief Avanza un paso: movimiento y paredes, migración, choques internos y choques en los bordes.
+     *
+     * Es colectivo: todos los rangos deben llamarlo con el mismo dt.
+     *
+     * @param dt Paso de tiempo.
+     * @throws std::runtime_error Si una bola cruzó más de una franja en el paso.
+     */
+    void Paso(double dt);
+
+    /**
+     * @brief Reúne el estado de todas las bolas en el rango 0, ordenado por id.
+     *
+     * Es colectivo; solo el rango 0 modifica `c`.
+     *
+     * @param c Cuadro de salida, con tamaño N total.
+     * @param t Instante del cuadro.
+     */
+    void Reuna(Cuadro& c, double t);
+
+    /** @brief Energía cinética total de todos los rangos (colectivo). */
+    double EnergiaTotal() const;
+
+    /** @brief Número total de bolas de todos los rangos (colectivo). */
+    std::uint64_t NTotal() const;
+
+    /** @brief Mayor número de bolas propias entre los rangos sobre el promedio (colectivo). */
+    double Desbalance() const;
+
+    std::size_t GetNPropias() const { return bolas.Tamano(); }         ///< Retorna el número de bolas propias.
+    double GetX0() const { return x0; }                                  ///< Retorna el borde izquierdo de la franja.
+    double GetX1() const { return x1; }                                  ///< Retorna el borde derecho de la franja.
+    /** @brief Menor abscisa de las bolas propias (-infinito en el rango 0: se queda con las que salen por la izquierda). */
+    double GetDesde() const { return izquierda == MPI_PROC_NULL ? -std::numeric_limits<double>::infinity() : x0; }
+    /** @brief Cota superior de las abscisas propias (+infinito en el último rango). */
+    double GetHasta() const { return derecha == MPI_PROC_NULL ? std::numeric_limits<double>::infinity() : x1; }
+    double GetHalo() const { return halo; }                              ///< Retorna el ancho del halo (diámetro máximo).
+    double GetTiempo() const { return tiempo; }                          ///< Retorna el tiempo simulado.
+    const ContadoresDominio& GetContadores() const { return contadores; } ///< Retorna los contadores del rango.
+};
+
+#endif
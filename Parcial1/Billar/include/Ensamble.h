@@ -0,0 +1,119 @@
+/**
+ * @file Ensamble.h
+ * @brief Promedia observables sobre muchas réplicas independientes de un mismo sistema.
+ *
+ * Cada réplica es un Sistema con sus propias condiciones iniciales, sembradas con
+ * una semilla derivada de la semilla base y del índice de la réplica. Las réplicas
+ * se reparten entre hilos y no escriben trayectorias: al terminar, sus promedios
+ * temporales se incorporan al resultado siempre en el orden de los índices, así el
+ * ensamble da los mismos números con cualquier número de hilos.
+ */
+
+#ifndef ENSAMBLE_H
+#define ENSAMBLE_H
+
+#include "Configuracion.h"
+#include "Observables.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct Intervalo
+ * @brief Media de un observable sobre las réplicas con su intervalo de confianza del 95 %.
+ */
+struct Intervalo {
+    std::uint64_t n = 0;     ///< Réplicas incluidas.
+    double media = 0.0;      ///< Media entre réplicas.
+    double error = 0.0;      ///< Error estándar de la media.
+    double inferior = 0.0;   ///< Límite inferior del intervalo.
+    double superior = 0.0;   ///< Límite superior del intervalo.
+};
+
+/**
+ * @struct ResultadoEnsamble
+ * @brief Estadísticas entre réplicas de un ensamble.
+ *
+ * Cada acumulador recibe un valor por réplica: el promedio temporal de esa réplica.
+ */
+struct ResultadoEnsamble {
+    std::size_t replicas = 0;        ///< Réplicas pedidas.
+    std::size_t completas = 0;       ///< Réplicas que terminaron sin error.
+    std::vector<std::string> errores; ///< Errores, con el índice de la réplica.
+    std::string directorio;          ///< Directorio del resumen.
+    std::uint64_t semilla = 0;       ///< Semilla base (la réplica k usa SemillaReplica(semilla, k)).
+    int hilos = 1;                   ///< Hilos usados.
+    double segundos = 0.0;           ///< Tiempo de pared del ensamble.
+    long pasos = 0;                  ///< Pasos de todas las réplicas.
+    double bolas_pasos_por_segundo = 0.0; ///< N * pasos / segundos, sumando las réplicas.
+    Acumulador energia;              ///< Energía cinética media de cada réplica.
+    Acumulador temperatura;          ///< Temperatura cinética media de cada réplica.
+    Acumulador px;                   ///< Momento total medio en x de cada réplica.
+    Acumulador py;                   ///< Momento total medio en y de cada réplica.
+    Acumulador chi2_maxwell;         ///< Chi-cuadrado contra Maxwell–Boltzmann de cada réplica.
+    Histograma rapideces;            ///< Histograma de rapideces sumado sobre las réplicas.
+};
+
+/**
+ * @brief Deriva la semilla de una réplica.
+ *
+ * Mezcla la semilla base y el índice con SplitMix64, de modo que réplicas vecinas
+ * reciben semillas sin relación aparente.
+ *
+ * @param base Semilla base del ensamble.
+ * @param k Índice de la réplica.
+ * @return Semilla distinta de cero.
+ */
+std::uint64_t SemillaReplica(std::uint64_t base, std::size_t k);
+
+/**
+ * @brief Calcula la media y el intervalo de confianza del 95 % (t de Student).
+ * @param a Acumulador con un valor por réplica.
+ * @return Intervalo; con menos de dos valores el intervalo se reduce a la media.
+ */
+Intervalo IntervaloConfianza(const Acumulador& a);
+
+/**
+ * @brief Ejecuta las réplicas de una configuración y reduce sus observables.
+ *
+ * Las réplicas no escriben trayectorias ni checkpoints. La configuración no debe
+ * tener `reanude`: todas las réplicas partirían del mismo estado.
+ *
+ * @param c Parámetros comunes; `replicas` fija cuántas se ejecutan.
+ * @param hilos Hilos de trabajo (0: todos los núcleos).
+ * @return Resultado del ensamble.
+ * @throws std::invalid_argument Si la configuración pide reanudar un checkpoint.
+ */
+ResultadoEnsamble EjecuteEnsamble(const Configuracion& c, int hilos);
+
+/**
+ * @brief Ejecuta un ensamble por configuración, uno tras otro.
+ *
+ * Con una sola configuración el resumen va a su directorio `salida`; con varias,
+ * a `salida/corrida_XXX`. Cada directorio recibe `ensamble.dat`.
+ *
+ * @param corridas Configuraciones.
+ * @param hilos Hilos de cada ensamble (0: todos los núcleos).
+ * @return Resultados en el mismo orden que `corridas`.
+ */
+std::vector<ResultadoEnsamble> EjecuteEnsambles(const std::vector<Configuracion>& corridas, int hilos);
+
+/**
+ * @brief Escribe un resumen legible del ensamble y el histograma normalizado.
+ * @param f Flujo de salida.
+ * @param r Resultado del ensamble.
+ */
+void EscribaResumenEnsamble(std::ostream& f, const ResultadoEnsamble& r);
+
+/**
+ * @brief Escribe el resumen de varios ensambles en JSON.
+ * @param f Flujo de salida.
+ * @param corridas Configuraciones.
+ * @param resultados Resultados, en el mismo orden.
+ */
+void EscribaResumenEnsamblesJson(std::ostream& f, const std::vector<Configuracion>& corridas,
+                                 const std::vector<ResultadoEnsamble>& resultados);
+
+#endif
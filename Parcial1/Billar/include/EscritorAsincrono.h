@@ -0,0 +1,109 @@
+/**
+ * @file EscritorAsincrono.h
+ * @brief Define un escritor de trayectorias que escribe en un hilo aparte.
+ *
+ * El hilo de simulación copia cada cuadro en un búfer libre de un conjunto
+ * preasignado y sigue avanzando; un hilo escritor vacía los búferes llenos en
+ * el escritor de destino (texto o binario). Si el escritor se atrasa, el hilo
+ * de simulación espera a que se libere un búfer en lugar de crecer en memoria.
+ */
+
+#ifndef ESCRITOR_ASINCRONO_H
+#define ESCRITOR_ASINCRONO_H
+
+#include "Trayectoria.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class EscritorAsincrono
+ * @brief Envoltura que delega la escritura de cuadros a un hilo de fondo.
+ *
+ * Uso sin copias extra:
+ * @code
+ * Cuadro& c = escritor.ObtengaLibre();
+ * sim.CopieCuadro(c, t);
+ * escritor.Publique();
+ * @endcode
+ */
+class EscritorAsincrono : public Escritor {
+private:
+    std::unique_ptr<Escritor> destino; ///< Escritor que hace la E/S real.
+    std::vector<Cuadro> pool;          ///< Búferes preasignados.
+    std::deque<std::size_t> libres;    ///< Búferes disponibles para el hilo de simulación.
+    std::deque<std::size_t> llenos;    ///< Búferes pendientes de escribir, en orden.
+    std::size_t actual;                ///< Búfer entregado por ObtengaLibre y aún no publicado.
+    bool tomado = false;               ///< Indica si hay un búfer entregado sin publicar.
+    bool terminar = false;             ///< Pide al hilo escritor que salga al vaciar la cola.
+    bool cerrado = false;              ///< Indica si ya se llamó a Cierre.
+    std::exception_ptr error;          ///< Primera excepción lanzada en el hilo escritor.
+
+    std::mutex mtx;                    ///< Protege las colas y las banderas.
+    std::condition_variable hay_libre; ///< Señala que se liberó un búfer.
+    std::condition_variable hay_lleno; ///< Señala que hay un búfer por escribir o que se termina.
+    std::thread hilo;                  ///< Hilo escritor.
+
+    double segundos_espera = 0.0;      ///< Tiempo que el hilo de simulación pasó esperando búferes.
+    std::size_t esperas = 0;           ///< Número de veces que el hilo de simulación tuvo que esperar.
+
+    /** @brief Bucle del hilo escritor. */
+    void Trabaje();
+
+    /** @brief Relanza en el hilo llamador el error del hilo escritor, si lo hubo. */
+    void RevisarError();
+
+public:
+    /**
+     * @brief Crea el conjunto de búferes y arranca el hilo escritor.
+     * @param destino Escritor que recibe los cuadros en orden.
+     * @param num_buferes Número de búferes del conjunto (al menos 2).
+     * @param N Número de bolas, para preasignar cada búfer.
+     * @throws std::invalid_argument Si destino es nulo o num_buferes es menor que 2.
+     */
+    EscritorAsincrono(std::unique_ptr<Escritor> destino, std::size_t num_buferes, std::size_t N);
+
+    /** @brief Vacía la cola y detiene el hilo (sin relanzar errores). */
+    ~EscritorAsincrono() override;
+
+    EscritorAsincrono(const EscritorAsincrono&) = delete;
+    EscritorAsincrono& operator=(const EscritorAsincrono&) = delete;
+
+    /**
+     * @brief Entrega un búfer libre, esperando si todos están en cola (contrapresión).
+     * @return Cuadro que el llamador debe llenar y luego publicar.
+     * @throws std::logic_error Si ya hay un búfer entregado sin publicar o el escritor está cerrado.
+     */
+    Cuadro& ObtengaLibre();
+
+    /**
+     * @brief Pone en cola de escritura el búfer entregado por ObtengaLibre.
+     * @throws std::logic_error Si no hay un búfer entregado.
+     */
+    void Publique();
+
+    /**
+     * @brief Copia el cuadro en un búfer libre y lo pone en cola.
+     * @param c Cuadro a escribir.
+     */
+    void Escriba(const Cuadro& c) override;
+
+    /**
+     * @brief Espera a que se escriban todos los cuadros, detiene el hilo y cierra el destino.
+     * @throws La excepción que haya lanzado el escritor de destino, si la hubo.
+     */
+    void Cierre() override;
+
+    /** @brief Retorna el tiempo total (s) que el hilo de simulación esperó por E/S. */
+    double GetSegundosEspera() const { return segundos_espera; }
+
+    /** @brief Retorna cuántas veces el hilo de simulación tuvo que esperar un búfer. */
+    std::size_t GetEsperas() const { return esperas; }
+};
+
+#endif
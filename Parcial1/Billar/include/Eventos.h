@@ -0,0 +1,88 @@
+/**
+ * @file Eventos.h
+ * @brief Define la clase MotorEventos, una dinámica molecular dirigida por eventos para discos duros.
+ *
+ * En lugar de avanzar con un paso fijo, el motor predice el instante exacto de cada
+ * choque bola–bola y bola–pared, los guarda en una cola de prioridad y salta de
+ * evento en evento. Las bolas se mueven de forma perezosa: cada una guarda el
+ * instante de su última actualización y solo se avanza cuando participa en un evento.
+ */
+
+#ifndef EVENTOS_H
+#define EVENTOS_H
+
+#include "Caja.h"
+#include "Bola.h"
+#include "Kernels.h"
+#include <vector>
+#include <queue>
+
+/**
+ * @class MotorEventos
+ * @brief Motor de colisiones exactas dirigido por eventos.
+ *
+ * Los eventos se invalidan de forma perezosa: cada bola lleva un contador de choques
+ * y un evento solo es válido si los contadores de sus bolas no cambiaron desde que
+ * se predijo. Para que cada predicción cueste O(1), las bolas se organizan en una
+ * rejilla de celdas y el cruce de una celda a otra también es un evento.
+ */
+class MotorEventos {
+private:
+    /** @brief Tipo de evento. */
+    enum class Tipo { Bola, ParedX, ParedY, CeldaX, CeldaY };
+
+    /** @brief Evento pendiente en la cola. */
+    struct Evento {
+        double t;          ///< Instante absoluto del evento.
+        int i, j;          ///< Bolas involucradas (j = -1 si no hay segunda bola).
+        unsigned ci, cj;   ///< Contadores de choques al momento de la predicción.
+        Tipo tipo;         ///< Tipo de evento.
+        bool operator>(const Evento& o) const { return t > o.t; }
+    };
+
+    std::priority_queue<Evento, std::vector<Evento>, std::greater<Evento>> cola; ///< Eventos futuros.
+    std::vector<double> t_bola;     ///< Instante al que está actualizada cada bola.
+    std::vector<unsigned> choques;  ///< Contador de choques de cada bola.
+    std::vector<int> cx, cy;        ///< Celda de cada bola.
+    std::vector<int> cabeza;        ///< Primera bola de cada celda (-1 si está vacía).
+    std::vector<int> sig, ant;      ///< Lista doblemente enlazada de bolas por celda.
+    Caja caja;                      ///< Copia de la caja de la simulación.
+    double lx = 1.0, ly = 1.0;      ///< Dimensiones de cada celda.
+    int nx = 1, ny = 1;             ///< Número de celdas en x y en y.
+    double t = 0.0;                 ///< Instante actual del motor.
+    long eventos = 0;               ///< Eventos válidos procesados.
+    long choques_bolas = 0;         ///< Choques bola–bola resueltos.
+
+    void Sincronice(Particulas& bolas, int i);
+    void Inserte(int i);
+    void Retire(int i);
+    void PredigaCruce(const Bola& b, int i, bool eje_x);
+    void PredigaVecinos(Particulas& bolas, int i);
+    void Prediga(Particulas& bolas, int i);
+    void Reconstruya(Particulas& bolas);
+
+public:
+    /**
+     * @brief Prepara el motor para un conjunto de bolas.
+     *
+     * Construye la rejilla de celdas (lado mayor o igual al diámetro máximo)
+     * y predice todos los eventos iniciales.
+     *
+     * @param bolas Bolas del sistema.
+     * @param C Caja de la simulación.
+     */
+    void Inicie(Particulas& bolas, const Caja& C);
+
+    /**
+     * @brief Procesa todos los eventos hasta t + dt y sincroniza las bolas a ese instante.
+     * @param bolas Bolas del sistema.
+     * @param dt Intervalo de tiempo a avanzar.
+     * @return Impulso que recibió cada pared durante el avance.
+     */
+    ImpulsoParedes Avance(Particulas& bolas, double dt);
+
+    long GetEventos() const { return eventos; } ///< Retorna el número de eventos válidos procesados.
+    long GetChoquesBolas() const { return choques_bolas; } ///< Retorna el número de choques bola–bola.
+};
+
+#endif
@@ -0,0 +1,150 @@
+/**
+ * @file Instrumentacion.h
+ * @brief Tiempos por fase y contadores de Sistema::Paso, activables al compilar.
+ *
+ * Con `-DBILLAR_INSTRUMENTACION=ON` en CMake cada fase del paso (movimiento,
+ * paredes, celdas, choques, eventos, observables y salida) se cronometra y se
+ * cuentan contactos, impulsos, correcciones de superposición y rebotes en paredes.
+ * Sin la opción, los cronómetros son objetos vacíos y los contadores quedan dentro de
+ * `if constexpr` falsos, así el compilador no genera código para ellos.
+ * Los pares probados se cuentan siempre: cuestan una suma por par.
+ */
+
+#ifndef INSTRUMENTACION_H
+#define INSTRUMENTACION_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#ifndef BILLAR_INSTRUMENTACION
+#define BILLAR_INSTRUMENTACION 0
+#endif
+
+/** Indica si la instrumentación se compiló. */
+constexpr bool INSTRUMENTACION_ACTIVA = BILLAR_INSTRUMENTACION != 0;
+
+/**
+ * @enum Fase
+ * @brief Fases cronometradas de un paso.
+ */
+enum class Fase {
+    Movimiento,  ///< Avance de las posiciones.
+    Paredes,     ///< Rebotes contra las paredes.
+    Celdas,      ///< Asignación de bolas a celdas.
+    Choques,     ///< Pruebas de pares y choques bola–bola.
+    Eventos,     ///< Avance del motor por eventos.
+    Observables, ///< Muestras de observables.
+    Salida,      ///< Copia de cuadros y escritura de texto (Guarde).
+    Total        ///< Número de fases (no es una fase).
+};
+
+/** Número de fases cronometradas. */
+constexpr int NUM_FASES = static_cast<int>(Fase::Total);
+
+/**
+ * @brief Retorna el nombre de una fase.
+ * @param f Fase.
+ */
+const char* NombreFase(Fase f);
+
+/**
+ * @enum EfectoChoque
+ * @brief Bits que retorna Bola::ChoqueElastico según lo que hizo con el par.
+ */
+enum EfectoChoque : unsigned {
+    SinContacto = 0, ///< Las bolas no se tocaban.
+    Contacto = 1,    ///< Las bolas se superponían.
+    Impulso = 2,     ///< Se acercaban y se intercambió impulso.
+    Correccion = 4   ///< Se corrigió la superposición.
+};
+
+/**
+ * @struct ConteoChoques
+ * @brief Contadores de una pasada de choques bola–bola.
+ */
+struct ConteoChoques {
+    std::uint64_t pruebas = 0;      ///< Pares (i, j) probados.
+    std::uint64_t contactos = 0;    ///< Pares superpuestos.
+    std::uint64_t impulsos = 0;     ///< Pares que intercambiaron impulso.
+    std::uint64_t correcciones = 0; ///< Superposiciones corregidas.
+
+    /** @brief Cuenta el efecto de un choque (los bits de EfectoChoque). */
+    void Agregue(unsigned efecto) {
+        contactos += efecto & Contacto;
+        impulsos += (efecto & Impulso) >> 1;
+        correcciones += (efecto & Correccion) >> 2;
+    }
+
+    /** @brief Suma otro conteo. */
+    ConteoChoques& operator+=(const ConteoChoques& o) {
+        pruebas += o.pruebas;
+        contactos += o.contactos;
+        impulsos += o.impulsos;
+        correcciones += o.correcciones;
+        return *this;
+    }
+};
+
+/**
+ * @struct Instrumentacion
+ * @brief Tiempos acumulados por fase y contadores desde el último reinicio.
+ */
+struct Instrumentacion {
+    double segundos[NUM_FASES] = {};       ///< Tiempo acumulado en cada fase.
+    std::uint64_t llamadas[NUM_FASES] = {}; ///< Veces que se entró a cada fase.
+    ConteoChoques choques;                 ///< Pares probados, contactos, impulsos y correcciones.
+    std::uint64_t rebotes_pared = 0;       ///< Rebotes en paredes (motores por pasos).
+    std::uint64_t choques_eventos = 0;     ///< Choques bola–bola del motor por eventos.
+    long pasos = 0;                        ///< Pasos desde el último reinicio.
+    std::size_t N = 0;                     ///< Número de bolas (para normalizar).
+
+    /** @brief Borra tiempos y contadores. */
+    void Reinicie() { *this = Instrumentacion(); }
+
+    /** @brief Retorna la suma de los tiempos de todas las fases. */
+    double SegundosTotales() const;
+
+    /**
+     * @brief Escribe una línea con el porcentaje de cada fase y los contadores por paso.
+     * @param f Flujo de salida.
+     * @param t Tiempo simulado (solo se muestra).
+     */
+    void EscribaLinea(std::ostream& f, double t) const;
+
+    /**
+     * @brief Escribe el informe completo en JSON.
+     * @param f Flujo de salida.
+     */
+    void EscribaJson(std::ostream& f) const;
+};
+
+/**
+ * @class CronometroFase
+ * @brief Suma a una fase el tiempo entre su construcción y su destrucción.
+ *
+ * Sin BILLAR_INSTRUMENTACION la clase está vacía y no mide nada.
+ */
+class CronometroFase {
+#if BILLAR_INSTRUMENTACION
+    Instrumentacion& instr;                          ///< Destino del tiempo medido.
+    Fase fase;                                       ///< Fase medida.
+    std::chrono::steady_clock::time_point inicio;    ///< Instante de entrada.
+
+public:
+    CronometroFase(Instrumentacion& i, Fase f) : instr(i), fase(f), inicio(std::chrono::steady_clock::now()) {}
+    ~CronometroFase() {
+        const int k = static_cast<int>(fase);
+        instr.segundos[k] += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        ++instr.llamadas[k];
+    }
+#else
+public:
+    CronometroFase(Instrumentacion&, Fase) {}
+#endif
+    CronometroFase(const CronometroFase&) = delete;
+    CronometroFase& operator=(const CronometroFase&) = delete;
+};
+
+#endif
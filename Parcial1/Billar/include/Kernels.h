@@ -0,0 +1,155 @@
+/**
+ * @file Kernels.h
+ * @brief Declara los núcleos vectoriales (AVX2/AVX-512) para el movimiento libre y las paredes.
+ *
+ * Los núcleos recorren los arreglos de Particulas procesando 4 (AVX2) u 8 (AVX-512)
+ * bolas a la vez. Las cuatro comprobaciones de pared se evalúan con máscaras en lugar
+ * de saltos condicionales. El nivel de instrucciones se elige en tiempo de ejecución
+ * según la CPU, con una versión escalar de respaldo que da resultados idénticos bit a bit.
+ * Los núcleos aceptan bolas en double o en float (8 y 16 bolas por instrucción);
+ * están instanciados para ambos tipos en Kernels.cpp.
+ *
+ * Los núcleos de paredes retornan el impulso 2 m |v| que recibió cada pared, sumado en
+ * el orden de las bolas; solo se lee la masa de los carriles que rebotan, así que el
+ * costo es casi nulo, y el total es el mismo con cualquier nivel y número de hilos.
+ */
+
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include "Caja.h"
+#include "Particulas.h"
+#include <cstdint>
+#include <string>
+
+/**
+ * @enum NivelSimd
+ * @brief Conjunto de instrucciones usado por los núcleos.
+ */
+enum class NivelSimd {
+    Escalar, ///< Código escalar portable.
+    AVX2,    ///< 4 bolas por instrucción (256 bits).
+    AVX512   ///< 8 bolas por instrucción (512 bits).
+};
+
+/**
+ * @struct ImpulsoParedes
+ * @brief Impulso (2 m |v| por rebote) que recibió cada pared de la caja.
+ */
+struct ImpulsoParedes {
+    double izquierda = 0.0; ///< Pared x = 0.
+    double derecha = 0.0;   ///< Pared x = W.
+    double abajo = 0.0;     ///< Pared y = 0.
+    double arriba = 0.0;    ///< Pared y = H.
+
+    /** @brief Acumula el impulso de otro intervalo o bloque. */
+    ImpulsoParedes& operator+=(const ImpulsoParedes& o) {
+        izquierda += o.izquierda;
+        derecha += o.derecha;
+        abajo += o.abajo;
+        arriba += o.arriba;
+        return *this;
+    }
+
+    /** @brief Retorna el impulso total sobre las cuatro paredes. */
+    double Total() const { return izquierda + derecha + abajo + arriba; }
+};
+
+/**
+ * @brief Detecta el mejor nivel soportado por la CPU y el sistema operativo.
+ * @return Nivel más ancho disponible (se calcula una sola vez).
+ */
+NivelSimd NivelSimdDisponible();
+
+/**
+ * @brief Convierte un nombre ("escalar", "avx2", "avx512" o "auto") en un nivel.
+ * @param nombre Nombre del nivel.
+ * @return Nivel pedido; "auto" retorna NivelSimdDisponible().
+ * @throws std::invalid_argument Si el nombre no es válido o la CPU no soporta el nivel.
+ */
+NivelSimd NivelSimdDesdeNombre(const std::string& nombre);
+
+/** @brief Retorna el nombre legible de un nivel. */
+const char* NombreNivelSimd(NivelSimd nivel);
+
+/**
+ * @brief Avanza las posiciones de todas las bolas: x += vx*dt, y += vy*dt.
+ * @param P Bolas del sistema.
+ * @param dt Paso de tiempo.
+ * @param nivel Conjunto de instrucciones a usar.
+ * @param hilos Número de hilos (los bloques se reparten con OpenMP si está disponible).
+ */
+template <class Real>
+void MuevaBolas(ParticulasT<Real>& P, double dt, NivelSimd nivel, int hilos = 1);
+
+/**
+ * @brief Equivalente vectorial de Bola::ResuelvaColisionParedesSimple para todas las bolas.
+ * @param P Bolas del sistema.
+ * @param C Caja de la simulación.
+ * @param nivel Conjunto de instrucciones a usar.
+ * @param hilos Número de hilos (los bloques se reparten con OpenMP si está disponible).
+ * @return Impulso recibido por cada pared.
+ */
+template <class Real>
+ImpulsoParedes ResuelvaParedesSimple(ParticulasT<Real>& P, const Caja& C, NivelSimd nivel, int hilos = 1);
+
+/**
+ * @brief Equivalente vectorial de Bola::ResuelvaColisionParedesRobusto (refleja y espeja la posición).
+ * @param P Bolas del sistema.
+ * @param C Caja de la simulación.
+ * @param nivel Conjunto de instrucciones a usar.
+ * @param hilos Número de hilos (los bloques se reparten con OpenMP si está disponible).
+ * @return Impulso recibido por cada pared.
+ */
+template <class Real>
+ImpulsoParedes ResuelvaParedesRobusto(ParticulasT<Real>& P, const Caja& C, NivelSimd nivel, int hilos = 1);
+
+/**
+ * @brief Mueve las bolas y resuelve las paredes en una sola pasada.
+ *
+ * Equivale a MuevaBolas seguido de ResuelvaParedesRobusto (`Espejo` verdadero) o
+ * ResuelvaParedesSimple (falso), bit a bit, pero cada bola se lee y escribe una
+ * sola vez. Instanciada para ambos valores de `Espejo` y ambos tipos en Kernels.cpp.
+ *
+ * @tparam Espejo Si también corrige la posición (método robusto).
+ * @param P Bolas del sistema.
+ * @param C Caja de la simulación.
+ * @param dt Paso de tiempo.
+ * @param nivel Conjunto de instrucciones a usar.
+ * @param hilos Número de hilos.
+ * @return Impulso recibido por cada pared.
+ */
+template <bool Espejo, class Real>
+ImpulsoParedes MuevaYResuelvaParedes(ParticulasT<Real>& P, const Caja& C, double dt, NivelSimd nivel, int hilos = 1);
+
+/**
+ * @brief Cuenta los rebotes en paredes que aplicaría el próximo ResuelvaParedes*.
+ *
+ * Evalúa las mismas cuatro condiciones que los núcleos, sin modificar las bolas.
+ * Solo lo usa la instrumentación, antes de resolver las paredes.
+ *
+ * @param P Bolas del sistema.
+ * @param C Caja de la simulación.
+ * @return Número de componentes de velocidad que se reflejarían.
+ */
+template <class Real>
+std::uint64_t CuenteRebotesPared(const ParticulasT<Real>& P, const Caja& C);
+
+/**
+ * @brief Comprueba que un nivel vectorial da exactamente el mismo resultado que el escalar.
+ *
+ * Aplica ambos caminos a una copia de las mismas bolas (varios pasos de movimiento
+ * y paredes, incluyendo bolas fuera de la caja) y compara los bits de cada campo.
+ * También compara la versión fusionada MuevaYResuelvaParedes con las dos pasadas escalares,
+ * y los impulsos en las paredes de los tres caminos.
+ * La comparación se repite con una copia de las bolas en float.
+ *
+ * @param P Bolas de prueba.
+ * @param C Caja de la simulación.
+ * @param dt Paso de tiempo.
+ * @param nivel Nivel a comparar con el escalar.
+ * @return true si todos los campos coinciden bit a bit.
+ */
+bool KernelsIdenticos(const Particulas& P, const Caja& C, double dt, NivelSimd nivel);
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * @file Observables.h
+ * @brief Define los observables que se acumulan durante la simulación.
+ *
+ * Los promedios y varianzas se acumulan con el algoritmo de Welford y las rapideces
+ * en un histograma de bins fijos, así la memoria no crece con la duración de la corrida.
+ * Con la temperatura cinética promedio se compara el histograma con la distribución
+ * de Maxwell–Boltzmann en 2D (k_B = 1).
+ */
+
+#ifndef OBSERVABLES_H
+#define OBSERVABLES_H
+
+#include "Particulas.h"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * @class Acumulador
+ * @brief Media y varianza en línea (algoritmo de Welford).
+ */
+class Acumulador {
+private:
+    std::uint64_t n = 0; ///< Número de muestras.
+    double media = 0.0;  ///< Media de las muestras.
+    double m2 = 0.0;     ///< Suma de cuadrados de las desviaciones respecto a la media.
+    double minimo = 0.0; ///< Menor muestra.
+    double maximo = 0.0; ///< Mayor muestra.
+
+public:
+    /** @brief Agrega una muestra. */
+    void Agregue(double x);
+
+    /** @brief Retorna el número de muestras. */
+    std::uint64_t GetN() const { return n; }
+    /** @brief Retorna la media de las muestras. */
+    double GetMedia() const { return media; }
+    /** @brief Retorna la varianza muestral (0 con menos de dos muestras). */
+    double GetVarianza() const { return n > 1 ? m2 / (n - 1) : 0.0; }
+    /** @brief Retorna la desviación estándar muestral. */
+    double GetDesviacion() const;
+    /** @brief Retorna la menor muestra. */
+    double GetMinimo() const { return minimo; }
+    /** @brief Retorna la mayor muestra. */
+    double GetMaximo() const { return maximo; }
+};
+
+/**
+ * @class Histograma
+ * @brief Histograma de bins iguales en [0, maximo) con un bin extra de desborde.
+ */
+class Histograma {
+private:
+    double maximo = 1.0;               ///< Límite superior del último bin regular.
+    std::vector<std::uint64_t> cuenta; ///< Cuentas por bin; la última es el desborde.
+    std::uint64_t total = 0;           ///< Muestras acumuladas.
+
+public:
+    /**
+     * @brief Define los bins y borra las cuentas.
+     * @param bins Número de bins regulares.
+     * @param maximo Límite superior del rango.
+     * @throws std::invalid_argument Si bins es 0 o maximo no es positivo.
+     */
+    void Defina(std::size_t bins, double maximo);
+
+    /** @brief Agrega una muestra no negativa. */
+    void Agregue(double v) {
+        const std::size_t n = cuenta.size() - 1;
+        if (v < maximo) ++cuenta[static_cast<std::size_t>(v / maximo * n)];
+        else ++cuenta[n];
+        ++total;
+    }
+
+    /**
+     * @brief Suma las cuentas de otro histograma con los mismos bins.
+     * @param otro Histograma a sumar.
+     * @throws std::invalid_argument Si los bins no coinciden.
+     */
+    void Sume(const Histograma& otro);
+
+    /** @brief Retorna el número de bins regulares. */
+    std::size_t Bins() const { return cuenta.empty() ? 0 : cuenta.size() - 1; }
+    /** @brief Retorna el ancho de cada bin. */
+    double Ancho() const { return maximo / Bins(); }
+    /** @brief Retorna la cuenta del bin b (b == Bins() es el desborde). */
+    std::uint64_t Cuenta(std::size_t b) const { return cuenta[b]; }
+    /** @brief Retorna el total de muestras. */
+    std::uint64_t Total() const { return total; }
+};
+
+/**
+ * @struct AjusteMaxwell
+ * @brief Resultado de la prueba chi-cuadrado contra Maxwell–Boltzmann.
+ *
+ * Las rapideces de muestras consecutivas están correlacionadas, así que el valor p
+ * sale más pequeño que con muestras independientes; sirve para comparar corridas.
+ */
+struct AjusteMaxwell {
+    double chi2 = 0.0; ///< Estadístico chi-cuadrado.
+    int grados = 0;    ///< Grados de libertad (bins usados - 2).
+    double p = 1.0;    ///< Probabilidad de un chi-cuadrado mayor bajo la hipótesis.
+};
+
+/**
+ * @class Observables
+ * @brief Acumula energía cinética, momento, temperatura y rapideces en intervalos fijos.
+ */
+class Observables {
+private:
+    Acumulador energia;     ///< Energía cinética total.
+    Acumulador px, py;      ///< Momento total.
+    Acumulador temperatura; ///< Temperatura cinética kT = E / N.
+    Histograma rapideces;   ///< Rapideces de todas las bolas en cada muestra.
+    double masa_media = 1.0; ///< Masa media de las bolas (para la curva de Maxwell).
+    double t_ultimo = 0.0;  ///< Instante de la última muestra.
+
+public:
+    /**
+     * @brief Borra las muestras y define el histograma de rapideces.
+     * @param bins Número de bins del histograma.
+     * @param v_maxima Límite superior del histograma.
+     */
+    void Inicie(std::size_t bins, double v_maxima);
+
+    /**
+     * @brief Toma una muestra del estado actual.
+     *
+     * Las sumas se hacen en double aunque las bolas sean float.
+     *
+     * @param P Bolas del sistema.
+     * @param t Tiempo de la simulación.
+     */
+    template <class Real>
+    void Registre(const ParticulasT<Real>& P, double t);
+
+    /** @brief Retorna el acumulador de energía cinética. */
+    const Acumulador& GetEnergia() const { return energia; }
+    /** @brief Retorna el acumulador de la componente x del momento total. */
+    const Acumulador& GetPx() const { return px; }
+    /** @brief Retorna el acumulador de la componente y del momento total. */
+    const Acumulador& GetPy() const { return py; }
+    /** @brief Retorna el acumulador de temperatura cinética. */
+    const Acumulador& GetTemperatura() const { return temperatura; }
+    /** @brief Retorna el histograma de rapideces. */
+    const Histograma& GetRapideces() const { return rapideces; }
+
+    /**
+     * @brief Compara el histograma con Maxwell–Boltzmann en 2D a la temperatura media.
+     *
+     * Se usan los bins (y el desborde) con al menos 5 cuentas esperadas.
+     *
+     * @return Estadístico, grados de libertad y valor p.
+     */
+    AjusteMaxwell AjusteMaxwellBoltzmann() const;
+
+    /**
+     * @brief Escribe un resumen legible y el histograma normalizado.
+     * @param f Flujo de salida.
+     */
+    void EscribaResumen(std::ostream& f) const;
+};
+
+#endif
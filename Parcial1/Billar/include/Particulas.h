@@ -0,0 +1,99 @@
+/**
+ * @file Particulas.h
+ * @brief Define el almacenamiento de las bolas como estructura de arreglos (SoA).
+ *
+ * Cada campo (x, y, vx, vy, m, 1/m, r, id) vive en su propio arreglo contiguo y alineado,
+ * de modo que las pasadas que solo usan posiciones y velocidades no arrastran la masa
+ * ni el radio por la caché, y los arreglos se pueden recorrer con instrucciones vectoriales.
+ */
+
+#ifndef PARTICULAS_H
+#define PARTICULAS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+/**
+ * @brief Asignador que alinea la memoria a `Alineacion` bytes (por defecto una línea de caché).
+ * @tparam T Tipo de los elementos.
+ * @tparam Alineacion Alineación en bytes.
+ */
+template <class T, std::size_t Alineacion = 64>
+struct AsignadorAlineado {
+    using value_type = T;
+
+    template <class U>
+    struct rebind { using other = AsignadorAlineado<U, Alineacion>; };
+
+    AsignadorAlineado() = default;
+    template <class U>
+    AsignadorAlineado(const AsignadorAlineado<U, Alineacion>&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alineacion)));
+    }
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t(Alineacion));
+    }
+
+    template <class U>
+    bool operator==(const AsignadorAlineado<U, Alineacion>&) const { return true; }
+    template <class U>
+    bool operator!=(const AsignadorAlineado<U, Alineacion>&) const { return false; }
+};
+
+/** @brief Vector con memoria alineada a 64 bytes. */
+template <class T>
+using VectorAlineado = std::vector<T, AsignadorAlineado<T>>;
+
+/**
+ * @struct ParticulasT
+ * @brief Estado de todas las bolas en arreglos separados por campo.
+ *
+ * El tipo de los campos es `Real` (double o float): con float caben el doble de
+ * bolas por registro vectorial y por línea de caché.
+ * La inversa de la masa se guarda precalculada para que los choques no
+ * dividan por la masa en cada par. El orden de los arreglos puede cambiar
+ * (Sistema los reordena por cercanía espacial); `id` conserva el índice
+ * original de cada bola.
+ */
+template <class Real>
+struct ParticulasT {
+    VectorAlineado<Real> x, y;     ///< Posiciones.
+    VectorAlineado<Real> vx, vy;   ///< Velocidades.
+    VectorAlineado<Real> m;        ///< Masas.
+    VectorAlineado<Real> inv_m;    ///< Inversas de las masas (1/m).
+    VectorAlineado<Real> r;        ///< Radios.
+    VectorAlineado<std::uint32_t> id; ///< Índice original de cada bola.
+
+    /** @brief Retorna el número de bolas. */
+    std::size_t Tamano() const { return x.size(); }
+
+    /**
+     * @brief Cambia el número de bolas.
+     *
+     * Las bolas nuevas quedan en el origen, en reposo, con masa 1 y radio 0.1.
+     * Los identificadores vuelven al orden original (id[i] = i).
+     *
+     * @param N Nuevo número de bolas.
+     */
+    void Redimensione(std::size_t N) {
+        x.resize(N, Real(0));
+        y.resize(N, Real(0));
+        vx.resize(N, Real(0));
+        vy.resize(N, Real(0));
+        m.resize(N, Real(1));
+        inv_m.resize(N, Real(1));
+        r.resize(N, Real(0.1));
+        id.resize(N);
+        for (std::size_t i = 0; i < N; ++i)
+            id[i] = static_cast<std::uint32_t>(i);
+    }
+};
+
+/** @brief Bolas en doble precisión, el almacenamiento por defecto. */
+using Particulas = ParticulasT<double>;
+
+#endif
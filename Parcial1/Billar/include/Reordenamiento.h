@@ -0,0 +1,60 @@
+/**
+ * @file Reordenamiento.h
+ * @brief Reordena las bolas según una curva de Morton (orden Z) de su celda.
+ *
+ * Tras muchos choques, bolas vecinas en el espacio quedan lejos en los arreglos de
+ * Particulas y cada prueba de pares trae una línea de caché distinta. Ordenar las
+ * bolas por la clave de Morton de su celda vuelve a juntar en memoria a las que
+ * están juntas en la caja. Las funciones están instanciadas para bolas en double y en float.
+ */
+
+#ifndef REORDENAMIENTO_H
+#define REORDENAMIENTO_H
+
+#include "Particulas.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Intercala los bits de cx y cy (cx en los bits pares).
+ * @param cx Columna de la celda (16 bits).
+ * @param cy Fila de la celda (16 bits).
+ * @return Clave de Morton de 32 bits.
+ */
+inline std::uint32_t ClaveMorton(std::uint32_t cx, std::uint32_t cy) {
+    auto Separe = [](std::uint32_t v) {
+        v &= 0xFFFF;
+        v = (v | (v << 8)) & 0x00FF00FF;
+        v = (v | (v << 4)) & 0x0F0F0F0F;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    };
+    return Separe(cx) | (Separe(cy) << 1);
+}
+
+/**
+ * @brief Calcula el orden de las bolas por clave de Morton de su celda.
+ *
+ * Las bolas de una misma celda conservan su orden relativo, así el resultado
+ * es determinista. Si la caja tiene más de 65536 celdas por lado, las celdas
+ * se agrandan para que la clave quepa en 32 bits.
+ *
+ * @param P Bolas.
+ * @param W,H Dimensiones de la caja.
+ * @param lado Lado de las celdas.
+ * @param orden Salida: orden[k] es la bola que debe quedar en la posición k.
+ */
+template <class Real>
+void OrdenMorton(const ParticulasT<Real>& P, double W, double H, double lado, std::vector<std::uint32_t>& orden);
+
+/**
+ * @brief Reubica las bolas: la posición k recibe la bola orden[k], con todos sus campos e id.
+ * @param P Bolas.
+ * @param orden Permutación de 0..N-1.
+ * @throws std::invalid_argument Si el tamaño de `orden` no es N.
+ */
+template <class Real>
+void PermuteParticulas(ParticulasT<Real>& P, const std::vector<std::uint32_t>& orden);
+
+#endif
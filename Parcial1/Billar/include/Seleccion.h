@@ -0,0 +1,121 @@
+/**
+ * @file Seleccion.h
+ * @brief Define qué bolas y qué cuadros llegan a los escritores de trayectorias.
+ *
+ * Muchas veces basta con unos cientos de bolas trazadoras, o con las bolas que están
+ * dentro de un rectángulo de la caja, y con un cuadro de cada varios. La selección se
+ * aplica en SistemaT::CopieCuadro directamente sobre los arreglos de las bolas, así que
+ * las bolas descartadas nunca se copian ni se formatean.
+ *
+ * - `salida_cada = k`: se escribe uno de cada k cuadros.
+ * - `trazadores = 0-99,512,1000-1019`: ids originales de las bolas que se escriben
+ *   (listas separadas por comas, con rangos inclusivos `a-b`).
+ * - `region = x0,y0,x1,y1`: solo se escriben las bolas cuyo centro cae en el
+ *   rectángulo [x0, x1) x [y0, y1); el número de bolas cambia de cuadro a cuadro.
+ */
+
+#ifndef SELECCION_H
+#define SELECCION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct RegionSalida
+ * @brief Rectángulo alineado con los ejes, [x0, x1) x [y0, y1).
+ */
+struct RegionSalida {
+    double x0 = 0.0, y0 = 0.0; ///< Esquina inferior izquierda (incluida).
+    double x1 = 0.0, y1 = 0.0; ///< Esquina superior derecha (excluida).
+
+    /** @brief Indica si el punto (x, y) cae dentro. */
+    bool Contiene(double x, double y) const { return x >= x0 && x < x1 && y >= y0 && y < y1; }
+};
+
+/**
+ * @struct RangoTrazadores
+ * @brief Rango inclusivo de ids [desde, hasta]; un id suelto es un rango de uno.
+ */
+struct RangoTrazadores {
+    std::uint32_t desde = 0; ///< Primer id.
+    std::uint32_t hasta = 0; ///< Último id (incluido).
+};
+
+/**
+ * @brief Lee una lista de ids como `0-99,512,1000-1019` sin expandir los rangos.
+ * @param texto Lista (vacía: ninguno).
+ * @return Rangos en el orden del texto.
+ * @throws std::invalid_argument Si algún elemento no es un id o un rango válido.
+ */
+std::vector<RangoTrazadores> LeaRangosTrazadores(const std::string& texto);
+
+/**
+ * @brief Lee una lista de ids y la expande, tras comprobar que todos son menores que N.
+ * @param texto Lista (vacía: ninguno).
+ * @param N Número de bolas.
+ * @return Ids ordenados y sin repetir.
+ * @throws std::invalid_argument Si la lista no es válida o algún id no es una bola.
+ */
+std::vector<std::uint32_t> LeaTrazadores(const std::string& texto, std::size_t N);
+
+/**
+ * @brief Lee una región como `x0,y0,x1,y1`.
+ * @param texto Cuatro reales separados por comas.
+ * @return Región.
+ * @throws std::invalid_argument Si no son cuatro reales o el rectángulo no tiene área.
+ */
+RegionSalida LeaRegion(const std::string& texto);
+
+/**
+ * @class SeleccionSalida
+ * @brief Decimación en el tiempo, bolas trazadoras y filtro de región de la salida.
+ *
+ * Sin trazadores ni región la selección es completa y CopieCuadro copia todas las bolas
+ * en su orden original. Con trazadores el cuadro tiene siempre las mismas bolas, en el
+ * orden de sus ids; con región tiene las que están dentro, también ordenadas por id.
+ */
+class SeleccionSalida {
+private:
+    int cada = 1;                          ///< Se escribe uno de cada `cada` cuadros.
+    std::vector<std::uint32_t> trazadores; ///< Ids escritos, ordenados (vacío: todas las bolas).
+    std::vector<std::int32_t> ranura;      ///< Posición de cada id en `trazadores`, o -1 (vacío sin trazadores).
+    bool con_region = false;               ///< Si se aplica el filtro de región.
+    RegionSalida region;                   ///< Región de salida.
+
+public:
+    /** @brief Selección completa: todas las bolas en todos los cuadros. */
+    SeleccionSalida() = default;
+
+    /**
+     * @brief Arma la selección a partir de los parámetros de la corrida.
+     * @param cada Se escribe uno de cada `cada` cuadros (al menos 1).
+     * @param trazadores Lista de ids (vacía: todas las bolas).
+     * @param region Región `x0,y0,x1,y1` (vacía: toda la caja).
+     * @param N Número de bolas del sistema.
+     * @throws std::invalid_argument Si `cada` no es positivo, algún id no existe o la región no es válida.
+     */
+    SeleccionSalida(int cada, const std::string& trazadores, const std::string& region, std::size_t N);
+
+    /** @brief Indica si el cuadro número k (desde 0) se escribe. */
+    bool Escribe(long k) const { return k % cada == 0; }
+
+    /** @brief Indica si se escriben todas las bolas en su orden original. */
+    bool Completa() const { return trazadores.empty() && !con_region; }
+
+    /** @brief Indica si el número de bolas cambia de cuadro a cuadro (filtro de región). */
+    bool Variable() const { return con_region; }
+
+    /** @brief Indica si la bola con id original `i` es trazadora (siempre, sin trazadores). */
+    bool EsTrazadora(std::uint32_t i) const { return ranura.empty() || ranura[i] >= 0; }
+
+    /** @brief Posición de la bola con id original `i` en el cuadro de trazadores, o -1. */
+    std::int32_t Ranura(std::uint32_t i) const { return ranura[i]; }
+
+    int GetCada() const { return cada; }                                              ///< Retorna la decimación.
+    const std::vector<std::uint32_t>& GetTrazadores() const { return trazadores; }    ///< Retorna los ids trazadores.
+    const RegionSalida& GetRegion() const { return region; }                           ///< Retorna la región.
+};
+
+#endif
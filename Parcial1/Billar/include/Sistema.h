@@ -11,47 +11,182 @@
 
 #include "Caja.h"
 #include "Bola.h"
+#include "Particulas.h"
+#include "Celdas.h"
+#include "Vecinos.h"
+#include "Eventos.h"
+#include "Kernels.h"
+#include "Trayectoria.h"
+#include "Observables.h"
+#include "Aleatorio.h"
+#include "Instrumentacion.h"
+#include "Reordenamiento.h"
+#include "Seleccion.h"
 #include <vector>
 #include <fstream>
 #include <string>
+#include <cstdint>
+#include <ctime>
+#include <type_traits>
 
 /**
  * @enum Integrador
  * @brief Enumeración para seleccionar el método de integración temporal.
  * 
- * Permite elegir entre los esquemas de Euler y Verlet.
+ * Permite elegir entre los esquemas de Euler y Verlet, o la dinámica
+ * dirigida por eventos, que resuelve cada choque en su instante exacto.
  */
 enum class Integrador { 
     Euler,  ///< Integración mediante el método de Euler explícito.
-    Verlet  ///< Integración mediante el método de Verlet.
+    Verlet, ///< Integración mediante el método de Verlet.
+    Eventos ///< Dinámica molecular dirigida por eventos (choques exactos).
 };
 
 /**
- * @class Sistema
+ * @enum MotorColisiones
+ * @brief Enumeración para seleccionar cómo se buscan los pares de bolas en contacto.
+ */
+enum class MotorColisiones {
+    FuerzaBruta, ///< Prueba todos los pares i<j, costo O(N²) por paso.
+    Celdas,      ///< Prueba solo bolas en celdas vecinas de una rejilla uniforme, costo O(N).
+    Paralelo,    ///< Rejilla de celdas recorrida por varios hilos con coloreo de bloques.
+    Vecinos      ///< Listas de Verlet con piel, reconstruidas solo cuando alguna bola se movió más de piel/2.
+};
+
+/**
+ * @struct ParedSimple
+ * @brief Política de paredes del integrador de Euler: solo se refleja la velocidad.
+ */
+struct ParedSimple {
+    static constexpr bool espejo = false; ///< No corrige la posición.
+};
+
+/**
+ * @struct ParedRobusta
+ * @brief Política de paredes del integrador de Verlet: se refleja la velocidad y se espeja la posición.
+ */
+struct ParedRobusta {
+    static constexpr bool espejo = true; ///< Corrige la posición.
+};
+
+/**
+ * @struct BalanceConservado
+ * @brief Energía, momento e impulso sobre las paredes llevados como totales corrientes.
+ *
+ * Los choques entre bolas conservan la energía y el momento, y los rebotes en paredes
+ * conservan la energía, así que los totales solo cambian con el impulso que los núcleos
+ * de paredes calculan al rebotar. Cada cierto número de pasos se comparan con una suma
+ * completa sobre las bolas: la diferencia es la deriva por redondeo.
+ */
+struct BalanceConservado {
+    double energia = 0.0;          ///< Energía cinética llevada.
+    double px = 0.0, py = 0.0;     ///< Momento total llevado.
+    ImpulsoParedes impulso;        ///< Impulso sobre cada pared desde DefinaBalance.
+    double t_inicial = 0.0;        ///< Tiempo simulado al llamar a DefinaBalance.
+    double deriva_energia = 0.0;   ///< Mayor |E_suma - E_llevada| / E_suma entre resincronizaciones.
+    double deriva_momento = 0.0;   ///< Mayor |p_suma - p_llevado| / Σ m|v| entre resincronizaciones.
+    std::uint64_t resincronizaciones = 0; ///< Sumas completas comparadas con los totales llevados.
+    std::uint64_t alarmas = 0;     ///< Resincronizaciones con una deriva mayor que el umbral.
+};
+
+/**
+ * @class SistemaT
  * @brief Representa el sistema completo de simulación de un billar de N bolas.
  * 
  * Contiene la caja, las bolas y el método de integración seleccionado.
  * Se encarga de actualizar el sistema en cada paso de tiempo y guardar los resultados.
+ *
+ * `Real` es el tipo de las posiciones y velocidades: double (Sistema) o float
+ * (SistemaT<float>). Con float los pasos mueven la mitad de bytes, mientras que el
+ * tiempo, los observables y los checkpoints siguen en double. El integrador por
+ * eventos solo existe en doble precisión.
+ *
+ * @tparam Real double o float (ambos instanciados en Sistema.cpp).
  */
-class Sistema {
+template <class Real>
+class SistemaT {
 private:
     Caja caja;                    ///< Caja que define los límites del sistema.
-    std::vector<Bola> bolas;      ///< Vector de bolas presentes en la simulación.
+    ParticulasT<Real> bolas;      ///< Bolas presentes en la simulación, un arreglo por campo.
     Integrador integrador_actual = Integrador::Verlet; ///< Integrador usado en la simulación (por defecto: Verlet).
+    MotorColisiones motor_actual = MotorColisiones::Celdas; ///< Motor de búsqueda de choques (por defecto: celdas).
+    Celdas celdas;                ///< Rejilla de celdas usada por el motor de celdas.
+    bool celdas_listas = false;   ///< Indica si la rejilla corresponde a la caja y radios actuales.
+    ListaVecinos vecinos;         ///< Listas de vecinos del motor "vecinos".
+    NivelSimd nivel_simd = NivelSimdDisponible(); ///< Instrucciones usadas en el movimiento y las paredes.
+    int hilos = 1;                ///< Hilos usados por el motor paralelo y los núcleos vectoriales.
+    bool determinista = true;     ///< Si el motor paralelo debe reproducir bit a bit al motor "celdas".
+    MotorEventos eventos;         ///< Motor usado por el integrador por eventos.
+    bool eventos_listos = false;  ///< Indica si la cola de eventos corresponde al estado actual.
+    double tiempo = 0.0;          ///< Tiempo simulado acumulado por Paso.
+    long pasos = 0;               ///< Número de llamadas a Paso.
+    std::uint64_t pruebas_pares = 0; ///< Pares de bolas probados por los motores de choques.
+    Observables observables;      ///< Observables acumulados durante la corrida.
+    BalanceConservado balance;    ///< Energía, momento e impulso en paredes llevados paso a paso.
+    int intervalo_balance = 0;    ///< Pasos entre resincronizaciones del balance (0: nunca).
+    double umbral_deriva = 0.0;   ///< Deriva relativa que dispara la alarma (0: sin alarma).
+    int intervalo_observables = 0; ///< Pasos entre muestras de observables (0: desactivado).
+    Acumulador dt_adaptativos;    ///< Pasos tomados por AvanceAdaptativo.
+    int intervalo_reorden = 0;    ///< Pasos entre reordenamientos de Morton (0: nunca).
+    bool reordenadas = false;     ///< Indica si el orden de las bolas ya no es el original.
+    std::vector<std::uint32_t> orden; ///< Búfer de la permutación de Morton.
+    Cuadro cuadro_texto;          ///< Bolas en el orden original para Guarde.
+    mutable std::vector<std::uint64_t> orden_salida; ///< Pares (id, posición) de las bolas dentro de la región.
+    mutable Instrumentacion instrumentacion; ///< Tiempos por fase y contadores (con BILLAR_INSTRUMENTACION).
+    Xoshiro256 rng{static_cast<std::uint64_t>(std::time(nullptr))}; ///< Generador de las condiciones iniciales.
+
+    /** @brief Función miembro que avanza un paso con el integrador y el motor elegidos. */
+    using FuncionPaso = void (SistemaT::*)(double);
+    FuncionPaso paso_actual = nullptr; ///< Paso especializado, fijado por ElijaPaso.
+
+    /** @brief Suma el impulso de las paredes al balance y actualiza el momento llevado. */
+    void AcumuleImpulso(const ImpulsoParedes& imp);
+
+    /** @brief Suma completa de energía, momento y Σ m|v| (escala de la deriva de momento). */
+    void SumeConservadas(double& energia, double& px, double& py, double& escala) const;
+
+    /**
+     * @brief Resuelve los choques entre bolas con un motor fijado al compilar.
+     * @tparam Motor Motor de choques.
+     */
+    template <MotorColisiones Motor>
+    void ResuelvaChoques();
 
     /**
-     * @brief Realiza un paso de integración usando el método de Euler.
+     * @brief Paso de integración especializado: movimiento y paredes fusionados, luego choques.
+     * @tparam Paredes ParedSimple (Euler) o ParedRobusta (Verlet).
+     * @tparam Motor Motor de choques.
      * @param dt Paso de tiempo.
      */
-    void PasoEuler(double dt);
+    template <class Paredes, MotorColisiones Motor>
+    void PasoFijo(double dt);
+
+    /**
+     * @brief Elige la especialización de PasoFijo (o PasoEventos) para la configuración actual.
+     */
+    void ElijaPaso();
 
     /**
-     * @brief Realiza un paso de integración usando el método de Verlet.
+     * @brief Aplica el integrador actual y avanza el tiempo y el conteo de pasos, sin muestrear observables.
      * @param dt Paso de tiempo.
      */
-    void PasoVerlet(double dt);
+    void Integre(double dt);
+
+    /**
+     * @brief Avanza el sistema procesando eventos de choque exactos.
+     * @param dt Intervalo de tiempo a avanzar.
+     */
+    void PasoEventos(double dt);
 
 public:
+    /** @brief Indica si el sistema trabaja en doble precisión. */
+    static constexpr bool doble = std::is_same_v<Real, double>;
+
+    /**
+     * @brief Construye un sistema sin bolas, con Verlet y el motor de celdas.
+     */
+    SistemaT();
+
     /**
      * @brief Define las dimensiones de la caja contenedora.
      * @param W Ancho de la caja.
@@ -69,7 +204,8 @@ public:
      * @brief Inicializa las bolas en una configuración de rejilla.
      * 
      * Las posiciones se distribuyen uniformemente y las velocidades
-     * pueden asignarse aleatoriamente hasta un valor máximo dado.
+     * pueden asignarse aleatoriamente hasta un valor máximo dado. Las bolas se
+     * llenan en paralelo por bloques, cada uno con su flujo de `rng`.
      * 
      * @param m Masa de cada bola.
      * @param r Radio de cada bola.
@@ -78,19 +214,283 @@ public:
      */
     void InicialiceRejilla(double m, double r, double v_max, bool alterna = false);
 
+    /**
+     * @brief Inicializa las bolas en rejilla con velocidades de Maxwell–Boltzmann.
+     *
+     * Cada componente de la velocidad es normal con varianza kT/m. Como en
+     * InicialiceRejilla, las bolas se reparten en bloques fijos con un flujo
+     * aleatorio propio cada uno y los bloques se llenan en paralelo, así el
+     * resultado solo depende de la semilla y no del número de hilos.
+     *
+     * @param m Masa de cada bola.
+     * @param r Radio de cada bola.
+     * @param kT Temperatura (k_B = 1).
+     * @throws std::invalid_argument Si kT es negativa.
+     */
+    void InicialiceMaxwell(double m, double r, double kT);
+
+    /**
+     * @brief Fija la semilla del generador aleatorio (por defecto se usa la hora).
+     * @param semilla Semilla.
+     */
+    void DefinaSemilla(std::uint64_t semilla) { rng.Siembre(semilla); }
+
+    /**
+     * @brief Guarda el estado completo del sistema en un archivo binario.
+     *
+     * Se escribe primero en `ruta` + ".tmp" y luego se renombra, así un corte
+     * durante la escritura nunca deja un checkpoint incompleto en `ruta`.
+     * Se guardan la caja, las bolas (en su orden actual, con su índice original), el integrador, el motor de colisiones, los hilos,
+     * el tiempo, el número de pasos y el estado del generador aleatorio.
+     *
+     * @param ruta Ruta del checkpoint.
+     * @throws std::runtime_error Si no se puede escribir o renombrar el archivo.
+     */
+    void GuardeCheckpoint(const std::string& ruta) const;
+
+    /**
+     * @brief Restaura el estado guardado por GuardeCheckpoint.
+     *
+     * Los observables no forman parte del checkpoint; se activan de nuevo con DefinaObservables.
+     *
+     * @param ruta Ruta del checkpoint.
+     * @throws std::runtime_error Si el archivo no existe, está truncado o no es un checkpoint.
+     */
+    void CargueCheckpoint(const std::string& ruta);
+
     /**
      * @brief Selecciona el integrador a utilizar.
      * 
-     * @param nombre Nombre del integrador ("Euler" o "Verlet").
+     * @param nombre Nombre del integrador ("euler", "verlet" o "eventos"; este último solo en double).
      */
     void SeleccioneIntegrador(const std::string& nombre);
 
+    /**
+     * @brief Selecciona el motor de búsqueda de choques entre bolas.
+     *
+     * @param nombre Nombre del motor ("fuerza_bruta", "celdas", "paralelo" o "vecinos").
+     */
+    void SeleccioneMotorColisiones(const std::string& nombre);
+
+    /**
+     * @brief Define el número de hilos del motor paralelo.
+     *
+     * También reparte el movimiento y las paredes entre los hilos.
+     *
+     * @param n Número de hilos (al menos 1).
+     */
+    void DefinaHilos(int n);
+
+    /**
+     * @brief Define la piel de las listas de vecinos.
+     *
+     * Una piel mayor hace listas más largas pero reconstrucciones menos frecuentes.
+     *
+     * @param piel Margen sobre la distancia de contacto (positivo).
+     */
+    void DefinaPiel(double piel) { vecinos.DefinaPiel(piel); }
+
+    /** @brief Retorna las listas de vecinos (construcciones y largo medio). */
+    const ListaVecinos& GetVecinos() const { return vecinos; }
+
+    /** @brief Retorna el número de hilos configurado. */
+    int GetHilos() const { return hilos; }
+
+    /**
+     * @brief Activa o desactiva el modo determinista del motor paralelo.
+     *
+     * En modo determinista el motor paralelo usa las mismas celdas que el motor
+     * "celdas", busca los contactos en paralelo y los aplica en el orden serial
+     * (Celdas::ResuelvaChoquesOrdenado): el resultado es bit a bit el del motor "celdas",
+     * con cualquier número de hilos. Sin él, los choques se resuelven en paralelo con
+     * un coloreo de bloques de celdas agrandadas; es más rápido con muchos contactos,
+     * pero el orden de los choques cambia con los hilos y su planificación.
+     *
+     * @param activo true para el modo determinista.
+     */
+    void DefinaDeterminista(bool activo) {
+        determinista = activo;
+        celdas_listas = false;
+    }
+
+    /**
+     * @brief Selecciona el conjunto de instrucciones de los núcleos de movimiento y paredes.
+     *
+     * Por defecto se usa el más ancho que soporte la CPU.
+     *
+     * @param nombre "auto", "escalar", "avx2" o "avx512".
+     */
+    void SeleccioneSimd(const std::string& nombre);
+
+    /** @brief Retorna el conjunto de instrucciones en uso. */
+    NivelSimd GetNivelSimd() const { return nivel_simd; }
+
+    /**
+     * @brief Reordena las bolas por curva de Morton cada cierto número de pasos.
+     *
+     * Solo se aplica con Euler y Verlet (el motor por eventos guarda índices de bolas).
+     * Las salidas (CopieCuadro, Guarde) siguen en el orden original de las bolas.
+     *
+     * @param pasos Pasos entre reordenamientos (0 lo desactiva).
+     * @throws std::invalid_argument Si pasos es negativo.
+     */
+    void DefinaReorden(int pasos);
+
+    /**
+     * @brief Ordena las bolas por la clave de Morton de su celda de choques.
+     */
+    void Reordene();
+
+    /**
+     * @brief Aplica un orden dado a las bolas (la posición k recibe la bola orden[k]).
+     *
+     * Sirve para reproducir el desorden de una corrida larga en los benchmarks.
+     *
+     * @param nuevo_orden Permutación de 0..N-1.
+     */
+    void Reordene(const std::vector<std::uint32_t>& nuevo_orden);
+
     /**
      * @brief Ejecuta un paso temporal del sistema según el integrador actual.
+     *
+     * Con el integrador por eventos, `dt` puede ser tan grande como el intervalo
+     * entre cuadros de salida: se procesan todos los choques dentro del intervalo.
+     *
      * @param dt Paso de tiempo.
      */
     void Paso(double dt);
 
+    /**
+     * @brief Retorna el paso que limita el desplazamiento de cada bola a una fracción del radio.
+     *
+     * dt = fraccion * r_min / v_max con la rapidez máxima y el radio mínimo actuales.
+     *
+     * @param fraccion Desplazamiento máximo por paso, en radios (0 < fraccion <= 1).
+     * @return El paso, o infinito si ninguna bola se mueve.
+     * @throws std::invalid_argument Si la fracción está fuera de (0, 1].
+     */
+    double PasoCFL(double fraccion) const;
+
+    /**
+     * @brief Avanza exactamente `intervalo` con pasos elegidos por PasoCFL.
+     *
+     * Antes de cada paso se recalcula el paso CFL y el tramo restante se divide en
+     * partes iguales que no lo excedan; así el último paso cae justo en el final del
+     * intervalo sin dejar un paso residual diminuto. Si los observables están activos
+     * se toma una muestra al final del intervalo. Con el integrador por eventos se
+     * avanza el intervalo completo en un solo Paso.
+     *
+     * @param intervalo Tiempo a avanzar (normalmente dt_frame).
+     * @param fraccion Desplazamiento máximo por paso, en radios.
+     * @return Número de pasos tomados.
+     */
+    long AvanceAdaptativo(double intervalo, double fraccion);
+
+    /** @brief Retorna la estadística de los pasos tomados por AvanceAdaptativo. */
+    const Acumulador& GetPasosAdaptativos() const { return dt_adaptativos; }
+
+    /** @brief Retorna el número de bolas. */
+    std::size_t GetN() const { return bolas.Tamano(); }
+
+    /** @brief Retorna la caja de la simulación. */
+    const Caja& GetCaja() const { return caja; }
+
+    /**
+     * @brief Retorna una vista sobre la bola en la posición i.
+     *
+     * Tras un reordenamiento la posición ya no es el índice original; este
+     * se obtiene con `GetParticulas().id[i]`.
+     *
+     * @param i Posición de la bola en los arreglos.
+     */
+    BolaT<Real> GetBola(std::size_t i) { return BolaT<Real>(bolas, i); }
+
+    /** @brief Retorna el almacenamiento de las bolas (solo lectura). */
+    const ParticulasT<Real>& GetParticulas() const { return bolas; }
+
+    /** @brief Indica si el integrador actual es el dirigido por eventos. */
+    bool PorEventos() const { return integrador_actual == Integrador::Eventos; }
+
+    /** @brief Retorna el motor por eventos (estadísticas de eventos y choques). */
+    const MotorEventos& GetEventos() const { return eventos; }
+
+    /**
+     * @brief Activa la acumulación de observables cada cierto número de pasos.
+     * @param intervalo Pasos entre muestras (0 desactiva la acumulación).
+     * @param bins Número de bins del histograma de rapideces.
+     * @param v_maxima Límite superior del histograma de rapideces.
+     * @throws std::invalid_argument Si el intervalo es negativo o el histograma no es válido.
+     */
+    void DefinaObservables(int intervalo, std::size_t bins = 50, double v_maxima = 10.0);
+
+    /** @brief Retorna los observables acumulados. */
+    const Observables& GetObservables() const { return observables; }
+
+    /**
+     * @brief Inicia el balance de cantidades conservadas a partir del estado actual.
+     *
+     * Borra el impulso acumulado y las derivas, y toma la energía y el momento de
+     * una suma completa. Desde ahí los totales se llevan dentro de los pasos.
+     *
+     * @param intervalo Pasos entre resincronizaciones (0: solo al llamar a ResincroniceBalance).
+     * @param umbral Deriva relativa que dispara la alarma (0: sin alarma).
+     * @throws std::invalid_argument Si el intervalo o el umbral son negativos.
+     */
+    void DefinaBalance(int intervalo, double umbral);
+
+    /**
+     * @brief Compara los totales llevados con una suma completa y los reemplaza por ella.
+     *
+     * Si la diferencia relativa de energía o de momento supera el umbral, cuenta una
+     * alarma y la informa en stderr.
+     */
+    void ResincroniceBalance();
+
+    /** @brief Retorna los totales llevados, el impulso en las paredes y las derivas. */
+    const BalanceConservado& GetBalance() const { return balance; }
+
+    /** @brief Retorna el tiempo simulado acumulado. */
+    double GetTiempo() const { return tiempo; }
+
+    /** @brief Retorna el número de llamadas a Paso. */
+    long GetPasos() const { return pasos; }
+
+    /** @brief Retorna los pares de bolas probados por los motores de choques desde el inicio. */
+    std::uint64_t GetPruebasPares() const { return pruebas_pares; }
+
+    /**
+     * @brief Retorna los tiempos por fase y los contadores del paso.
+     *
+     * Solo se llenan si se compiló con BILLAR_INSTRUMENTACION; si no, todo queda en cero.
+     */
+    const Instrumentacion& GetInstrumentacion() const { return instrumentacion; }
+
+    /** @brief Borra los tiempos y contadores de la instrumentación. */
+    void ReinicieInstrumentacion() { instrumentacion.Reinicie(); }
+
+    /**
+     * @brief Copia el estado actual de las bolas en un cuadro para los escritores.
+     *
+     * Las bolas se escriben en su orden original aunque se hayan reordenado.
+     *
+     * @param c Cuadro de destino (se redimensiona si hace falta).
+     * @param t Tiempo actual de la simulación.
+     */
+    void CopieCuadro(Cuadro& c, double t) const;
+
+    /**
+     * @brief Copia en un cuadro solo las bolas elegidas por una selección de salida.
+     *
+     * El filtro recorre directamente los arreglos de las bolas: las trazadoras van a su
+     * ranura fija y, con región, solo se copian las que están dentro, ordenadas por id.
+     * `c.id` recibe los ids originales de las bolas copiadas.
+     *
+     * @param c Cuadro de destino (se redimensiona si hace falta).
+     * @param t Tiempo actual de la simulación.
+     * @param seleccion Trazadores y región (la decimación la aplica quien llama).
+     */
+    void CopieCuadro(Cuadro& c, double t, const SeleccionSalida& seleccion) const;
+
     /**
      * @brief Escribe el encabezado de columnas en un archivo de salida.
      * @param f Flujo de salida (archivo abierto).
@@ -105,5 +505,66 @@ public:
     void Guarde(std::ofstream& f, double t);
 };
 
+extern template class SistemaT<double>;
+extern template class SistemaT<float>;
+
+/** @brief Sistema en doble precisión, el usado por defecto. */
+using Sistema = SistemaT<double>;
+
+/**
+ * @brief Genera solo las bolas de una franja del estado inicial en rejilla.
+ *
+ * Recorre las N bolas con los mismos bloques y flujos de xoshiro256** que
+ * SistemaT::InicialiceRejilla (`maxwell` falso) o SistemaT::InicialiceMaxwell
+ * (verdadero) tras DefinaSemilla(semilla), así que cada bola sale idéntica bit a bit,
+ * pero solo guarda las que tienen x en [desde, hasta). La memoria es la de la franja,
+ * no la de las N bolas (lo usa el dominio MPI).
+ *
+ * @param N Número total de bolas.
+ * @param C Caja.
+ * @param m Masa de cada bola.
+ * @param r Radio de cada bola.
+ * @param maxwell Velocidades de Maxwell–Boltzmann en lugar de rapideces uniformes.
+ * @param vmax Rapidez máxima (sin `maxwell`).
+ * @param kT Temperatura (con `maxwell`).
+ * @param semilla Semilla del generador.
+ * @param desde,hasta Franja de abscisas que se guarda.
+ * @return Bolas de la franja, en orden de id.
+ * @throws std::invalid_argument Si kT es negativa.
+ */
+Particulas GenereFranja(std::uint64_t N, const Caja& C, double m, double r, bool maxwell, double vmax, double kT,
+                        std::uint64_t semilla, double desde, double hasta);
+
+/**
+ * @struct EncabezadoCheckpoint
+ * @brief Caja, tiempo y número de bolas de un checkpoint.
+ */
+struct EncabezadoCheckpoint {
+    Caja caja;                ///< Caja de la simulación.
+    double tiempo = 0.0;      ///< Tiempo simulado.
+    std::uint64_t N = 0;      ///< Número de bolas.
+};
+
+/**
+ * @brief Lee el encabezado de un checkpoint sin leer las bolas.
+ * @param ruta Ruta del checkpoint.
+ * @return Caja, tiempo y N.
+ * @throws std::runtime_error Si el archivo no existe, no es un checkpoint o está corrupto.
+ */
+EncabezadoCheckpoint LeaEncabezadoCheckpoint(const std::string& ruta);
+
+/**
+ * @brief Lee de un checkpoint solo las bolas con x en [desde, hasta).
+ *
+ * Los arreglos se leen por bloques de tamaño fijo, así que la memoria es la de
+ * la franja y no la de todas las bolas.
+ *
+ * @param ruta Ruta del checkpoint.
+ * @param desde,hasta Franja de abscisas que se guarda.
+ * @return Bolas de la franja, en el orden del archivo, con sus ids.
+ * @throws std::runtime_error Si el archivo no existe, está truncado o corrupto.
+ */
+Particulas LeaFranjaCheckpoint(const std::string& ruta, double desde, double hasta);
+
 #endif
 
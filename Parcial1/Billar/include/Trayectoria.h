@@ -0,0 +1,203 @@
+/**
+ * @file Trayectoria.h
+ * @brief Define los escritores de trayectorias del billar (texto y binario).
+ *
+ * Un escritor recibe cuadros (instantáneas de posiciones y velocidades) y los guarda
+ * en disco. El formato de texto es el histórico de `trayectorias.dat`; el binario
+ * tiene una cabecera autodescriptiva y cuadros de tamaño fijo que se escriben con
+ * una sola llamada a `write`.
+ *
+ * Con filtro de región el número de bolas cambia de cuadro a cuadro y el formato de
+ * texto pasa a una línea por bola (`t id x y vx vy`); los formatos binarios, que
+ * tienen cuadros de tamaño fijo, solo admiten cuadros completos o trazadores.
+ *
+ * Formato binario (little-endian, el de la máquina que escribe):
+ * - Cabecera de 64 bytes: magia "BILLARTJ", versión (uint32), bytes por real (uint32, 4 u 8),
+ *   campos por bola (uint32, 4), banderas (uint32, reservado), N (uint64), y W, H, R_BOLA,
+ *   dt_frame (float64).
+ * - Cada cuadro: t (float64) seguido de N registros (x, y, vx, vy) en float32 o float64.
+ */
+
+#ifndef TRAYECTORIA_H
+#define TRAYECTORIA_H
+
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @struct Cuadro
+ * @brief Instantánea del estado de las bolas en un instante.
+ */
+struct Cuadro {
+    double t = 0.0;                 ///< Instante del cuadro.
+    std::vector<double> x, y;       ///< Posiciones.
+    std::vector<double> vx, vy;     ///< Velocidades.
+    std::vector<std::uint32_t> id;  ///< Ids originales de las bolas (vacío: todas, en orden de id).
+
+    /** @brief Retorna el número de bolas del cuadro. */
+    std::size_t Tamano() const { return x.size(); }
+
+    /** @brief Ajusta el tamaño de todos los campos. */
+    void Redimensione(std::size_t N) {
+        x.resize(N);
+        y.resize(N);
+        vx.resize(N);
+        vy.resize(N);
+    }
+};
+
+/**
+ * @struct CabeceraTrayectoria
+ * @brief Parámetros de la corrida que acompañan a la trayectoria.
+ */
+struct CabeceraTrayectoria {
+    double W = 1.0;         ///< Ancho de la caja.
+    double H = 1.0;         ///< Alto de la caja.
+    double R = 0.1;         ///< Radio de las bolas.
+    double dt_frame = 0.01; ///< Intervalo entre cuadros.
+    std::uint64_t N = 0;    ///< Número de bolas.
+    int capacidad = 0;      ///< Capacidad máxima recomendada (solo informativa, formato texto).
+    std::vector<std::uint32_t> ids; ///< Ids de las N bolas escritas (vacío: 0..N-1).
+    bool variable = false;  ///< El número de bolas cambia de cuadro a cuadro (N es el máximo).
+};
+
+/**
+ * @class Escritor
+ * @brief Interfaz común de los escritores de trayectorias.
+ */
+class Escritor {
+public:
+    virtual ~Escritor() = default;
+
+    /**
+     * @brief Escribe un cuadro.
+     * @param c Cuadro a escribir.
+     */
+    virtual void Escriba(const Cuadro& c) = 0;
+
+    /** @brief Vacía los búferes y cierra el archivo. */
+    virtual void Cierre() {}
+};
+
+/**
+ * @class EscritorTexto
+ * @brief Escribe el formato de texto de columnas fijas (`trayectorias.dat`).
+ *
+ * Con cuadros de tamaño variable (filtro de región) escribe una línea por bola.
+ */
+class EscritorTexto : public Escritor {
+private:
+    std::ofstream f;       ///< Archivo de salida.
+    bool por_bola = false; ///< Una línea `t id x y vx vy` por bola en lugar de una por cuadro.
+
+public:
+    /**
+     * @brief Abre el archivo y escribe los comentarios de parámetros y el encabezado de columnas.
+     * @param ruta Ruta del archivo.
+     * @param cab Parámetros de la corrida.
+     * @throws std::runtime_error Si no se puede abrir el archivo.
+     */
+    EscritorTexto(const std::string& ruta, const CabeceraTrayectoria& cab);
+
+    void Escriba(const Cuadro& c) override;
+    void Cierre() override;
+};
+
+/**
+ * @class EscritorBinario
+ * @brief Escribe la trayectoria en el formato binario de cuadros de tamaño fijo.
+ */
+class EscritorBinario : public Escritor {
+private:
+    std::ofstream f;          ///< Archivo de salida.
+    int bytes_real;           ///< 4 (float32) u 8 (float64).
+    std::uint64_t N;          ///< Número de bolas declarado en la cabecera.
+    std::vector<char> buffer; ///< Cuadro empaquetado, reutilizado entre llamadas.
+
+public:
+    /**
+     * @brief Abre el archivo y escribe la cabecera binaria.
+     * @param ruta Ruta del archivo.
+     * @param cab Parámetros de la corrida.
+     * @param bytes_real 4 para float32 u 8 para float64.
+     * @throws std::invalid_argument Si bytes_real no es 4 ni 8.
+     * @throws std::runtime_error Si no se puede abrir el archivo.
+     */
+    EscritorBinario(const std::string& ruta, const CabeceraTrayectoria& cab, int bytes_real = 8);
+
+    /**
+     * @brief Empaqueta el cuadro y lo escribe con una sola llamada.
+     * @param c Cuadro a escribir (debe tener N bolas).
+     * @throws std::invalid_argument Si el cuadro no tiene N bolas.
+     */
+    void Escriba(const Cuadro& c) override;
+    void Cierre() override;
+};
+
+/**
+ * @class EscritorMultiple
+ * @brief Reparte cada cuadro entre varios escritores (por ejemplo la trayectoria y la animación).
+ */
+class EscritorMultiple : public Escritor {
+private:
+    std::vector<std::unique_ptr<Escritor>> destinos; ///< Escritores, en el orden en que reciben los cuadros.
+
+public:
+    /**
+     * @brief Agrega un escritor; los nulos se ignoran.
+     * @param destino Escritor.
+     */
+    void Agregue(std::unique_ptr<Escritor> destino);
+
+    /** @brief Retorna el número de escritores. */
+    std::size_t Tamano() const { return destinos.size(); }
+
+    void Escriba(const Cuadro& c) override;
+    void Cierre() override;
+};
+
+/**
+ * @class EscritorConteo
+ * @brief Escribe el instante y el número de bolas de cada cuadro (`t n`).
+ *
+ * Acompaña al filtro de región: da el conteo por cuadro aunque no se guarde la trayectoria.
+ */
+class EscritorConteo : public Escritor {
+private:
+    std::ofstream f; ///< Archivo de salida.
+
+public:
+    /**
+     * @brief Abre el archivo y escribe el encabezado.
+     * @param ruta Ruta del archivo.
+     * @throws std::runtime_error Si no se puede abrir el archivo.
+     */
+    explicit EscritorConteo(const std::string& ruta);
+
+    void Escriba(const Cuadro& c) override;
+    void Cierre() override;
+};
+
+/**
+ * @brief Escribe la línea de encabezado de columnas del formato de texto.
+ * @param f Flujo de salida.
+ * @param N Número de bolas.
+ * @param ids Ids de las bolas para nombrar las columnas (nulo: 0..N-1).
+ */
+void EscribaEncabezadoTexto(std::ostream& f, std::size_t N, const std::uint32_t* ids = nullptr);
+
+/**
+ * @brief Escribe una fila del formato de texto (t seguido de x, y, vx, vy de cada bola).
+ * @param f Flujo de salida.
+ * @param t Instante.
+ * @param x,y,vx,vy Arreglos de N valores.
+ * @param N Número de bolas.
+ */
+void EscribaFilaTexto(std::ostream& f, double t, const double* x, const double* y,
+                      const double* vx, const double* vy, std::size_t N);
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file Vecinos.h
+ * @brief Define la clase ListaVecinos, listas de Verlet con una piel para los choques entre bolas.
+ *
+ * Con pasos de 0.001 cada bola avanza una fracción mínima de su radio por paso, así que
+ * reconstruir los pares cercanos en cada paso repite casi siempre el mismo trabajo. La
+ * lista guarda, para cada bola i, las bolas j > i a distancia menor que r_i + r_j + piel
+ * y solo se reconstruye cuando alguna bola se desplazó más de piel/2 desde la última
+ * construcción: hasta entonces ningún par fuera de la lista puede haberse tocado.
+ * Las posiciones de referencia se guardan en double aunque las bolas sean float.
+ */
+
+#ifndef VECINOS_H
+#define VECINOS_H
+
+#include "Caja.h"
+#include "Celdas.h"
+#include "Particulas.h"
+#include "Instrumentacion.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class ListaVecinos
+ * @brief Listas de vecinos en formato comprimido (un arreglo de socios y un desplazamiento por bola).
+ */
+class ListaVecinos {
+private:
+    double piel = 0.1;               ///< Margen agregado a la distancia de contacto.
+    bool valida = false;             ///< Indica si la lista corresponde a las bolas actuales.
+    Celdas celdas;                   ///< Rejilla usada para construir la lista.
+    std::vector<int> inicio;         ///< Desplazamiento de cada bola en `socios` (tamaño N + 1).
+    std::vector<int> socios;         ///< Vecinos j > i de cada bola, en orden de construcción.
+    VectorAlineado<double> x0, y0;   ///< Posiciones en la última construcción.
+    std::uint64_t construcciones = 0; ///< Veces que se construyó la lista.
+    std::uint64_t usos = 0;          ///< Llamadas a ResuelvaChoques.
+    std::uint64_t entradas = 0;      ///< Suma del largo de la lista en cada uso.
+
+    /**
+     * @brief Indica si alguna bola se movió más de piel/2 desde la última construcción.
+     * @param bolas Bolas del sistema.
+     */
+    template <class Real>
+    bool DebeReconstruir(const ParticulasT<Real>& bolas) const;
+
+public:
+    /**
+     * @brief Define la piel (el margen sobre la distancia de contacto).
+     * @param p Piel (positiva).
+     * @throws std::invalid_argument Si p no es positiva.
+     */
+    void DefinaPiel(double p);
+
+    /** @brief Retorna la piel. */
+    double GetPiel() const { return piel; }
+
+    /** @brief Fuerza la reconstrucción en el próximo uso (cambio de caja, bolas u orden). */
+    void Invalide() { valida = false; }
+
+    /**
+     * @brief Reconstruye la lista si hace falta.
+     *
+     * Se reconstruye si la lista no es válida o si alguna bola se desplazó más de
+     * piel/2. La rejilla usa celdas de lado 2 r_max + piel.
+     *
+     * @param bolas Bolas del sistema.
+     * @param C Caja de la simulación.
+     * @return true si se reconstruyó.
+     */
+    template <class Real>
+    bool Actualice(const ParticulasT<Real>& bolas, const Caja& C);
+
+    /**
+     * @brief Resuelve los choques probando solo los pares de la lista.
+     * @param bolas Bolas del sistema (la lista debe estar actualizada).
+     * @return Pares probados y, con la instrumentación, el efecto de los choques.
+     */
+    template <class Real>
+    ConteoChoques ResuelvaChoques(ParticulasT<Real>& bolas);
+
+    /** @brief Retorna el número de construcciones de la lista. */
+    std::uint64_t GetConstrucciones() const { return construcciones; }
+
+    /** @brief Retorna el número de pasos que usaron la lista. */
+    std::uint64_t GetUsos() const { return usos; }
+
+    /** @brief Retorna los pares de la lista por bola, en promedio sobre los usos. */
+    double GetLargoMedio(std::size_t N) const;
+};
+
+#endif
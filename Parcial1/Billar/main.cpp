@@ -1,74 +1,126 @@
 /**
  * @file main.cpp
  * @brief Programa principal que ejecuta la simulación del sistema de bolas en una caja.
- * 
- * Solicita los parámetros al usuario, configura el sistema y guarda
- * los resultados en un archivo para posterior visualización.
+ *
+ * Sin argumentos solicita los parámetros al usuario, ejecuta una corrida y
+ * ofrece graficarla. Con argumentos (`--N 400 --tf 20`, `--config archivo`,
+ * `--barrido N=100,200`) ejecuta una o varias corridas sin preguntar nada y
+ * escribe `resumen.json` en el directorio de salida; con `--replicas K` cada
+ * configuración se promedia sobre K condiciones iniciales independientes.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <filesystem>
+#include <fstream>
 #include <string>
 #include <stdexcept>
-#include <cmath>
-#include "Sistema.h"
+#include "Configuracion.h"
+#include "Corrida.h"
+#include "Ensamble.h"
+#include "Trayectoria.h"
+#include "Compresion.h"
 
 /**
- * @brief Calcula la capacidad máxima de bolas en la caja
- * @param W Ancho de la caja
- * @param H Alto de la caja
- * @param r Radio de cada bola
- * @return Número máximo de bolas que caben en la caja
+ * @brief Ejecuta las corridas pedidas en la línea de comandos, sin interacción.
+ * @param argc,argv Argumentos del programa.
+ * @return 0 si todas las corridas terminan correctamente.
  */
-int CalcularCapacidadMaxima(double W, double H, double r) {
-    // Calcula cuántas bolas caben en una disposición de rejilla hexagonal
-    // que es más eficiente que la cuadrada
-    double diametro = 2 * r;
-    int columnas = std::max(1, static_cast<int>((W - r) / diametro));
-    int filas = std::max(1, static_cast<int>((H - r) / (diametro * std::sqrt(3) / 2)));
-    
-    return columnas * filas;
+int EjecuteLotes(int argc, char* argv[]) {
+    OpcionesLinea op;
+    std::vector<Configuracion> corridas;
+    try {
+        op = LeaLineaComandos(argc, argv);
+        corridas = ExpandaBarridos(op.base, op.barridos);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n\n";
+        EscribaAyuda(std::cerr, argv[0]);
+        return 1;
+    }
+    if (op.ayuda) {
+        EscribaAyuda(std::cout, argv[0]);
+        return 0;
+    }
+
+    // Sin usuario a quien preguntar, la sobrepoblación solo se advierte.
+    for (const Configuracion& c : corridas) {
+        int capacidad = CalcularCapacidadMaxima(c.W, c.H, c.r);
+        if (c.reanude.empty() && c.N > capacidad)
+            std::cerr << "ADVERTENCIA: " << c.N << " bolas superan la capacidad recomendada ("
+                      << capacidad << ") de la caja " << c.W << "x" << c.H << ".\n";
+    }
+
+    std::filesystem::create_directories(op.base.salida);
+    const std::string ruta_resumen = op.base.salida + "/resumen.json";
+
+    // --- Ensambles: réplicas repartidas entre todos los hilos, sin trayectorias ---
+    bool ensamble = false;
+    for (const Configuracion& c : corridas)
+        ensamble = ensamble || c.replicas > 1;
+    if (ensamble) {
+        std::cout << "Ejecutando " << corridas.size() << " ensamble(s)..." << std::endl;
+        std::vector<ResultadoEnsamble> resultados = EjecuteEnsambles(corridas, op.trabajos);
+        std::ofstream resumen(ruta_resumen);
+        EscribaResumenEnsamblesJson(resumen, corridas, resultados);
+        std::cout << "Resumen en " << ruta_resumen << "\n";
+        for (const ResultadoEnsamble& r : resultados)
+            if (!r.errores.empty()) return 1;
+        return 0;
+    }
+
+    const int trabajos = std::max(1, op.trabajos);
+    std::cout << "Ejecutando " << corridas.size() << " corrida(s) con "
+              << trabajos << " trabajo(s) simultáneo(s)..." << std::endl;
+    std::vector<ResultadoCorrida> resultados = EjecuteBarrido(corridas, trabajos);
+
+    std::ofstream resumen(ruta_resumen);
+    EscribaResumenJson(resumen, corridas, resultados);
+    std::cout << "Resumen en " << ruta_resumen << "\n";
+
+    for (const ResultadoCorrida& r : resultados)
+        if (!r.exito) return 1;
+    return 0;
 }
 
 /**
  * @brief Función principal.
- * 
- * Configura los parámetros de la simulación, selecciona el integrador,
- * ejecuta la evolución temporal y guarda los datos en un archivo.
- * 
+ *
+ * Con argumentos delega en EjecuteLotes. Sin argumentos pide los parámetros y
+ * ejecuta la corrida en `../results`, que dibuja la animación GIF mientras simula;
+ * al final ofrece generar las gráficas de trayectorias y velocidades.
+ *
  * @return 0 si la simulación termina correctamente.
  */
-int main() {
-    Sistema sim;
-    const double dt_sim = 0.001; ///< Paso interno de integración.
-    const double dt_frame = 0.01; ///< Intervalo entre registros de salida.
-    const double m = 1.0; ///< Masa de cada bola.
-    const double r = 0.2; ///< Radio de cada bola.
-    const double vmax = 4.0; ///< Velocidad máxima inicial.
-    double tf, W, H;
-    int N;
+int main(int argc, char* argv[]) {
+    if (argc > 1)
+        return EjecuteLotes(argc, argv);
+
+    Configuracion c;
     std::string integrador_nombre;
+    std::string motor_nombre;
+    std::string formato;
+    int hilos = 1;
 
     // --- Entrada de usuario ---
     std::cout << "Ingrese el numero de particulas (N): ";
-    std::cin >> N;
+    std::cin >> c.N;
     std::cout << "Ingrese el tiempo total de simulacion (s): ";
-    std::cin >> tf;
+    std::cin >> c.tf;
     std::cout << "Ingrese el ancho de la caja: ";
-    std::cin >> W;
+    std::cin >> c.W;
     std::cout << "Ingrese el alto de la caja: ";
-    std::cin >> H;
-    
+    std::cin >> c.H;
+
     // --- Validación de capacidad ---
-    int capacidad_maxima = CalcularCapacidadMaxima(W, H, r);
-    if (N > capacidad_maxima) {
+    int capacidad_maxima = CalcularCapacidadMaxima(c.W, c.H, c.r);
+    if (c.N > capacidad_maxima) {
         std::cerr << "\n  ADVERTENCIA: Demasiadas bolas para la caja!" << std::endl;
-        std::cerr << "La caja de " << W << "x" << H << " con bolas de radio " << r 
+        std::cerr << "La caja de " << c.W << "x" << c.H << " con bolas de radio " << c.r
                   << " puede contener como máximo " << capacidad_maxima << " bolas." << std::endl;
-        std::cerr << "Has solicitado " << N << " bolas." << std::endl;
+        std::cerr << "Has solicitado " << c.N << " bolas." << std::endl;
         std::cerr << "¿Deseas continuar de todos modos? (s/n): ";
-        
+
         char respuesta;
         std::cin >> respuesta;
         if (respuesta != 's' && respuesta != 'S') {
@@ -77,65 +129,86 @@ int main() {
         }
         std::cout << "Continuando con configuración sobrepoblada..." << std::endl;
     }
-    
-    std::cout << "Elija el integrador (euler/verlet): ";
+
+    std::cout << "Elija el integrador (euler/verlet/eventos): ";
     std::cin >> integrador_nombre;
+    std::cout << "Elija el motor de colisiones (fuerza_bruta/celdas/paralelo/vecinos): ";
+    std::cin >> motor_nombre;
+    if (motor_nombre == "paralelo") {
+        std::cout << "Ingrese el numero de hilos: ";
+        std::cin >> hilos;
+    }
+    std::cout << "Elija el formato de salida (texto/binario32/binario64/comprimido/columnar/ninguno): ";
+    std::cin >> formato;
+    if (formato == "comprimido") {
+        std::cout << "Ingrese la tolerancia de posicion: ";
+        std::cin >> c.tolerancia;
+    }
 
     // --- Configuración del sistema ---
+    // La animación se dibuja durante la corrida, en el hilo del escritor.
+    c.animacion = "gif";
     try {
-        sim.SeleccioneIntegrador(integrador_nombre);
+        AsigneParametro(c, "integrador", integrador_nombre);
+        AsigneParametro(c, "motor", motor_nombre);
+        AsigneParametro(c, "hilos", std::to_string(hilos));
+        AsigneParametro(c, "formato", formato);
     } catch (const std::invalid_argument& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
     }
 
-    sim.DefinaCaja(W, H);
-    sim.Reserve(N);
-    sim.InicialiceRejilla(m, r, vmax);
-
-    // --- Archivo de salida ---
-    std::filesystem::create_directories("../results");
-    std::ofstream archivo("../results/trayectorias.dat");
-
-    archivo << "# W: " << W << "\n";
-    archivo << "# H: " << H << "\n";
-    archivo << "# R_BOLA: " << r << "\n";
-    archivo << "# N_BOLAS: " << N << "\n";
-    archivo << "# CAPACIDAD_MAXIMA_RECOMENDADA: " << capacidad_maxima << "\n";
-
-    std::cout << "Iniciando simulacion con el integrador '" 
+    std::cout << "Iniciando simulacion con el integrador '"
               << integrador_nombre << "'..." << std::endl;
-    std::cout << "Configuración: " << N << " bolas en caja " << W << "x" << H 
+    std::cout << "Configuración: " << c.N << " bolas en caja " << c.W << "x" << c.H
               << " (capacidad recomendada: " << capacidad_maxima << ")" << std::endl;
 
-    // --- Bucle principal de simulación ---
-    double t = 0;
-    long pasos_por_frame = static_cast<long>(dt_frame / dt_sim);
-
-    sim.Encabezado(archivo);
-
-    while (t <= tf) {
-        sim.Guarde(archivo, t);
-        for (long i = 0; i < pasos_por_frame; ++i)
-            sim.Paso(dt_sim);
-        t += dt_frame;
-
-        std::cout << "\rProgreso: " 
-                  << std::fixed << std::setprecision(1)
-                  << (t / tf) * 100.0 << "%" << std::flush;
+    // --- Simulación ---
+    ResultadoCorrida res = EjecuteCorrida(c, c.salida, true);
+    if (!res.exito) {
+        std::cerr << "Error: " << res.error << std::endl;
+        return 1;
     }
 
-    std::cout << "\nSimulacion completada. Datos guardados en ../results/trayectorias.dat\n";
-    archivo.close();
+    std::cout << "Simulacion completada.";
+    if (!res.ruta_trayectoria.empty())
+        std::cout << " Datos guardados en " << res.ruta_trayectoria;
+    std::cout << "\n";
+    if (res.eventos > 0)
+        std::cout << "Eventos procesados: " << res.eventos << "\n";
+    std::cout << "Tiempo de ejecucion: " << std::setprecision(3) << res.segundos
+              << " s (detenido esperando E/S: " << res.segundos_espera_io << " s)\n";
+    std::cout << "Checkpoint final en " << c.salida << "/checkpoint.bin (t = " << res.t_final << ")\n";
+    std::cout << "Animacion en " << res.ruta_animacion << "\n";
+
+    // --- Observables ---
+    std::cout << "Temperatura media: " << std::setprecision(6) << res.temperatura
+              << ", chi2 Maxwell: " << res.chi2_maxwell << " (" << res.grados_maxwell << " grados)\n";
+    std::cout << "Resumen de observables en " << c.salida << "/observables.dat\n";
+    if (res.ruta_trayectoria.empty())
+        return 0;
 
     // --- Opción de visualización ---
-    std::cout << "Generar animacion con (p)ython o (g)nuplot? ";
+    std::cout << "Generar graficas con (p)ython, animacion con (g)nuplot o (n)inguna? ";
     char op;
     std::cin >> op;
 
+    std::string ruta_salida = res.ruta_trayectoria;
+    if ((op == 'p' || op == 'P') && c.formato == "comprimido") {
+        // El script de Python lee el binario; se descomprime primero.
+        LectorComprimido lector(ruta_salida);
+        ruta_salida = c.salida + "/trayectorias.bin";
+        EscritorBinario binario(ruta_salida, lector.GetCabecera(), 8);
+        Cuadro cuadro;
+        while (lector.Siguiente(cuadro))
+            binario.Escriba(cuadro);
+        binario.Cierre();
+    }
     if (op == 'p' || op == 'P') {
         std::cout << "Ejecutando script de Python..." << std::endl;
-        system("python3 ../scripts/graficar.py");
+        system(("python3 ../scripts/graficar.py --sin-gif " + ruta_salida).c_str());
+    } else if ((op == 'g' || op == 'G') && c.formato != "texto") {
+        std::cout << "Gnuplot solo lee ../results/trayectorias.dat; use la opcion de Python." << std::endl;
     } else if (op == 'g' || op == 'G') {
         std::cout << "Ejecutando script de Gnuplot..." << std::endl;
         system("gnuplot ../scripts/graficar.gnuplot");
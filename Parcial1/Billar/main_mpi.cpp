@@ -0,0 +1,201 @@
+/**
+ * @file main_mpi.cpp
+ * @brief Programa que reparte la caja del billar entre varios procesos MPI.
+ *
+ * Se ejecuta con `mpirun -np P simulacion_mpi --N 40000 --W 400 --tf 5 ...` y acepta
+ * los mismos parámetros que `simulacion` (sin barridos ni réplicas). Cada rango genera
+ * (o lee del checkpoint) solo las bolas de su franja de la caja (Dominio), así que
+ * ningún proceso guarda las N bolas; el rango 0
+ * reúne los cuadros y escribe la trayectoria, la animación si se pidió, `dominio.dat`
+ * (número de bolas y energía por cuadro) y `resumen_mpi.json` con los tiempos para
+ * medir el escalamiento.
+ */
+
+#include <mpi.h>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "Configuracion.h"
+#include "Corrida.h"
+#include "Dominio.h"
+#include "EscritorAsincrono.h"
+#include "Sistema.h"
+#include "Trayectoria.h"
+
+/**
+ * @brief Ejecuta la corrida repartida entre los rangos de MPI_COMM_WORLD.
+ * @param argc,argv Argumentos del programa.
+ * @return 0 si la corrida termina correctamente.
+ * @throws std::invalid_argument Si se piden opciones que el dominio MPI no admite.
+ */
+int EjecuteDominio(int argc, char* argv[]) {
+    int rango = 0, rangos = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rango);
+    MPI_Comm_size(MPI_COMM_WORLD, &rangos);
+
+    OpcionesLinea op = LeaLineaComandos(argc, argv);
+    if (op.ayuda) {
+        if (rango == 0) EscribaAyuda(std::cout, argv[0]);
+        return 0;
+    }
+    const Configuracion& c = op.base;
+    if (!op.barridos.empty() || c.replicas > 1)
+        throw std::invalid_argument("simulacion_mpi ejecuta una sola corrida: sin barridos ni réplicas.");
+    if (c.cfl > 0.0)
+        throw std::invalid_argument("simulacion_mpi usa paso fijo dt_sim (cfl = 0).");
+    if (c.precision != "doble")
+        throw std::invalid_argument("simulacion_mpi solo admite precision = doble.");
+    if (!c.trazadores.empty() || !c.region.empty())
+        throw std::invalid_argument("simulacion_mpi escribe cuadros completos: sin trazadores ni región.");
+
+    // --- Estado inicial: cada rango genera o lee solo las bolas de su franja ---
+    // La semilla se fija en el rango 0, para que todos recorran los mismos flujos.
+    std::uint64_t semilla = c.semilla != 0 ? c.semilla : static_cast<std::uint64_t>(std::time(nullptr));
+    MPI_Bcast(&semilla, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD);
+    Caja caja;
+    double tiempo = 0.0;
+    if (c.reanude.empty()) {
+        caja.Defina(c.W, c.H);
+    } else {
+        const EncabezadoCheckpoint e = LeaEncabezadoCheckpoint(c.reanude);
+        caja = e.caja;
+        tiempo = e.tiempo;
+    }
+    auto dominio = std::make_unique<Dominio>(caja, c.integrador, MPI_COMM_WORLD);
+    if (c.reanude.empty())
+        dominio->Cargue(GenereFranja(static_cast<std::uint64_t>(c.N), caja, c.m, c.r, c.inicial == "maxwell",
+                                     c.vmax, c.kT, semilla, dominio->GetDesde(), dominio->GetHasta()));
+    else
+        dominio->Cargue(LeaFranjaCheckpoint(c.reanude, dominio->GetDesde(), dominio->GetHasta()));
+    dominio->DefinaSimd(NivelSimdDesdeNombre(c.simd));
+    dominio->DefinaReorden(c.reorden_cada);
+    dominio->DefinaTiempo(tiempo);
+    const double radio = dominio->GetHalo() > 0.0 ? dominio->GetHalo() / 2.0 : c.r;
+    const std::uint64_t N = dominio->NTotal();
+
+    // --- Salida, solo en el rango 0 ---
+    std::unique_ptr<EscritorAsincrono> escritor;
+    std::ofstream archivo_dominio;
+    std::string ruta_trayectoria, ruta_animacion;
+    if (rango == 0) {
+        std::filesystem::create_directories(c.salida);
+        CabeceraTrayectoria cab;
+        cab.W = caja.GetW();
+        cab.H = caja.GetH();
+        cab.R = radio;
+        cab.N = N;
+        cab.dt_frame = c.dt_frame * c.salida_cada;
+        cab.capacidad = CalcularCapacidadMaxima(cab.W, cab.H, cab.R);
+        std::unique_ptr<Escritor> destino = CreeEscritor(c.formato, c.salida + "/trayectorias", cab,
+                                                         c.tolerancia, ruta_trayectoria);
+        std::unique_ptr<Escritor> animacion = CreeAnimacion(c, cab, c.salida + "/animacion", ruta_animacion);
+        if (animacion) {
+            auto ambos = std::make_unique<EscritorMultiple>();
+            ambos->Agregue(std::move(destino));
+            ambos->Agregue(std::move(animacion));
+            destino = std::move(ambos);
+        }
+        if (destino)
+            escritor = std::make_unique<EscritorAsincrono>(std::move(destino), 4, N);
+        archivo_dominio.open(c.salida + "/dominio.dat");
+        archivo_dominio << "# t N E desbalance\n" << std::setprecision(12);
+        std::cout << "Ejecutando " << N << " bolas en " << rangos << " rango(s)..." << std::endl;
+    }
+    Cuadro descartado; // Los rangos distintos de 0 no guardan el cuadro reunido.
+
+    // --- Bucle principal ---
+    const long pasos_por_cuadro = PasosPorCuadro(c);
+    const double energia_inicial = dominio->EnergiaTotal();
+    double energia = energia_inicial;
+    double t = dominio->GetTiempo();
+    long cuadros = 0;
+    MPI_Barrier(MPI_COMM_WORLD);
+    const double inicio = MPI_Wtime();
+    while (t <= c.tf) {
+        if (cuadros % c.salida_cada != 0) {
+            // Cuadro decimado: ningún rango lo reúne.
+        } else if (escritor) {
+            dominio->Reuna(escritor->ObtengaLibre(), t);
+            escritor->Publique();
+        } else if (c.formato != "ninguno" || c.animacion != "ninguna") {
+            dominio->Reuna(descartado, t);
+        }
+        for (long k = 0; k < pasos_por_cuadro; ++k)
+            dominio->Paso(c.dt_sim);
+        t += c.dt_frame;
+        ++cuadros;
+
+        energia = dominio->EnergiaTotal();
+        const std::uint64_t n = dominio->NTotal();
+        const double desbalance = dominio->Desbalance();
+        if (rango == 0)
+            archivo_dominio << t << ' ' << n << ' ' << energia << ' ' << desbalance << '\n';
+        if (n != N)
+            throw std::runtime_error("Se perdieron bolas entre rangos: " + std::to_string(n) + " de " + std::to_string(N) + ".");
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    const double segundos = MPI_Wtime() - inicio;
+    if (escritor) escritor->Cierre();
+
+    // --- Resumen: comunicación del rango más lento y totales de todos ---
+    const ContadoresDominio& propios = dominio->GetContadores();
+    double comunicacion = 0.0;
+    unsigned long long totales[3] = {propios.migraciones, propios.fantasmas, propios.pruebas_pares};
+    unsigned long long sumas[3] = {0, 0, 0};
+    MPI_Reduce(&propios.segundos_comunicacion, &comunicacion, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(totales, sumas, 3, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    const double desbalance = dominio->Desbalance();
+    if (rango != 0) return 0;
+
+    const long pasos = propios.pasos;
+    const std::string ruta_resumen = c.salida + "/resumen_mpi.json";
+    std::ofstream f(ruta_resumen);
+    f << "{\n  \"parametros\": ";
+    EscribaParametrosJson(f, c);
+    f << ",\n"
+      << "  \"rangos\": " << rangos << ",\n"
+      << "  \"N\": " << N << ",\n"
+      << "  \"trayectoria\": " << TextoJson(ruta_trayectoria) << ",\n"
+      << "  \"animacion\": " << TextoJson(ruta_animacion) << ",\n"
+      << "  \"pasos\": " << pasos << ",\n"
+      << "  \"cuadros\": " << cuadros << ",\n"
+      << "  \"segundos\": " << RealJson(segundos) << ",\n"
+      << "  \"segundos_comunicacion\": " << RealJson(comunicacion) << ",\n"
+      << "  \"bolas_pasos_por_segundo\": " << RealJson(segundos > 0.0 ? N * static_cast<double>(pasos) / segundos : 0.0) << ",\n"
+      << "  \"energia_inicial\": " << RealJson(energia_inicial) << ",\n"
+      << "  \"energia_final\": " << RealJson(energia) << ",\n"
+      << "  \"migraciones\": " << sumas[0] << ",\n"
+      << "  \"fantasmas_por_paso\": " << RealJson(pasos > 0 ? static_cast<double>(sumas[1]) / pasos : 0.0) << ",\n"
+      << "  \"pares_por_paso\": " << RealJson(pasos > 0 ? static_cast<double>(sumas[2]) / pasos : 0.0) << ",\n"
+      << "  \"desbalance\": " << RealJson(desbalance) << "\n"
+      << "}\n";
+    std::cout << pasos << " pasos en " << segundos << " s (" << comunicacion << " s de comunicación); "
+              << "energía " << energia_inicial << " -> " << energia << "\n"
+              << "Resumen en " << ruta_resumen << "\n";
+    return 0;
+}
+
+/**
+ * @brief Función principal: inicia MPI, ejecuta la corrida y aborta todos los rangos si uno falla.
+ * @param argc,argv Argumentos del programa.
+ * @return Código de salida.
+ */
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    int estado = 0;
+    try {
+        estado = EjecuteDominio(argc, argv);
+    } catch (const std::exception& e) {
+        int rango = 0;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rango);
+        std::cerr << "Error (rango " << rango << "): " << e.what() << "\n";
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    MPI_Finalize();
+    return estado;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file prueba_kernels.cpp
+ * @brief Comprueba que cada nivel SIMD de la CPU reproduce bit a bit a los núcleos escalares.
+ *
+ * Para cada nivel soportado (AVX2, AVX-512) se aplica KernelsIdenticos, que compara
+ * movimiento, paredes simples y robustas, la pasada fusionada y el impulso en las paredes,
+ * en double y en float. Las bolas tienen masas distintas para que el impulso dependa de
+ * la masa de cada carril, y N no es múltiplo del ancho de los registros para cubrir la cola.
+ * Retorna 0 si todos los niveles coinciden y 1 si alguno no.
+ */
+
+#include "Sistema.h"
+#include "Kernels.h"
+#include <iostream>
+
+namespace {
+
+/**
+ * @brief Arma un gas de N bolas con masas entre 0.5 y 2.
+ * @param N Número de bolas.
+ * @param sim Sistema a llenar.
+ */
+void ArmeGas(int N, Sistema& sim) {
+    sim.DefinaCaja(40.0, 30.0);
+    sim.Reserve(N);
+    sim.DefinaReorden(0);
+    sim.DefinaSemilla(2024);
+    sim.InicialiceMaxwell(4.0, 0.2, 1.0);
+}
+
+} // namespace
+
+/**
+ * @brief Recorre los niveles soportados y compara cada uno con el escalar.
+ * @return 0 si todos coinciden; 1 si alguno difiere.
+ */
+int main() {
+    const NivelSimd disponible = NivelSimdDisponible();
+    int fallas = 0;
+    for (int N : {1003, 20011}) {
+        Sistema sim;
+        ArmeGas(N, sim);
+        Particulas P = sim.GetParticulas();
+        for (std::size_t i = 0; i < P.Tamano(); ++i) {
+            P.m[i] = 0.5 + 0.25 * static_cast<double>(i % 7);
+            P.inv_m[i] = 1.0 / P.m[i];
+        }
+        for (NivelSimd nivel : {NivelSimd::AVX2, NivelSimd::AVX512}) {
+            if (static_cast<int>(nivel) > static_cast<int>(disponible))
+                continue;
+            const bool identicos = KernelsIdenticos(P, sim.GetCaja(), 0.01, nivel);
+            std::cout << "N = " << N << ", " << NombreNivelSimd(nivel) << ": "
+                      << (identicos ? "idénticos" : "DIFIEREN") << "\n";
+            if (!identicos) ++fallas;
+        }
+    }
+    if (disponible == NivelSimd::Escalar)
+        std::cout << "La CPU no tiene niveles vectoriales; solo existe el camino escalar.\n";
+    return fallas == 0 ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file prueba_motores.cpp
+ * @brief Comprueba que el motor paralelo determinista reproduce bit a bit al motor de celdas.
+ *
+ * Se avanza el mismo gas denso (muchos contactos y correcciones de posición) con el
+ * motor "celdas" y con el motor "paralelo" en modo determinista con 1, 2 y 4 hilos,
+ * en double y en float, y se comparan los bits de posiciones y velocidades.
+ * Retorna 0 si todas las corridas coinciden y 1 si alguna no.
+ */
+
+#include "Sistema.h"
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+
+/**
+ * @brief Avanza un gas denso con un motor y un número de hilos.
+ * @param motor Nombre del motor.
+ * @param hilos Número de hilos.
+ * @return Bolas al final.
+ */
+template <class Real>
+ParticulasT<Real> Avance(const std::string& motor, int hilos) {
+    SistemaT<Real> sim;
+    sim.DefinaCaja(40.0, 10.0);
+    sim.Reserve(3000);
+    sim.DefinaSemilla(3);
+    sim.SeleccioneMotorColisiones(motor);
+    sim.DefinaHilos(hilos);
+    sim.DefinaDeterminista(true);
+    sim.InicialiceRejilla(1.0, 0.2, 4.0);
+    for (int paso = 0; paso < 300; ++paso)
+        sim.Paso(0.001);
+    return sim.GetParticulas();
+}
+
+/** @brief Compara bit a bit dos arreglos. */
+template <class T>
+bool MismosBits(const VectorAlineado<T>& a, const VectorAlineado<T>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+/**
+ * @brief Compara el motor paralelo determinista con el de celdas en un tipo.
+ * @param tipo Nombre del tipo, para el mensaje.
+ * @return Número de corridas que no coinciden.
+ */
+template <class Real>
+int CompareMotores(const char* tipo) {
+    const ParticulasT<Real> celdas = Avance<Real>("celdas", 1);
+    int fallas = 0;
+    for (int hilos : {1, 2, 4}) {
+        const ParticulasT<Real> p = Avance<Real>("paralelo", hilos);
+        const bool identicos = MismosBits(celdas.x, p.x) && MismosBits(celdas.y, p.y) &&
+                               MismosBits(celdas.vx, p.vx) && MismosBits(celdas.vy, p.vy) &&
+                               MismosBits(celdas.id, p.id);
+        std::cout << tipo << ", paralelo con " << hilos << " hilos: "
+                  << (identicos ? "idéntico a celdas" : "DIFIERE de celdas") << "\n";
+        if (!identicos) ++fallas;
+    }
+    return fallas;
+}
+
+} // namespace
+
+/**
+ * @brief Corre la comparación en double y en float.
+ * @return 0 si todas coinciden; 1 si alguna difiere.
+ */
+int main() {
+    const int fallas = CompareMotores<double>("double") + CompareMotores<float>("float");
+    return fallas == 0 ? 0 : 1;
+}
@@ -0,0 +1,43 @@
+# Corre simulacion_mpi con 1 y con 4 rangos desde el mismo estado inicial y revisa:
+# - con revise_trayectoria, que ningún cuadro de la trayectoria binario64 tenga pares de
+#   bolas traslapados: un choque que cruza la frontera entre rangos sin resolverse (o
+#   resuelto dos veces) deja bolas traslapadas aunque N y la energía no cambien;
+# - que cada cuadro reúna cada id exactamente una vez (simulacion_mpi falla si no);
+# - que el número de bolas y la energía de cada cuadro en dominio.dat coincidan (la
+#   columna de desbalance depende del número de rangos y no se compara).
+#
+# Variables: MPIEXEC, NUMPROC_FLAG, PREFLAGS (lista), PROGRAMA, REVISION, DIRECTORIO.
+
+set(ARGUMENTOS --N 3000 --W 80 --H 30 --tf 0.5 --semilla 11 --formato binario64)
+
+foreach(rangos 1 4)
+    file(REMOVE_RECURSE ${DIRECTORIO}/np${rangos})
+    execute_process(COMMAND ${MPIEXEC} ${NUMPROC_FLAG} ${rangos} ${PREFLAGS} ${PROGRAMA}
+                            ${ARGUMENTOS} --salida ${DIRECTORIO}/np${rangos}
+                    RESULT_VARIABLE estado OUTPUT_QUIET)
+    if(NOT estado EQUAL 0)
+        message(FATAL_ERROR "simulacion_mpi con ${rangos} rango(s) terminó con código ${estado}")
+    endif()
+    execute_process(COMMAND ${REVISION} ${DIRECTORIO}/np${rangos}/trayectorias.bin
+                    RESULT_VARIABLE estado OUTPUT_VARIABLE reporte ERROR_VARIABLE traslapes
+                    OUTPUT_STRIP_TRAILING_WHITESPACE)
+    if(NOT estado EQUAL 0)
+        message(FATAL_ERROR "Con ${rangos} rango(s) hay bolas traslapadas:\n${traslapes}${reporte}")
+    endif()
+    message(STATUS "${rangos} rango(s): ${reporte}")
+    file(STRINGS ${DIRECTORIO}/np${rangos}/dominio.dat lineas REGEX "^[^#]")
+    set(columnas_${rangos} "")
+    foreach(linea IN LISTS lineas)
+        string(REGEX REPLACE " [^ ]+$" "" sin_desbalance "${linea}")
+        list(APPEND columnas_${rangos} "${sin_desbalance}")
+    endforeach()
+endforeach()
+
+list(LENGTH columnas_1 cuadros)
+if(cuadros EQUAL 0)
+    message(FATAL_ERROR "dominio.dat no tiene cuadros")
+endif()
+if(NOT columnas_1 STREQUAL columnas_4)
+    message(FATAL_ERROR "N o la energía difieren entre 1 y 4 rangos:\n${columnas_1}\n---\n${columnas_4}")
+endif()
+message(STATUS "${cuadros} cuadros con el mismo N y la misma energía con 1 y 4 rangos")
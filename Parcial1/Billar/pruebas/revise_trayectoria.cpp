@@ -0,0 +1,107 @@
+/**
+ * @file revise_trayectoria.cpp
+ * @brief Cuenta los pares de bolas que se traslapan en cada cuadro de una trayectoria binario64.
+ *
+ * Dos bolas se traslapan si la distancia entre sus centros es menor que 2R (todas tienen
+ * el radio R de la cabecera). Los pares se buscan con una rejilla de celdas de lado 2R.
+ * Si los choques que cruzan la frontera entre rangos no se resuelven (o se resuelven dos
+ * veces), las bolas de esa frontera terminan traslapadas aunque N y la energía coincidan.
+ *
+ * Uso: revise_trayectoria <trayectorias.bin>
+ * Retorna 0 si ningún cuadro tiene traslapes y 1 si alguno los tiene o el archivo no es válido.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+/** @brief Cabecera binaria de la trayectoria (64 bytes, ver Trayectoria.h). */
+struct CabeceraDisco {
+    char magia[8];
+    std::uint32_t version;
+    std::uint32_t bytes_real;
+    std::uint32_t campos;
+    std::uint32_t banderas;
+    std::uint64_t N;
+    double W, H, R, dt_frame;
+};
+static_assert(sizeof(CabeceraDisco) == 64, "La cabecera binaria debe ocupar 64 bytes");
+
+/**
+ * @brief Cuenta los pares traslapados de un cuadro.
+ * @param cuadro Registros (x, y, vx, vy) de las N bolas.
+ * @param N Número de bolas.
+ * @param cab Cabecera (caja y radio).
+ * @return Pares con distancia menor que 2R.
+ */
+std::uint64_t CuentePares(const std::vector<double>& cuadro, std::uint64_t N, const CabeceraDisco& cab) {
+    const double lado = 2.0 * cab.R;
+    const long nx = std::max(1L, static_cast<long>(cab.W / lado));
+    const long ny = std::max(1L, static_cast<long>(cab.H / lado));
+    auto Celda = [&](double v, double L, long n) {
+        return std::clamp(static_cast<long>(v / L * n), 0L, n - 1);
+    };
+    std::vector<std::vector<std::uint64_t>> celdas(nx * ny);
+    for (std::uint64_t i = 0; i < N; ++i)
+        celdas[Celda(cuadro[4 * i + 1], cab.H, ny) * nx + Celda(cuadro[4 * i], cab.W, nx)].push_back(i);
+
+    std::uint64_t pares = 0;
+    for (std::uint64_t i = 0; i < N; ++i) {
+        const double x = cuadro[4 * i], y = cuadro[4 * i + 1];
+        const long cx = Celda(x, cab.W, nx), cy = Celda(y, cab.H, ny);
+        for (long vy = std::max(0L, cy - 1); vy <= std::min(ny - 1, cy + 1); ++vy)
+            for (long vx = std::max(0L, cx - 1); vx <= std::min(nx - 1, cx + 1); ++vx)
+                for (std::uint64_t j : celdas[vy * nx + vx]) {
+                    if (j <= i) continue;
+                    const double dx = cuadro[4 * j] - x, dy = cuadro[4 * j + 1] - y;
+                    if (std::sqrt(dx * dx + dy * dy) < lado) ++pares;
+                }
+    }
+    return pares;
+}
+
+} // namespace
+
+/**
+ * @brief Lee la trayectoria cuadro por cuadro y reporta los traslapes.
+ * @return 0 sin traslapes; 1 con traslapes o si el archivo no es válido.
+ */
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "Uso: " << argv[0] << " <trayectorias.bin>\n";
+        return 1;
+    }
+    std::ifstream f(argv[1], std::ios::binary);
+    CabeceraDisco cab{};
+    if (!f.read(reinterpret_cast<char*>(&cab), sizeof(cab)) || std::memcmp(cab.magia, "BILLARTJ", 8) != 0 ||
+        cab.bytes_real != 8 || cab.campos != 4) {
+        std::cerr << "No es una trayectoria binario64: " << argv[1] << "\n";
+        return 1;
+    }
+
+    std::vector<double> cuadro(4 * cab.N);
+    std::uint64_t cuadros = 0, con_traslapes = 0, maximo = 0;
+    double t = 0.0;
+    while (f.read(reinterpret_cast<char*>(&t), sizeof(t))) {
+        if (!f.read(reinterpret_cast<char*>(cuadro.data()),
+                    static_cast<std::streamsize>(cuadro.size() * sizeof(double)))) {
+            std::cerr << "Cuadro truncado en t = " << t << "\n";
+            return 1;
+        }
+        const std::uint64_t pares = CuentePares(cuadro, cab.N, cab);
+        if (pares > 0) {
+            ++con_traslapes;
+            if (pares > maximo) std::cerr << "t = " << t << ": " << pares << " pares traslapados\n";
+            maximo = std::max(maximo, pares);
+        }
+        ++cuadros;
+    }
+    std::cout << cuadros << " cuadros de " << cab.N << " bolas, " << con_traslapes << " con traslapes\n";
+    return cuadros > 0 && con_traslapes == 0 ? 0 : 1;
+}
@@ -0,0 +1,59 @@
+# comparar_bench.py - Compara resultados de billar_bench (JSON) entre motores o entre versiones
+#
+# Uso:
+#   python3 comparar_bench.py bench.json                 tabla de un archivo
+#   python3 comparar_bench.py base.json nuevo.json       razón nuevo/base por medición
+import json
+import sys
+
+
+def leer(ruta):
+    with open(ruta) as f:
+        datos = json.load(f)
+    mediciones = {(m['prueba'], m['N'], m['fraccion']): m for m in datos['mediciones']}
+    return datos, mediciones
+
+
+def encabezado(datos, ruta):
+    print(f"{ruta}: commit {datos['commit']}, simd {datos['simd']}, hilos {datos['hilos']}"
+          + ("" if datos['kernels_identicos'] else "  (¡núcleos no idénticos!)"))
+
+
+def tabla(ruta):
+    datos, mediciones = leer(ruta)
+    encabezado(datos, ruta)
+    print(f"{'prueba':24s} {'N':>8s} {'frac':>5s} {'ns/bola/paso':>13s} {'pares/paso':>12s} {'asig/paso':>10s}"
+          f" {'fallos caché':>13s}")
+    for (prueba, N, fraccion), m in mediciones.items():
+        fallos, referencias = m.get('fallos_cache_por_paso'), m.get('referencias_cache_por_paso')
+        tasa = f"{100.0 * fallos / referencias:12.1f}%" if fallos is not None and referencias else f"{'-':>13s}"
+        print(f"{prueba:24s} {N:8d} {fraccion:5.2f} {m['ns_por_bola_paso']:13.3f} "
+              f"{m['pares_por_paso']:12.1f} {m['asignaciones_por_paso']:10.2f} {tasa}")
+
+
+def comparar(ruta_base, ruta_nueva):
+    base, med_base = leer(ruta_base)
+    nueva, med_nueva = leer(ruta_nueva)
+    encabezado(base, ruta_base)
+    encabezado(nueva, ruta_nueva)
+    print(f"{'prueba':24s} {'N':>8s} {'frac':>5s} {'base':>10s} {'nuevo':>10s} {'razón':>7s}")
+    for clave in sorted(med_base.keys() & med_nueva.keys(), key=lambda c: (c[1], c[2], c[0])):
+        t0 = med_base[clave]['ns_por_bola_paso']
+        t1 = med_nueva[clave]['ns_por_bola_paso']
+        razon = t1 / t0 if t0 > 0 else float('nan')
+        marca = "  más lento" if razon > 1.10 else ("  más rápido" if razon < 0.90 else "")
+        print(f"{clave[0]:24s} {clave[1]:8d} {clave[2]:5.2f} {t0:10.3f} {t1:10.3f} {razon:7.3f}{marca}")
+
+
+def main():
+    if len(sys.argv) == 2:
+        tabla(sys.argv[1])
+    elif len(sys.argv) == 3:
+        comparar(sys.argv[1], sys.argv[2])
+    else:
+        print("Uso: comparar_bench.py bench.json [nuevo.json]")
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,72 @@
+# escalamiento_mpi.py - Mide la eficiencia de simulacion_mpi al variar el número de rangos
+#
+# Uso:
+#   python3 escalamiento_mpi.py ../build/simulacion_mpi [--rangos 1,2,4] [--N 20000]
+#                               [--W 200] [--H 200] [--tf 1] [--mpirun "mpirun --oversubscribe"]
+#
+# Escalamiento fuerte: N y la caja fijos; eficiencia E(P) = T(1) / (P T(P)).
+# Escalamiento débil: N y el ancho W crecen con P (misma densidad y misma franja por
+# rango); eficiencia E(P) = T(1) / T(P). Las corridas no escriben trayectorias.
+import argparse
+import json
+import os
+import shlex
+import subprocess
+import sys
+import tempfile
+
+
+def corra(programa, mpirun, rangos, N, W, H, tf, salida):
+    orden = shlex.split(mpirun) + ['-np', str(rangos), programa,
+                                   '--N', str(N), '--W', str(W), '--H', str(H), '--tf', str(tf),
+                                   '--formato', 'ninguno', '--semilla', '1', '--salida', salida]
+    subprocess.run(orden, check=True, stdout=subprocess.DEVNULL)
+    with open(os.path.join(salida, 'resumen_mpi.json')) as f:
+        return json.load(f)
+
+
+def serie(nombre, programa, args, debil):
+    print(f"\nEscalamiento {nombre}")
+    print(f"{'rangos':>6s} {'N':>8s} {'W':>8s} {'segundos':>10s} {'comunic.':>10s} {'desbal.':>8s} {'eficiencia':>11s}")
+    filas = []
+    t1 = None
+    for P in args.rangos:
+        N = args.N * P if debil else args.N
+        W = args.W * P if debil else args.W
+        with tempfile.TemporaryDirectory() as salida:
+            r = corra(programa, args.mpirun, P, N, W, args.H, args.tf, salida)
+        t = r['segundos']
+        if t1 is None:
+            t1 = t * args.rangos[0] if not debil else t
+        eficiencia = t1 / t if debil else t1 / (P * t)
+        print(f"{P:6d} {N:8d} {W:8g} {t:10.3f} {r['segundos_comunicacion']:10.3f} {r['desbalance']:8.3f} {eficiencia:11.3f}")
+        filas.append({'rangos': P, 'N': N, 'W': W, 'segundos': t,
+                      'segundos_comunicacion': r['segundos_comunicacion'],
+                      'desbalance': r['desbalance'], 'eficiencia': eficiencia})
+    return filas
+
+
+def main():
+    p = argparse.ArgumentParser(description="Escalamiento fuerte y débil de simulacion_mpi")
+    p.add_argument('programa')
+    p.add_argument('--rangos', default='1,2,4', type=lambda s: [int(v) for v in s.split(',')])
+    p.add_argument('--N', default=20000, type=int, help="bolas (por rango en el escalamiento débil)")
+    p.add_argument('--W', default=200.0, type=float, help="ancho (por rango en el escalamiento débil)")
+    p.add_argument('--H', default=200.0, type=float)
+    p.add_argument('--tf', default=1.0, type=float)
+    p.add_argument('--mpirun', default='mpirun')
+    p.add_argument('--json', default='escalamiento_mpi.json', help="archivo con las dos series")
+    args = p.parse_args()
+    if args.rangos[0] != 1:
+        print("Aviso: la primera corrida no es de un rango; la eficiencia se mide respecto a ella.",
+              file=sys.stderr)
+
+    resultado = {'fuerte': serie('fuerte', args.programa, args, False),
+                 'debil': serie('débil', args.programa, args, True)}
+    with open(args.json, 'w') as f:
+        json.dump(resultado, f, indent=2)
+    print(f"\nResultados en {args.json}")
+
+
+if __name__ == '__main__':
+    main()
@@ -3,96 +3,107 @@ import matplotlib.pyplot as plt
 import matplotlib.animation as animation
 import numpy as np
 import os
+import sys
 from matplotlib import gridspec
 
 def main():
-    # Leer parámetros del archivo
-    W, H, R_BOLA = leer_parametros()
+    # Ruta opcional del archivo de trayectorias (texto .dat, binario .bin o columnar .bcol).
+    # Con --sin-gif se omite la animación (la simulación ya la dibujó en animacion.gif).
+    sin_gif = '--sin-gif' in sys.argv
+    argumentos = [a for a in sys.argv[1:] if a != '--sin-gif']
+    ruta = argumentos[0] if argumentos else '../results/trayectorias.dat'
+
+    # Leer parámetros y trayectorias
+    if ruta.endswith('.bin'):
+        W, H, R_BOLA, tiempos, datos = leer_binario(ruta)
+    elif ruta.endswith('.bcol'):
+        W, H, R_BOLA, tiempos, datos = leer_columnar(ruta)
+    else:
+        W, H, R_BOLA = leer_parametros(ruta)
+        tiempos, datos = leer_datos_trayectorias(ruta)
     
     print("Parámetros leídos del archivo:")
     print(f"  Ancho de caja (W): {W}")
     print(f"  Alto de caja (H): {H}")
     print(f"  Radio de partículas: {R_BOLA}")
     
-    # Leer datos de trayectorias
-    tiempos, datos = leer_datos_trayectorias()
-    
     N = datos.shape[1] // 4  # Número de partículas (cada una tiene x,y,vx,vy)
     total_frames = len(tiempos)
     
     print(f"Número de partículas detectadas: {N}")
     print(f"Total de frames: {total_frames}")
     
-    # =============================================
-    # 1. GENERAR GIF ANIMADO
-    # =============================================
-    print("\n" + "="*50)
-    print("GENERANDO GIF ANIMADO")
-    print("="*50)
-    
-    # Configurar muestreo si hay muchos frames
-    muestreo_gif = 1
-    if total_frames > 500:
-        muestreo_gif = total_frames // 300
-        print(f"Muestreando: usando 1 de cada {muestreo_gif} frames")
-    
-    frames_a_procesar = total_frames // muestreo_gif
-    print(f"Frames a procesar: {frames_a_procesar}")
-    
-    # Crear figura y ejes para GIF
-    fig_gif, ax_gif = plt.subplots(figsize=(8, 6))
-    
-    # Configurar los límites y aspecto
-    ax_gif.set_xlim(0, W)
-    ax_gif.set_ylim(0, H)
-    ax_gif.set_aspect('equal')
-    ax_gif.grid(True)
-    ax_gif.set_xlabel('x')
-    ax_gif.set_ylabel('y')
-    
-    # Dibujar el borde de la caja
-    rect = plt.Rectangle((0, 0), W, H, fill=False, edgecolor='black', linewidth=2)
-    ax_gif.add_patch(rect)
-    
-    # Inicializar puntos para las partículas (todas del mismo color y forma)
-    puntos = ax_gif.plot([], [], 'bo', markersize=6)[0]  # 'bo': puntos azules
-    
-    def animar(frame):
-        # Calcular el índice real considerando el muestreo
-        idx = frame * muestreo_gif
-        if idx >= total_frames:
-            idx = total_frames - 1
+    if not sin_gif:
+        # =============================================
+        # 1. GENERAR GIF ANIMADO
+        # =============================================
+        print("\n" + "="*50)
+        print("GENERANDO GIF ANIMADO")
+        print("="*50)
+    
+        # Configurar muestreo si hay muchos frames
+        muestreo_gif = 1
+        if total_frames > 500:
+            muestreo_gif = total_frames // 300
+            print(f"Muestreando: usando 1 de cada {muestreo_gif} frames")
+    
+        frames_a_procesar = total_frames // muestreo_gif
+        print(f"Frames a procesar: {frames_a_procesar}")
+    
+        # Crear figura y ejes para GIF
+        fig_gif, ax_gif = plt.subplots(figsize=(8, 6))
+    
+        # Configurar los límites y aspecto
+        ax_gif.set_xlim(0, W)
+        ax_gif.set_ylim(0, H)
+        ax_gif.set_aspect('equal')
+        ax_gif.grid(True)
+        ax_gif.set_xlabel('x')
+        ax_gif.set_ylabel('y')
+    
+        # Dibujar el borde de la caja
+        rect = plt.Rectangle((0, 0), W, H, fill=False, edgecolor='black', linewidth=2)
+        ax_gif.add_patch(rect)
+    
+        # Inicializar puntos para las partículas (todas del mismo color y forma)
+        puntos = ax_gif.plot([], [], 'bo', markersize=6)[0]  # 'bo': puntos azules
+    
+        def animar(frame):
+            # Calcular el índice real considerando el muestreo
+            idx = frame * muestreo_gif
+            if idx >= total_frames:
+                idx = total_frames - 1
         
-        # Obtener datos para este frame
-        frame_data = datos[idx]
+            # Obtener datos para este frame
+            frame_data = datos[idx]
         
-        # Separar coordenadas x e y de todas las partículas
-        x_coords = frame_data[0::4]  # x0, x1, x2, ... (cada 4 columnas)
-        y_coords = frame_data[1::4]  # y0, y1, y2, ... (cada 4 columnas, desplazado 1)
+            # Separar coordenadas x e y de todas las partículas
+            x_coords = frame_data[0::4]  # x0, x1, x2, ... (cada 4 columnas)
+            y_coords = frame_data[1::4]  # y0, y1, y2, ... (cada 4 columnas, desplazado 1)
         
-        # Actualizar los puntos
-        puntos.set_data(x_coords, y_coords)
+            # Actualizar los puntos
+            puntos.set_data(x_coords, y_coords)
         
-        # Actualizar título
-        ax_gif.set_title(f'Tiempo: {tiempos[idx]:.2f} s - Frame: {frame+1}/{frames_a_procesar}')
+            # Actualizar título
+            ax_gif.set_title(f'Tiempo: {tiempos[idx]:.2f} s - Frame: {frame+1}/{frames_a_procesar}')
         
-        return puntos,
-    
-    # Crear la animación
-    anim = animation.FuncAnimation(
-        fig_gif, animar, frames=frames_a_procesar,
-        interval=50, blit=True, repeat=True
-    )
+            return puntos,
     
-    # Guardar el GIF
-    output_gif_path = '../results/animacion_billar_python.gif'
-    anim.save(output_gif_path, writer='pillow', fps=20)
+        # Crear la animación
+        anim = animation.FuncAnimation(
+            fig_gif, animar, frames=frames_a_procesar,
+            interval=50, blit=True, repeat=True
+        )
     
-    print(f"✓ GIF guardado en: {output_gif_path}")
+        # Guardar el GIF
+        output_gif_path = '../results/animacion_billar_python.gif'
+        anim.save(output_gif_path, writer='pillow', fps=20)
     
-    # Cerrar la figura del GIF para liberar memoria
-    plt.close(fig_gif)
+        print(f"✓ GIF guardado en: {output_gif_path}")
     
+        # Cerrar la figura del GIF para liberar memoria
+        plt.close(fig_gif)
+
     # =============================================
     # 2. GENERAR DIAGRAMA DE TRAYECTORIAS (ARCHIVO SEPARADO)
     # =============================================
@@ -215,10 +226,8 @@ def main():
     print(f"✓ Velocidad promedio: {velocidad_promedio:.4f}")
     print("¡Todos los gráficos han sido generados exitosamente!")
 
-def leer_parametros():
-    """Leer parámetros W, H y R_BOLA del archivo de datos"""
-    file_path = '../results/trayectorias.dat'
-    
+def leer_parametros(file_path='../results/trayectorias.dat'):
+    """Leer parámetros W, H y R_BOLA del archivo de datos"""    
     W, H, R_BOLA = 1, 1, 0.2  # Valores por defecto
     
     try:
@@ -242,10 +251,8 @@ def leer_parametros():
     
     return W, H, R_BOLA
 
-def leer_datos_trayectorias():
-    """Leer los datos de trayectorias del archivo"""
-    file_path = '../results/trayectorias.dat'
-    
+def leer_datos_trayectorias(file_path='../results/trayectorias.dat'):
+    """Leer los datos de trayectorias del archivo"""    
     tiempos = []
     datos = []
     
@@ -271,5 +278,79 @@ def leer_datos_trayectorias():
     
     return np.array(tiempos), np.array(datos)
 
+def leer_binario(file_path):
+    """Leer una trayectoria en formato binario (cabecera de 64 bytes + cuadros fijos)"""
+    cabecera = np.dtype([('magia', 'S8'), ('version', '<u4'), ('bytes_real', '<u4'),
+                         ('campos', '<u4'), ('banderas', '<u4'), ('N', '<u8'),
+                         ('W', '<f8'), ('H', '<f8'), ('R', '<f8'), ('dt_frame', '<f8')])
+    try:
+        cab = np.fromfile(file_path, dtype=cabecera, count=1)[0]
+        if cab['magia'] != b'BILLARTJ':
+            raise ValueError("el archivo no es una trayectoria binaria del billar")
+        real = '<f4' if cab['bytes_real'] == 4 else '<f8'
+        N, campos = int(cab['N']), int(cab['campos'])
+        cuadro = np.dtype([('t', '<f8'), ('bolas', real, (N * campos,))])
+        cuadros = np.fromfile(file_path, dtype=cuadro, offset=cabecera.itemsize)
+    except FileNotFoundError:
+        print(f"Error: No se encontró el archivo {file_path}")
+        exit(1)
+    except Exception as e:
+        print(f"Error leyendo trayectoria binaria: {e}")
+        exit(1)
+
+    return (float(cab['W']), float(cab['H']), float(cab['R']),
+            cuadros['t'], cuadros['bolas'].astype(np.float64))
+
+def abrir_columnar(file_path):
+    """Abrir un archivo columnar: retorna cabecera, índice de bloques y el archivo mapeado en memoria"""
+    cabecera = np.dtype([('magia', 'S8'), ('version', '<u4'), ('cuadros_por_bloque', '<u4'),
+                         ('N', '<u8'), ('W', '<f8'), ('H', '<f8'), ('R', '<f8'),
+                         ('dt_frame', '<f8'), ('reservado', '<u8')])
+    cola = np.dtype([('num_bloques', '<u8'), ('num_cuadros', '<u8'),
+                     ('desplazamiento_indice', '<u8'), ('magia', 'S8')])
+    bloque = np.dtype([('primer_cuadro', '<u8'), ('cuadros', '<u8'), ('desplazamiento', '<u8')])
+
+    mapa = np.memmap(file_path, dtype=np.uint8, mode='r')
+    cab = mapa[:cabecera.itemsize].view(cabecera)[0]
+    fin = mapa[-cola.itemsize:].view(cola)[0]
+    if cab['magia'] != b'BILLARCL' or fin['magia'] != b'BCOLINDX':
+        raise ValueError("el archivo no es una trayectoria columnar completa del billar")
+    inicio = int(fin['desplazamiento_indice'])
+    indice = mapa[inicio:inicio + int(fin['num_bloques']) * bloque.itemsize].view(bloque)
+    return cab, indice, mapa
+
+def serie_columnar(file_path, i, campo):
+    """Serie de tiempo de la bola i; campo = 0 (x), 1 (y), 2 (vx) o 3 (vy). Una lectura por bloque."""
+    cab, indice, mapa = abrir_columnar(file_path)
+    N = int(cab['N'])
+    partes = []
+    for b in indice:
+        k, d = int(b['cuadros']), int(b['desplazamiento'])
+        p = d + 8 * (k + (campo * N + i) * k)
+        partes.append(mapa[p:p + 8 * k].view('<f8'))
+    return np.concatenate(partes)
+
+def leer_columnar(file_path):
+    """Leer una trayectoria columnar completa con la misma forma que el formato de texto"""
+    try:
+        cab, indice, mapa = abrir_columnar(file_path)
+        N = int(cab['N'])
+        tiempos, datos = [], []
+        for b in indice:
+            k, d = int(b['cuadros']), int(b['desplazamiento'])
+            valores = mapa[d:d + 8 * k * (1 + 4 * N)].view('<f8')
+            tiempos.append(valores[:k])
+            # (campo, bola, cuadro) -> (cuadro, bola, campo) = x0, y0, vx0, vy0, x1, ...
+            datos.append(valores[k:].reshape(4, N, k).transpose(2, 1, 0).reshape(k, 4 * N))
+    except FileNotFoundError:
+        print(f"Error: No se encontró el archivo {file_path}")
+        exit(1)
+    except Exception as e:
+        print(f"Error leyendo trayectoria columnar: {e}")
+        exit(1)
+
+    return (float(cab['W']), float(cab['H']), float(cab['R']),
+            np.concatenate(tiempos), np.concatenate(datos))
+
 if __name__ == "__main__":
     main()
\ No newline at end of file
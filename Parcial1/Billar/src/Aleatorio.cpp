@@ -0,0 +1,72 @@
+/**
+ * @file Aleatorio.cpp
+ * @brief Implementación de la siembra y los saltos del generador xoshiro256**.
+ */
+
+#include "Aleatorio.h"
+#include <stdexcept>
+
+/**
+ * @brief Llena el estado con cuatro salidas de SplitMix64.
+ * @param semilla Semilla.
+ */
+void Xoshiro256::Siembre(std::uint64_t semilla) {
+    std::uint64_t z = semilla;
+    for (std::uint64_t& palabra : s) {
+        z += 0x9E3779B97F4A7C15ULL;
+        std::uint64_t x = z;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        palabra = x ^ (x >> 31);
+    }
+}
+
+/**
+ * @brief Multiplica el estado por el polinomio de salto en GF(2).
+ * @param polinomio Coeficientes del salto.
+ */
+void Xoshiro256::Aplique(const std::uint64_t polinomio[4]) {
+    std::uint64_t t[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; ++i) {
+        for (int b = 0; b < 64; ++b) {
+            if (polinomio[i] & (std::uint64_t{1} << b)) {
+                t[0] ^= s[0];
+                t[1] ^= s[1];
+                t[2] ^= s[2];
+                t[3] ^= s[3];
+            }
+            (*this)();
+        }
+    }
+    for (int k = 0; k < 4; ++k)
+        s[k] = t[k];
+}
+
+/**
+ * @brief Salto de 2^128 pasos (polinomio de los autores).
+ */
+void Xoshiro256::Salte() {
+    static const std::uint64_t SALTO[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                           0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+    Aplique(SALTO);
+}
+
+/**
+ * @brief Salto de 2^192 pasos (polinomio de los autores).
+ */
+void Xoshiro256::SalteLargo() {
+    static const std::uint64_t SALTO_LARGO[4] = {0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+                                                 0x77710069854ee241ULL, 0x39109bb02acbe635ULL};
+    Aplique(SALTO_LARGO);
+}
+
+/**
+ * @brief Reemplaza el estado.
+ * @param estado Cuatro palabras.
+ */
+void Xoshiro256::DefinaEstado(const std::uint64_t estado[4]) {
+    if ((estado[0] | estado[1] | estado[2] | estado[3]) == 0)
+        throw std::invalid_argument("El estado de xoshiro256** no puede ser todo cero.");
+    for (int k = 0; k < 4; ++k)
+        s[k] = estado[k];
+}
@@ -0,0 +1,355 @@
+/**
+ * @file Animacion.cpp
+ * @brief Implementación del lienzo, del codificador GIF y del escritor de animaciones.
+ */
+
+#include "Animacion.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// ==========================================================
+//                         LIENZO
+// ==========================================================
+
+/**
+ * @brief Crea un lienzo relleno con el fondo.
+ * @param ancho_,alto_ Dimensiones en píxeles.
+ * @throws std::invalid_argument Si alguna dimensión no es positiva.
+ */
+Lienzo::Lienzo(int ancho_, int alto_) : ancho(ancho_), alto(alto_) {
+    if (ancho <= 0 || alto <= 0)
+        throw std::invalid_argument("Las dimensiones del lienzo deben ser positivas.");
+    indices.assign(static_cast<std::size_t>(ancho) * alto, FONDO);
+}
+
+/**
+ * @brief Paleta fija: blanco, negro y una escala de rapidez de azul a rojo pasando por verde.
+ *
+ * Las entradas sobrantes quedan en blanco.
+ */
+const std::array<ColorRGB, Lienzo::COLORES>& Lienzo::Paleta() {
+    static const std::array<ColorRGB, COLORES> paleta = [] {
+        std::array<ColorRGB, COLORES> p;
+        p.fill({255, 255, 255});
+        p[BORDE] = {0, 0, 0};
+        for (int k = 0; k < TONOS; ++k) {
+            const double s = static_cast<double>(k) / (TONOS - 1);
+            const double rojo = std::clamp(2.0 * s - 0.5, 0.0, 1.0);
+            const double verde = 1.0 - std::abs(2.0 * s - 1.0);
+            const double azul = std::clamp(1.5 - 2.0 * s, 0.0, 1.0);
+            p[RAPIDEZ + k] = {static_cast<std::uint8_t>(std::lround(230.0 * rojo)),
+                              static_cast<std::uint8_t>(std::lround(180.0 * verde)),
+                              static_cast<std::uint8_t>(std::lround(230.0 * azul))};
+        }
+        return p;
+    }();
+    return paleta;
+}
+
+/** @brief Llena todo el lienzo con un color. */
+void Lienzo::Limpie(std::uint8_t color) {
+    std::fill(indices.begin(), indices.end(), color);
+}
+
+/**
+ * @brief Dibuja el contorno de un rectángulo, recortado al lienzo.
+ * @param x0,y0 Esquina superior izquierda.
+ * @param x1,y1 Esquina inferior derecha (exclusiva).
+ * @param grosor Grosor en píxeles.
+ * @param color Índice de paleta.
+ */
+void Lienzo::Contorno(int x0, int y0, int x1, int y1, int grosor, std::uint8_t color) {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, ancho);
+    y1 = std::min(y1, alto);
+    for (int py = y0; py < y1; ++py) {
+        std::uint8_t* fila = &indices[static_cast<std::size_t>(py) * ancho];
+        if (py < y0 + grosor || py >= y1 - grosor) {
+            std::fill(fila + x0, fila + std::max(x0, x1), color);
+        } else {
+            std::fill(fila + x0, fila + std::min(x0 + grosor, x1), color);
+            std::fill(fila + std::max(x1 - grosor, x0), fila + x1, color);
+        }
+    }
+}
+
+/**
+ * @brief Rellena los píxeles cuyo centro está a menos de r del centro del disco.
+ * @param cx,cy Centro en píxeles.
+ * @param r Radio en píxeles.
+ * @param color Índice de paleta.
+ */
+void Lienzo::Disco(double cx, double cy, double r, std::uint8_t color) {
+    if (r < 1.0) {
+        const int px = static_cast<int>(std::floor(cx));
+        const int py = static_cast<int>(std::floor(cy));
+        if (px >= 0 && px < ancho && py >= 0 && py < alto)
+            indices[static_cast<std::size_t>(py) * ancho + px] = color;
+        return;
+    }
+    const int y_min = std::max(0, static_cast<int>(std::floor(cy - r)));
+    const int y_max = std::min(alto - 1, static_cast<int>(std::ceil(cy + r)));
+    const double r2 = r * r;
+    for (int py = y_min; py <= y_max; ++py) {
+        const double dy = py + 0.5 - cy;
+        const double resto = r2 - dy * dy;
+        if (resto < 0.0) continue;
+        // Columnas cuyo centro cumple (px + 0.5 - cx)² <= resto.
+        const double media = std::sqrt(resto);
+        const int x_min = std::max(0, static_cast<int>(std::ceil(cx - media - 0.5)));
+        const int x_max = std::min(ancho - 1, static_cast<int>(std::floor(cx + media - 0.5)));
+        if (x_min > x_max) continue;
+        std::uint8_t* fila = &indices[static_cast<std::size_t>(py) * ancho];
+        std::fill(fila + x_min, fila + x_max + 1, color);
+    }
+}
+
+/**
+ * @brief Traduce cada índice a su color de la paleta.
+ * @param rgb Salida: 3 bytes por píxel.
+ */
+void Lienzo::ComoRGB(std::vector<std::uint8_t>& rgb) const {
+    const auto& paleta = Paleta();
+    rgb.resize(indices.size() * 3);
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        const ColorRGB& c = paleta[indices[i]];
+        rgb[3 * i] = c[0];
+        rgb[3 * i + 1] = c[1];
+        rgb[3 * i + 2] = c[2];
+    }
+}
+
+// ==========================================================
+//                      CODIFICADOR GIF
+// ==========================================================
+
+namespace {
+
+/** @brief Bits de los índices de color (log2 de Lienzo::COLORES), también el tamaño mínimo de código LZW. */
+constexpr int BITS_COLOR = 5;
+static_assert((1 << BITS_COLOR) == Lienzo::COLORES, "La paleta del GIF debe tener 2^BITS_COLOR colores.");
+
+/** @brief Código más alto que admite LZW en GIF (12 bits). */
+constexpr std::uint32_t CODIGO_MAXIMO = 4095;
+
+/** @brief Escribe un entero de 16 bits little-endian. */
+void EscribaU16(std::ofstream& f, int v) {
+    const char b[2] = {static_cast<char>(v & 0xFF), static_cast<char>((v >> 8) & 0xFF)};
+    f.write(b, 2);
+}
+
+} // namespace
+
+/**
+ * @brief Abre el archivo y escribe cabecera, paleta global y extensión NETSCAPE de repetición.
+ * @param ruta Ruta del archivo.
+ * @param ancho_,alto_ Dimensiones en píxeles.
+ * @param retardo_ Centésimas de segundo entre cuadros.
+ * @throws std::invalid_argument Si las dimensiones no caben en 16 bits.
+ * @throws std::runtime_error Si no se puede abrir el archivo.
+ */
+CodificadorGif::CodificadorGif(const std::string& ruta, int ancho_, int alto_, int retardo_)
+    : ancho(ancho_), alto(alto_), retardo(retardo_) {
+    if (ancho <= 0 || alto <= 0 || ancho > 65535 || alto > 65535)
+        throw std::invalid_argument("Las dimensiones del GIF deben estar entre 1 y 65535 píxeles.");
+    f.open(ruta, std::ios::binary);
+    if (!f)
+        throw std::runtime_error("No se pudo abrir el archivo de animación: " + ruta);
+
+    f.write("GIF89a", 6);
+    EscribaU16(f, ancho);
+    EscribaU16(f, alto);
+    // Paleta global presente, 8 bits por canal, 2^BITS_COLOR entradas.
+    f.put(static_cast<char>(0x80 | 0x70 | (BITS_COLOR - 1)));
+    f.put(0); // Fondo.
+    f.put(0); // Proporción de píxel.
+    for (const ColorRGB& c : Lienzo::Paleta())
+        f.write(reinterpret_cast<const char*>(c.data()), 3);
+
+    // Repetir indefinidamente.
+    f.write("\x21\xFF\x0BNETSCAPE2.0\x03\x01\x00\x00\x00", 19);
+    hijos.assign((CODIGO_MAXIMO + 1) * Lienzo::COLORES, 0);
+}
+
+/**
+ * @brief Agrega un código de `bits` bits al flujo comprimido (primero los bits bajos).
+ */
+void CodificadorGif::EscribaCodigo(std::uint32_t codigo, int bits) {
+    acumulado |= codigo << bits_acumulados;
+    bits_acumulados += bits;
+    while (bits_acumulados >= 8) {
+        datos.push_back(static_cast<std::uint8_t>(acumulado & 0xFF));
+        acumulado >>= 8;
+        bits_acumulados -= 8;
+    }
+}
+
+/**
+ * @brief Escribe la extensión de control (retardo), el descriptor de imagen y los datos LZW.
+ *
+ * El diccionario es un árbol: hijos[código * COLORES + color] es el código de la
+ * cadena `código` seguida de `color` (0 si no existe). Cuando se llena se emite
+ * un código de limpieza y se empieza de nuevo.
+ *
+ * @param lienzo Lienzo del cuadro.
+ * @throws std::invalid_argument Si las dimensiones no coinciden con las del GIF.
+ */
+void CodificadorGif::Agregue(const Lienzo& lienzo) {
+    if (lienzo.GetAncho() != ancho || lienzo.GetAlto() != alto)
+        throw std::invalid_argument("El lienzo no tiene las dimensiones del GIF.");
+
+    // Extensión de control: sin transparencia, "no descartar", retardo en centésimas.
+    f.write("\x21\xF9\x04\x04", 4);
+    EscribaU16(f, retardo);
+    f.put(0);
+    f.put(0);
+    // Descriptor de imagen: cuadro completo, sin paleta local.
+    f.put(0x2C);
+    EscribaU16(f, 0);
+    EscribaU16(f, 0);
+    EscribaU16(f, ancho);
+    EscribaU16(f, alto);
+    f.put(0);
+    f.put(static_cast<char>(BITS_COLOR));
+
+    const std::uint32_t limpieza = 1u << BITS_COLOR;
+    const std::uint32_t fin = limpieza + 1;
+    datos.clear();
+    acumulado = 0;
+    bits_acumulados = 0;
+    std::fill(hijos.begin(), hijos.end(), 0);
+    int bits = BITS_COLOR + 1;
+    std::uint32_t maximo = fin; // Último código asignado.
+    EscribaCodigo(limpieza, bits);
+
+    const std::vector<std::uint8_t>& px = lienzo.GetIndices();
+    std::uint32_t actual = px[0];
+    for (std::size_t i = 1; i < px.size(); ++i) {
+        const std::uint8_t color = px[i];
+        const std::uint16_t siguiente = hijos[actual * Lienzo::COLORES + color];
+        if (siguiente != 0) {
+            actual = siguiente;
+            continue;
+        }
+        EscribaCodigo(actual, bits);
+        hijos[actual * Lienzo::COLORES + color] = static_cast<std::uint16_t>(++maximo);
+        if (maximo >= (1u << bits))
+            ++bits;
+        if (maximo == CODIGO_MAXIMO) {
+            EscribaCodigo(limpieza, bits);
+            std::fill(hijos.begin(), hijos.end(), 0);
+            bits = BITS_COLOR + 1;
+            maximo = fin;
+        }
+        actual = color;
+    }
+    EscribaCodigo(actual, bits);
+    EscribaCodigo(fin, bits);
+    if (bits_acumulados > 0)
+        datos.push_back(static_cast<std::uint8_t>(acumulado & 0xFF));
+
+    // Subbloques de hasta 255 bytes y un bloque vacío al final.
+    for (std::size_t k = 0; k < datos.size(); k += 255) {
+        const std::size_t n = std::min<std::size_t>(255, datos.size() - k);
+        f.put(static_cast<char>(n));
+        f.write(reinterpret_cast<const char*>(&datos[k]), static_cast<std::streamsize>(n));
+    }
+    f.put(0);
+    if (!f)
+        throw std::runtime_error("Error al escribir el GIF.");
+}
+
+/** @brief Escribe el terminador del GIF y cierra el archivo. */
+void CodificadorGif::Cierre() {
+    if (!f.is_open()) return;
+    f.put(0x3B);
+    f.close();
+}
+
+// ==========================================================
+//                   ESCRITOR DE ANIMACIONES
+// ==========================================================
+
+namespace {
+
+/** @brief Grosor del borde de la caja en píxeles. */
+constexpr int MARGEN = 2;
+
+/** @brief Alto del lienzo para una caja de W x H dibujada con `ancho` píxeles de ancho. */
+int AltoLienzo(const CabeceraTrayectoria& cab, int ancho) {
+    if (!(cab.W > 0.0 && cab.H > 0.0))
+        throw std::invalid_argument("La caja de la animación debe tener ancho y alto positivos.");
+    const double escala = (ancho - 2 * MARGEN) / cab.W;
+    return std::max(2 * MARGEN + 1, static_cast<int>(std::lround(cab.H * escala)) + 2 * MARGEN);
+}
+
+} // namespace
+
+/**
+ * @brief Prepara el lienzo y abre el GIF o el archivo PPM.
+ * @param ruta Ruta del archivo.
+ * @param cab_ Parámetros de la corrida.
+ * @param formato "gif" o "ppm".
+ * @param ancho Ancho en píxeles.
+ * @param muestreo_ Se dibuja uno de cada `muestreo_` cuadros.
+ * @param v_escala_ Rapidez del tono más rojo.
+ * @throws std::invalid_argument Si el formato no existe o la caja no tiene área.
+ * @throws std::runtime_error Si no se puede abrir el archivo.
+ */
+EscritorAnimacion::EscritorAnimacion(const std::string& ruta, const CabeceraTrayectoria& cab_,
+                                     const std::string& formato, int ancho, int muestreo_, double v_escala_)
+    : lienzo(ancho, AltoLienzo(cab_, ancho)), cab(cab_), escala((ancho - 2 * MARGEN) / cab_.W),
+      margen(MARGEN), muestreo(std::max(1, muestreo_)), v_escala(v_escala_ > 0.0 ? v_escala_ : 1.0) {
+    if (formato == "gif") {
+        gif = std::make_unique<CodificadorGif>(ruta, lienzo.GetAncho(), lienzo.GetAlto());
+    } else if (formato == "ppm") {
+        ppm.open(ruta, std::ios::binary);
+        if (!ppm)
+            throw std::runtime_error("No se pudo abrir el archivo de animación: " + ruta);
+    } else {
+        throw std::invalid_argument("Animación no válida. Elija 'gif' o 'ppm'.");
+    }
+}
+
+/**
+ * @brief Dibuja la caja y las bolas; el color de cada bola depende de su rapidez.
+ * @param c Cuadro.
+ */
+void EscritorAnimacion::Dibuje(const Cuadro& c) {
+    lienzo.Limpie(Lienzo::FONDO);
+    const double r = cab.R * escala;
+    const double alto_caja = cab.H * escala;
+    for (std::size_t i = 0; i < c.Tamano(); ++i) {
+        const double v = std::sqrt(c.vx[i] * c.vx[i] + c.vy[i] * c.vy[i]);
+        const int tono = std::min(Lienzo::TONOS - 1, static_cast<int>(Lienzo::TONOS * v / v_escala));
+        lienzo.Disco(margen + c.x[i] * escala, margen + alto_caja - c.y[i] * escala, r,
+                     static_cast<std::uint8_t>(Lienzo::RAPIDEZ + tono));
+    }
+    lienzo.Contorno(0, 0, lienzo.GetAncho(), lienzo.GetAlto(), margen, Lienzo::BORDE);
+}
+
+/**
+ * @brief Dibuja el cuadro (si le toca según el muestreo) y lo agrega al archivo.
+ * @param c Cuadro.
+ */
+void EscritorAnimacion::Escriba(const Cuadro& c) {
+    if (recibidos++ % muestreo != 0) return;
+    Dibuje(c);
+    if (gif) {
+        gif->Agregue(lienzo);
+    } else {
+        lienzo.ComoRGB(rgb);
+        ppm << "P6\n" << lienzo.GetAncho() << ' ' << lienzo.GetAlto() << "\n255\n";
+        ppm.write(reinterpret_cast<const char*>(rgb.data()), static_cast<std::streamsize>(rgb.size()));
+        if (!ppm)
+            throw std::runtime_error("Error al escribir el video PPM.");
+    }
+}
+
+/** @brief Termina el GIF o cierra el archivo PPM. */
+void EscritorAnimacion::Cierre() {
+    if (gif) gif->Cierre();
+    if (ppm.is_open()) ppm.close();
+}
@@ -1,25 +1,23 @@
 /**
  * @file Bola.cpp
  * @brief Implementación de los métodos de la clase Bola.
- * 
- * Contiene la lógica para el movimiento de las bolas, 
+ *
+ * Contiene la lógica para el movimiento de las bolas,
  * las colisiones con las paredes y los choques elásticos entre bolas.
+ * Todos los métodos leen y escriben directamente en los arreglos de Particulas.
+ * Se instancian para double y float al final del archivo.
  */
 
 #include "Bola.h"
 #include <cmath>
-
-/**
- * @brief Constructor por defecto.
- * 
- * Inicializa la bola en el origen con velocidad cero, 
- * masa unitaria y radio 0.1.
- */
-Bola::Bola() : x(0), y(0), vx(0), vy(0), m(1.0), r(0.1) {}
+#include <algorithm>
+#include <limits>
 
 /**
  * @brief Inicializa los parámetros físicos de la bola.
- * 
+ *
+ * También precalcula la inversa de la masa que usan los choques.
+ *
  * @param x0 Posición inicial en x.
  * @param y0 Posición inicial en y.
  * @param vx0 Velocidad inicial en x.
@@ -27,38 +25,46 @@ Bola::Bola() : x(0), y(0), vx(0), vy(0), m(1.0), r(0.1) {}
  * @param m0 Masa.
  * @param r0 Radio.
  */
-void Bola::Inicie(double x0, double y0, double vx0, double vy0, double m0, double r0) {
-    x = x0; 
-    y = y0;
-    vx = vx0; 
-    vy = vy0;
-    m = m0; 
-    r = r0;
+template <class Real>
+void BolaT<Real>::Inicie(double x0, double y0, double vx0, double vy0, double m0, double r0) {
+    P->x[i] = static_cast<Real>(x0);
+    P->y[i] = static_cast<Real>(y0);
+    P->vx[i] = static_cast<Real>(vx0);
+    P->vy[i] = static_cast<Real>(vy0);
+    P->m[i] = static_cast<Real>(m0);
+    P->inv_m[i] = static_cast<Real>(1.0 / m0);
+    P->r[i] = static_cast<Real>(r0);
 }
 
 /**
  * @brief Avanza la posición de la bola según su velocidad.
- * 
+ *
  * Este método no considera colisiones; simplemente actualiza
  * la posición usando el paso de tiempo `dt`.
- * 
+ *
  * @param dt Paso de tiempo.
  */
-void Bola::Muevase(double dt) {
-    x += vx * dt;
-    y += vy * dt;
+template <class Real>
+void BolaT<Real>::Muevase(double dt) {
+    const Real h = static_cast<Real>(dt);
+    P->x[i] += P->vx[i] * h;
+    P->y[i] += P->vy[i] * h;
 }
 
 /**
  * @brief Resuelve colisiones simples con las paredes de la caja.
- * 
+ *
  * Si la bola toca una pared y se mueve hacia ella, su velocidad
  * se invierte. Este método no corrige la posición y puede causar
  * “pegado” si el paso de tiempo es grande.
- * 
+ *
  * @param C Caja con la que colisiona.
  */
-void Bola::ResuelvaColisionParedesSimple(const Caja& C) {
+template <class Real>
+void BolaT<Real>::ResuelvaColisionParedesSimple(const Caja& C) {
+    const Real x = P->x[i], y = P->y[i], r = P->r[i];
+    Real& vx = P->vx[i];
+    Real& vy = P->vy[i];
     if (x - r < 0 && vx < 0) vx *= -1;
     if (x + r > C.GetW() && vx > 0) vx *= -1;
     if (y - r < 0 && vy < 0) vy *= -1;
@@ -67,76 +73,172 @@ void Bola::ResuelvaColisionParedesSimple(const Caja& C) {
 
 /**
  * @brief Resuelve colisiones robustas con las paredes de la caja.
- * 
- * Además de invertir la velocidad, este método ajusta la posición 
- * de la bola para evitar que atraviese las paredes, 
+ *
+ * Además de invertir la velocidad, este método ajusta la posición
+ * de la bola para evitar que atraviese las paredes,
  * mejorando la estabilidad numérica de la simulación.
- * 
+ *
  * @param C Caja con la que colisiona.
  */
-void Bola::ResuelvaColisionParedesRobusto(const Caja& C) {
+template <class Real>
+void BolaT<Real>::ResuelvaColisionParedesRobusto(const Caja& C) {
+    const Real r = P->r[i];
+    const Real W = static_cast<Real>(C.GetW()), H = static_cast<Real>(C.GetH());
+    Real& x = P->x[i];
+    Real& y = P->y[i];
+    Real& vx = P->vx[i];
+    Real& vy = P->vy[i];
     if (x - r < 0 && vx < 0) {
         x = r + (r - x); ///< Corrige posición en x.
         vx *= -1;
     }
-    if (x + r > C.GetW() && vx > 0) {
-        x = C.GetW() - r - (x + r - C.GetW());
+    if (x + r > W && vx > 0) {
+        x = W - r - (x + r - W);
         vx *= -1;
     }
     if (y - r < 0 && vy < 0) {
         y = r + (r - y);
         vy *= -1;
     }
-    if (y + r > C.GetH() && vy > 0) {
-        y = C.GetH() - r - (y + r - C.GetH());
+    if (y + r > H && vy > 0) {
+        y = H - r - (y + r - H);
         vy *= -1;
     }
 }
 
 /**
  * @brief Resuelve una colisión elástica entre dos bolas.
- * 
- * Conserva el momento lineal y la energía cinética del sistema 
- * de dos bolas. Si las bolas se solapan, también realiza una 
- * corrección de posición para separarlas.
- * 
- * @param otra Referencia a la otra bola con la que colisiona.
+ *
+ * Conserva el momento lineal y la energía cinética del sistema
+ * de dos bolas. Si las bolas se solapan, también realiza una
+ * corrección de posición para separarlas. Usa las inversas de
+ * las masas precalculadas, de modo que no divide por la masa.
+ *
+ * @param otra Vista de la otra bola con la que colisiona.
+ * @return Bits de EfectoChoque.
  */
-void Bola::ChoqueElastico(Bola& otra) {
-    double dx = otra.x - x;
-    double dy = otra.y - y;
-    double dist_sq = dx * dx + dy * dy;
-    double minDist = r + otra.r;
+template <class Real>
+unsigned BolaT<Real>::ChoqueElastico(BolaT otra) {
+    ParticulasT<Real>& A = *P;
+    ParticulasT<Real>& B = *otra.P;
+    const std::size_t j = otra.i;
+
+    Real dx = B.x[j] - A.x[i];
+    Real dy = B.y[j] - A.y[i];
+    Real dist_sq = dx * dx + dy * dy;
+    Real minDist = A.r[i] + B.r[j];
 
     // Detecta superposición
     if (dist_sq < minDist * minDist) {
-        double dist = std::sqrt(dist_sq);
+        Real dist = std::sqrt(dist_sq);
         // Evita división por cero si están en el mismo punto
-        if (dist == 0.0) return;
+        if (dist == Real(0)) return Contacto;
 
         // Vector unitario normal
-        double nx = dx / dist;
-        double ny = dy / dist;
+        Real nx = dx / dist;
+        Real ny = dy / dist;
 
         // Diferencia de velocidades
-        double dvx = otra.vx - vx;
-        double dvy = otra.vy - vy;
-        double vn = dvx * nx + dvy * ny;
+        Real dvx = B.vx[j] - A.vx[i];
+        Real dvy = B.vy[j] - A.vy[i];
+        Real vn = dvx * nx + dvy * ny;
 
+        unsigned efecto = Contacto | Correccion;
         // Solo aplica la colisión si se acercan entre sí
         if (vn < 0) {
-            double J = (-2 * vn) / (1/m + 1/otra.m); ///< Impulso escalar.
-            vx -= (J / m) * nx;
-            vy -= (J / m) * ny;
-            otra.vx += (J / otra.m) * nx;
-            otra.vy += (J / otra.m) * ny;
+            efecto |= Impulso;
+            Real J = (-2 * vn) / (A.inv_m[i] + B.inv_m[j]); ///< Impulso escalar.
+            A.vx[i] -= (J * A.inv_m[i]) * nx;
+            A.vy[i] -= (J * A.inv_m[i]) * ny;
+            B.vx[j] += (J * B.inv_m[j]) * nx;
+            B.vy[j] += (J * B.inv_m[j]) * ny;
         }
 
         // Corrección por superposición (ligero desplazamiento)
-        double overlap = 0.51 * (minDist - dist);
-        x -= overlap * nx;
-        y -= overlap * ny;
-        otra.x += overlap * nx;
-        otra.y += overlap * ny;
+        Real overlap = Real(0.51) * (minDist - dist);
+        A.x[i] -= overlap * nx;
+        A.y[i] -= overlap * ny;
+        B.x[j] += overlap * nx;
+        B.y[j] += overlap * ny;
+        return efecto;
     }
+    return SinContacto;
+}
+
+/**
+ * @brief Aplica el impulso de un choque elástico en contacto exacto.
+ *
+ * La normal se toma de la recta que une los centros en el instante del contacto.
+ *
+ * @param otra Vista de la otra bola.
+ */
+template <class Real>
+void BolaT<Real>::ChoqueContacto(BolaT otra) {
+    ParticulasT<Real>& A = *P;
+    ParticulasT<Real>& B = *otra.P;
+    const std::size_t j = otra.i;
+
+    Real dx = B.x[j] - A.x[i];
+    Real dy = B.y[j] - A.y[i];
+    Real dist = std::sqrt(dx * dx + dy * dy);
+    if (dist == Real(0)) return;
+
+    Real nx = dx / dist;
+    Real ny = dy / dist;
+    Real vn = (B.vx[j] - A.vx[i]) * nx + (B.vy[j] - A.vy[i]) * ny;
+    if (vn >= 0) return;
+
+    Real J = (-2 * vn) / (A.inv_m[i] + B.inv_m[j]); ///< Impulso escalar.
+    A.vx[i] -= (J * A.inv_m[i]) * nx;
+    A.vy[i] -= (J * A.inv_m[i]) * ny;
+    B.vx[j] += (J * B.inv_m[j]) * nx;
+    B.vy[j] += (J * B.inv_m[j]) * ny;
 }
+
+/**
+ * @brief Calcula el tiempo hasta el contacto con otra bola.
+ *
+ * Resuelve |dr + dv t| = r1 + r2 para la raíz más pequeña. Si las bolas ya se
+ * solapan y se acercan, el choque es inmediato.
+ *
+ * @param otra Otra bola, sincronizada al mismo instante.
+ * @return Tiempo hasta el contacto o infinito.
+ */
+template <class Real>
+double BolaT<Real>::TiempoChoque(const BolaT& otra) const {
+    const double inf = std::numeric_limits<double>::infinity();
+    double dx = double(otra.Getx()) - Getx(), dy = double(otra.Gety()) - Gety();
+    double dvx = double(otra.Getvx()) - Getvx(), dvy = double(otra.Getvy()) - Getvy();
+    double b = dx * dvx + dy * dvy;
+    if (b >= 0) return inf; // Se alejan
+
+    double dvdv = dvx * dvx + dvy * dvy;
+    double drdr = dx * dx + dy * dy;
+    double sigma = double(Getr()) + otra.Getr();
+    double c = drdr - sigma * sigma;
+    if (c <= 0) return 0.0; // Ya están en contacto y se acercan
+
+    double d = b * b - dvdv * c;
+    if (d < 0) return inf; // Se cruzan sin tocarse
+    return c / (-b + std::sqrt(d)); // Forma estable de -(b + sqrt(d)) / dvdv
+}
+
+/**
+ * @brief Calcula el tiempo hasta el contacto con una pared.
+ * @param C Caja de la simulación.
+ * @param eje_x Paredes verticales (true) u horizontales (false).
+ * @return Tiempo hasta el contacto (0 si ya la atravesó) o infinito.
+ */
+template <class Real>
+double BolaT<Real>::TiempoPared(const Caja& C, bool eje_x) const {
+    double p = eje_x ? Getx() : Gety();
+    double v = eje_x ? Getvx() : Getvy();
+    double L = eje_x ? C.GetW() : C.GetH();
+    double r = Getr();
+    if (v > 0) return std::max(0.0, (L - r - p) / v);
+    if (v < 0) return std::max(0.0, (r - p) / v);
+    return std::numeric_limits<double>::infinity();
+}
+
+template class BolaT<double>;
+template class BolaT<float>;
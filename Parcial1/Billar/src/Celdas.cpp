@@ -0,0 +1,264 @@
+/**
+ * @file Celdas.cpp
+ * @brief Implementación de la rejilla de celdas para la detección de colisiones.
+ */
+
+#include "Celdas.h"
+#include "Bola.h"
+#include <algorithm>
+
+/**
+ * @brief Ajusta la geometría de la rejilla a la caja.
+ *
+ * El número de celdas por eje se redondea hacia abajo, de modo que cada celda
+ * mide al menos `lado_min` en ambas direcciones.
+ *
+ * @param C Caja de la simulación.
+ * @param lado_min Lado mínimo de celda.
+ * @param origen_x Abscisa del borde izquierdo de la rejilla.
+ */
+void Celdas::Defina(const Caja& C, double lado_min, double origen_x) {
+    x0 = origen_x;
+    nx = std::max(1, static_cast<int>(C.GetW() / lado_min));
+    ny = std::max(1, static_cast<int>(C.GetH() / lado_min));
+    lx = C.GetW() / nx;
+    ly = C.GetH() / ny;
+    inicio.assign(static_cast<size_t>(nx) * ny + 1, 0);
+}
+
+/**
+ * @brief Asigna cada bola a su celda mediante un ordenamiento por conteo.
+ *
+ * Las bolas que quedan ligeramente fuera de la caja (por ejemplo con paredes simples)
+ * se asignan a la celda del borde más cercana.
+ *
+ * @param bolas Bolas del sistema.
+ */
+template <class Real>
+void Celdas::Construya(const ParticulasT<Real>& bolas) {
+    const int N = static_cast<int>(bolas.Tamano());
+    celda.resize(N);
+    indices.resize(N);
+    std::fill(inicio.begin(), inicio.end(), 0);
+
+    for (int i = 0; i < N; ++i) {
+        int cx = std::clamp(static_cast<int>((bolas.x[i] - x0) / lx), 0, nx - 1);
+        int cy = std::clamp(static_cast<int>(bolas.y[i] / ly), 0, ny - 1);
+        celda[i] = cy * nx + cx;
+        ++inicio[celda[i] + 1];
+    }
+    for (size_t c = 1; c < inicio.size(); ++c)
+        inicio[c] += inicio[c - 1];
+
+    lleno.assign(inicio.begin(), inicio.end() - 1);
+    for (int i = 0; i < N; ++i)
+        indices[lleno[celda[i]]++] = i;
+}
+
+/**
+ * @brief Resuelve los choques entre bolas de celdas vecinas.
+ *
+ * Cada par se prueba una sola vez (j > i). El orden de los índices i coincide
+ * con el del recorrido por fuerza bruta.
+ *
+ * @param bolas Bolas del sistema (ya asignadas con Construya).
+ * @return Pares probados y, con la instrumentación, contactos, impulsos y correcciones.
+ */
+template <class Real>
+ConteoChoques Celdas::ResuelvaChoques(ParticulasT<Real>& bolas) const {
+    const int N = static_cast<int>(bolas.Tamano());
+    ConteoChoques conteo;
+    for (int i = 0; i < N; ++i) {
+        BolaT<Real> bi(bolas, i);
+        int cx = celda[i] % nx;
+        int cy = celda[i] / nx;
+        for (int ey = std::max(cy - 1, 0); ey <= std::min(cy + 1, ny - 1); ++ey) {
+            for (int ex = std::max(cx - 1, 0); ex <= std::min(cx + 1, nx - 1); ++ex) {
+                int c = ey * nx + ex;
+                for (int k = inicio[c]; k < inicio[c + 1]; ++k) {
+                    int j = indices[k];
+                    if (j > i) {
+                        const unsigned efecto = bi.ChoqueElastico(BolaT<Real>(bolas, j));
+                        ++conteo.pruebas;
+                        if constexpr (INSTRUMENTACION_ACTIVA)
+                            conteo.Agregue(efecto);
+                    }
+                }
+            }
+        }
+    }
+    return conteo;
+}
+
+/**
+ * @brief Asigna cada bola a su celda con varios hilos.
+ *
+ * @param bolas Bolas del sistema.
+ * @param hilos Número de hilos.
+ * @param determinista Si es verdadero, ordena cada celda por índice de bola.
+ */
+template <class Real>
+void Celdas::ConstruyaParalelo(const ParticulasT<Real>& bolas, int hilos, bool determinista) {
+    if (hilos <= 1) {
+        Construya(bolas); // Con un hilo el conteo serial ya deja cada celda ordenada
+        return;
+    }
+    const int N = static_cast<int>(bolas.Tamano());
+    const int C = nx * ny;
+    celda.resize(N);
+    indices.resize(N);
+    std::fill(inicio.begin(), inicio.end(), 0);
+    int* cuenta = inicio.data();
+
+    #pragma omp parallel for num_threads(hilos) schedule(static)
+    for (int i = 0; i < N; ++i) {
+        int cx = std::clamp(static_cast<int>((bolas.x[i] - x0) / lx), 0, nx - 1);
+        int cy = std::clamp(static_cast<int>(bolas.y[i] / ly), 0, ny - 1);
+        celda[i] = cy * nx + cx;
+        #pragma omp atomic
+        ++cuenta[celda[i] + 1];
+    }
+    for (int c = 1; c <= C; ++c)
+        inicio[c] += inicio[c - 1];
+
+    lleno.assign(inicio.begin(), inicio.end() - 1);
+    int* pos = lleno.data();
+
+    #pragma omp parallel for num_threads(hilos) schedule(static)
+    for (int i = 0; i < N; ++i) {
+        int k;
+        #pragma omp atomic capture
+        k = pos[celda[i]]++;
+        indices[k] = i;
+    }
+
+    if (determinista) {
+        #pragma omp parallel for num_threads(hilos) schedule(static)
+        for (int c = 0; c < C; ++c)
+            if (inicio[c + 1] - inicio[c] > 1)
+                std::sort(indices.begin() + inicio[c], indices.begin() + inicio[c + 1]);
+    }
+}
+
+/**
+ * @brief Resuelve los choques en paralelo recorriendo bloques de 2x2 celdas en cuatro colores.
+ *
+ * Dentro de un bloque, cada par se prueba desde la celda de la bola de menor índice,
+ * igual que en la versión serial.
+ *
+ * @param bolas Bolas del sistema.
+ * @param hilos Número de hilos.
+ * @return Pares probados y, con la instrumentación, contactos, impulsos y correcciones.
+ */
+template <class Real>
+ConteoChoques Celdas::ResuelvaChoquesParalelo(ParticulasT<Real>& bolas, int hilos) const {
+    std::uint64_t pruebas = 0, contactos = 0, impulsos = 0, correcciones = 0;
+    const int bx_n = (nx + 1) / 2;
+    const int by_n = (ny + 1) / 2;
+
+    for (int color = 0; color < 4; ++color) {
+        const int px = color % 2, py = color / 2;
+        const int bx_color = (bx_n - px + 1) / 2; // Bloques de este color por fila
+        const int by_color = (by_n - py + 1) / 2;
+        const int bloques = bx_color * by_color;
+
+        #pragma omp parallel for num_threads(hilos) schedule(static) reduction(+:pruebas, contactos, impulsos, correcciones)
+        for (int b = 0; b < bloques; ++b) {
+            const int bx = px + 2 * (b % bx_color);
+            const int by = py + 2 * (b / bx_color);
+            for (int cy = 2 * by; cy <= std::min(2 * by + 1, ny - 1); ++cy) {
+                for (int cx = 2 * bx; cx <= std::min(2 * bx + 1, nx - 1); ++cx) {
+                    const int c0 = cy * nx + cx;
+                    for (int a = inicio[c0]; a < inicio[c0 + 1]; ++a) {
+                        const int i = indices[a];
+                        BolaT<Real> bi(bolas, i);
+                        for (int ey = std::max(cy - 1, 0); ey <= std::min(cy + 1, ny - 1); ++ey) {
+                            for (int ex = std::max(cx - 1, 0); ex <= std::min(cx + 1, nx - 1); ++ex) {
+                                const int c = ey * nx + ex;
+                                for (int k = inicio[c]; k < inicio[c + 1]; ++k) {
+                                    const int j = indices[k];
+                                    if (j > i) {
+                                        const unsigned efecto = bi.ChoqueElastico(BolaT<Real>(bolas, j));
+                                        ++pruebas;
+                                        if constexpr (INSTRUMENTACION_ACTIVA) {
+                                            contactos += efecto & Contacto;
+                                            impulsos += (efecto & Impulso) >> 1;
+                                            correcciones += (efecto & Correccion) >> 2;
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return ConteoChoques{pruebas, contactos, impulsos, correcciones};
+}
+
+/**
+ * @brief Marca en paralelo las bolas con contactos y los resuelve en el orden serial.
+ *
+ * @param bolas Bolas del sistema.
+ * @param hilos Número de hilos de la búsqueda.
+ * @return Pares probados por la búsqueda y, con la instrumentación, el efecto de los choques.
+ */
+template <class Real>
+ConteoChoques Celdas::ResuelvaChoquesOrdenado(ParticulasT<Real>& bolas, int hilos) {
+    const int N = static_cast<int>(bolas.Tamano());
+    pendiente.assign(N, 0);
+    std::uint64_t pruebas = 0;
+
+    // 1. Candidatas: la misma prueba de superposición que ChoqueElastico, sin modificar nada.
+    #pragma omp parallel for num_threads(hilos) schedule(static) reduction(+:pruebas)
+    for (int i = 0; i < N; ++i) {
+        const Real xi = bolas.x[i], yi = bolas.y[i], ri = bolas.r[i];
+        unsigned char marca = 0;
+        RecorraVecinas(i, [&](int j) {
+            if (j <= i) return;
+            ++pruebas;
+            const Real dx = bolas.x[j] - xi;
+            const Real dy = bolas.y[j] - yi;
+            const Real minDist = ri + bolas.r[j];
+            if (dx * dx + dy * dy < minDist * minDist) marca = 1;
+        });
+        pendiente[i] = marca;
+    }
+
+    // 2. Recorrido serial solo por las bolas marcadas, en el orden de ResuelvaChoques.
+    ConteoChoques conteo;
+    auto marque = [&](int b) {
+        pendiente[b] = 1;
+        RecorraVecinas(b, [&](int q) {
+            if (q < b) pendiente[q] = 1;
+        });
+    };
+    for (int i = 0; i < N; ++i) {
+        if (!pendiente[i]) continue;
+        BolaT<Real> bi(bolas, i);
+        RecorraVecinas(i, [&](int j) {
+            if (j <= i) return;
+            const unsigned efecto = bi.ChoqueElastico(BolaT<Real>(bolas, j));
+            if (efecto & Correccion) {
+                marque(i);
+                marque(j);
+            }
+            if constexpr (INSTRUMENTACION_ACTIVA)
+                conteo.Agregue(efecto);
+        });
+    }
+    conteo.pruebas = pruebas;
+    return conteo;
+}
+
+#define BILLAR_INSTANCIE_CELDAS(Real)                                                          \
+    template void Celdas::Construya<Real>(const ParticulasT<Real>&);                          \
+    template ConteoChoques Celdas::ResuelvaChoques<Real>(ParticulasT<Real>&) const;           \
+    template void Celdas::ConstruyaParalelo<Real>(const ParticulasT<Real>&, int, bool);       \
+    template ConteoChoques Celdas::ResuelvaChoquesParalelo<Real>(ParticulasT<Real>&, int) const; \
+    template ConteoChoques Celdas::ResuelvaChoquesOrdenado<Real>(ParticulasT<Real>&, int);
+
+BILLAR_INSTANCIE_CELDAS(double)
+BILLAR_INSTANCIE_CELDAS(float)
+#undef BILLAR_INSTANCIE_CELDAS
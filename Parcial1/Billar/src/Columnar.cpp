@@ -0,0 +1,261 @@
+/**
+ * @file Columnar.cpp
+ * @brief Implementación del escritor y el lector columnar por bloques.
+ */
+
+#include "Columnar.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+/** @brief Cabecera del archivo columnar tal como se guarda en disco (64 bytes). */
+struct CabeceraDisco {
+    char magia[8];
+    std::uint32_t version;
+    std::uint32_t cuadros_por_bloque;
+    std::uint64_t N;
+    double W, H, R, dt_frame;
+    std::uint64_t reservado;
+};
+static_assert(sizeof(CabeceraDisco) == 64, "La cabecera columnar debe ocupar 64 bytes");
+
+/** @brief Cola del archivo que ubica el índice de bloques (32 bytes). */
+struct ColaDisco {
+    std::uint64_t num_bloques;
+    std::uint64_t num_cuadros;
+    std::uint64_t desplazamiento_indice;
+    char magia[8];
+};
+static_assert(sizeof(ColaDisco) == 32, "La cola del índice debe ocupar 32 bytes");
+
+/** @brief Posición (en valores) de la columna `campo` de la bola i dentro de un bloque de k cuadros. */
+std::uint64_t Posicion(std::uint64_t N, std::uint64_t k, int campo, std::uint64_t i) {
+    return k + (campo * N + i) * k;
+}
+
+} // namespace
+
+// ==========================================================
+//                         ESCRITOR
+// ==========================================================
+
+/**
+ * @brief Cuadros por bloque que caben en el presupuesto, entre 1 y maximo.
+ * @param N Número de bolas.
+ * @param presupuesto Bytes para el bloque en construcción.
+ * @param maximo Cuadros por bloque como máximo.
+ */
+std::uint32_t EscritorColumnar::CuadrosPorBloque(std::uint64_t N, std::uint64_t presupuesto, std::uint32_t maximo) {
+    const std::uint64_t por_cuadro = sizeof(double) * (1 + 4 * N);
+    return static_cast<std::uint32_t>(std::clamp<std::uint64_t>(presupuesto / por_cuadro, 1, maximo));
+}
+
+/**
+ * @brief Abre el archivo columnar y escribe la cabecera.
+ * @param ruta Ruta del archivo.
+ * @param cab Parámetros de la corrida.
+ * @param presupuesto Bytes para el bloque en construcción.
+ * @param maximo Cuadros por bloque como máximo.
+ */
+EscritorColumnar::EscritorColumnar(const std::string& ruta, const CabeceraTrayectoria& cab,
+                                   std::uint64_t presupuesto, std::uint32_t maximo)
+    : f(ruta, std::ios::binary), N(cab.N) {
+    if (maximo == 0)
+        throw std::invalid_argument("Un bloque columnar debe tener al menos un cuadro.");
+    cuadros_por_bloque = CuadrosPorBloque(N, presupuesto, maximo);
+    if (!f)
+        throw std::runtime_error("No se pudo abrir el archivo de salida: " + ruta);
+
+    bloque.resize(cuadros_por_bloque * (1 + 4 * N));
+
+    CabeceraDisco d{};
+    std::memcpy(d.magia, "BILLARCL", 8);
+    d.version = 1;
+    d.cuadros_por_bloque = cuadros_por_bloque;
+    d.N = N;
+    d.W = cab.W;
+    d.H = cab.H;
+    d.R = cab.R;
+    d.dt_frame = cab.dt_frame;
+    f.write(reinterpret_cast<const char*>(&d), sizeof(d));
+}
+
+/**
+ * @brief Copia el cuadro en su fila de cada columna del bloque.
+ * @param c Cuadro con N bolas.
+ */
+void EscritorColumnar::Escriba(const Cuadro& c) {
+    if (c.Tamano() != N)
+        throw std::invalid_argument("El cuadro no tiene el número de bolas declarado en la cabecera.");
+
+    const std::uint64_t K = cuadros_por_bloque;
+    const std::uint32_t j = en_bloque;
+    bloque[j] = c.t;
+    const double* columnas[4] = {c.x.data(), c.y.data(), c.vx.data(), c.vy.data()};
+    for (int campo = 0; campo < 4; ++campo) {
+        double* destino = &bloque[Posicion(N, K, campo, 0) + j];
+        const double* origen = columnas[campo];
+        for (std::uint64_t i = 0; i < N; ++i)
+            destino[i * K] = origen[i];
+    }
+    ++cuadros;
+    if (++en_bloque == cuadros_por_bloque)
+        VacieBloque();
+}
+
+/**
+ * @brief Escribe el bloque acumulado con una sola llamada.
+ *
+ * Un bloque parcial (el último) se compacta antes para que cada columna
+ * ocupe exactamente k valores por bola.
+ */
+void EscritorColumnar::VacieBloque() {
+    const std::uint64_t k = en_bloque;
+    if (k == 0) return;
+    const std::uint64_t K = cuadros_por_bloque;
+    const std::uint64_t valores = k * (1 + 4 * N);
+
+    if (k < K) {
+        std::vector<double> compacto(valores);
+        std::copy(bloque.begin(), bloque.begin() + k, compacto.begin());
+        for (int campo = 0; campo < 4; ++campo)
+            for (std::uint64_t i = 0; i < N; ++i)
+                std::copy_n(&bloque[Posicion(N, K, campo, i)], k, &compacto[Posicion(N, k, campo, i)]);
+        f.write(reinterpret_cast<const char*>(compacto.data()), static_cast<std::streamsize>(valores * sizeof(double)));
+    } else {
+        f.write(reinterpret_cast<const char*>(bloque.data()), static_cast<std::streamsize>(valores * sizeof(double)));
+    }
+
+    indice.push_back({cuadros - k, k, bytes});
+    bytes += valores * sizeof(double);
+    en_bloque = 0;
+}
+
+/** @brief Escribe el último bloque, el índice y la cola, y cierra el archivo. */
+void EscritorColumnar::Cierre() {
+    if (!f.is_open()) return;
+    VacieBloque();
+    f.write(reinterpret_cast<const char*>(indice.data()),
+            static_cast<std::streamsize>(indice.size() * sizeof(BloqueColumnar)));
+    ColaDisco cola{};
+    cola.num_bloques = indice.size();
+    cola.num_cuadros = cuadros;
+    cola.desplazamiento_indice = bytes;
+    std::memcpy(cola.magia, "BCOLINDX", 8);
+    f.write(reinterpret_cast<const char*>(&cola), sizeof(cola));
+    f.close();
+}
+
+// ==========================================================
+//                          LECTOR
+// ==========================================================
+
+/**
+ * @brief Abre el archivo columnar y carga el índice de bloques.
+ * @param ruta Ruta del archivo.
+ */
+LectorColumnar::LectorColumnar(const std::string& ruta) : f(ruta, std::ios::binary) {
+    if (!f)
+        throw std::runtime_error("No se pudo abrir el archivo: " + ruta);
+    CabeceraDisco d{};
+    if (!f.read(reinterpret_cast<char*>(&d), sizeof(d)) || std::memcmp(d.magia, "BILLARCL", 8) != 0)
+        throw std::runtime_error("El archivo no es una trayectoria columnar del billar: " + ruta);
+    if (d.version != 1)
+        throw std::runtime_error("Versión de trayectoria columnar no soportada.");
+    cab.W = d.W;
+    cab.H = d.H;
+    cab.R = d.R;
+    cab.dt_frame = d.dt_frame;
+    cab.N = d.N;
+
+    ColaDisco cola{};
+    f.seekg(-static_cast<std::streamoff>(sizeof(cola)), std::ios::end);
+    if (!f.read(reinterpret_cast<char*>(&cola), sizeof(cola)) || std::memcmp(cola.magia, "BCOLINDX", 8) != 0)
+        throw std::runtime_error("El archivo columnar no tiene índice (¿la corrida no terminó?): " + ruta);
+    num_cuadros = cola.num_cuadros;
+    indice.resize(cola.num_bloques);
+    f.seekg(static_cast<std::streamoff>(cola.desplazamiento_indice));
+    f.read(reinterpret_cast<char*>(indice.data()),
+           static_cast<std::streamsize>(indice.size() * sizeof(BloqueColumnar)));
+    if (!f)
+        throw std::runtime_error("Índice columnar truncado: " + ruta);
+}
+
+/** @brief Lee n valores float64 contiguos desde el byte dado. */
+void LectorColumnar::LeaDoubles(std::uint64_t desplazamiento, double* destino, std::size_t n) const {
+    f.seekg(static_cast<std::streamoff>(desplazamiento));
+    f.read(reinterpret_cast<char*>(destino), static_cast<std::streamsize>(n * sizeof(double)));
+    if (!f)
+        throw std::runtime_error("Bloque columnar truncado.");
+}
+
+/** @brief Busca por bisección el bloque que contiene el cuadro k. */
+const BloqueColumnar& LectorColumnar::BloqueDe(std::uint64_t k) const {
+    if (k >= num_cuadros)
+        throw std::out_of_range("Cuadro fuera del archivo columnar.");
+    auto it = std::upper_bound(indice.begin(), indice.end(), k,
+                               [](std::uint64_t v, const BloqueColumnar& b) { return v < b.primer_cuadro; });
+    return *(it - 1);
+}
+
+/** @brief Lee los tiempos de todos los cuadros. */
+std::vector<double> LectorColumnar::Tiempos() const {
+    std::vector<double> t(num_cuadros);
+    for (const BloqueColumnar& b : indice)
+        LeaDoubles(b.desplazamiento, &t[b.primer_cuadro], b.cuadros);
+    return t;
+}
+
+/**
+ * @brief Lee la serie de una columna de la bola i: una lectura contigua por bloque.
+ * @param i Índice de la bola.
+ * @param campo Columna.
+ */
+std::vector<double> LectorColumnar::Serie(std::size_t i, Campo campo) const {
+    if (i >= cab.N)
+        throw std::out_of_range("Bola fuera del archivo columnar.");
+    std::vector<double> serie(num_cuadros);
+    for (const BloqueColumnar& b : indice) {
+        std::uint64_t p = Posicion(cab.N, b.cuadros, static_cast<int>(campo), i);
+        LeaDoubles(b.desplazamiento + p * sizeof(double), &serie[b.primer_cuadro], b.cuadros);
+    }
+    return serie;
+}
+
+/**
+ * @brief Lee las velocidades del cuadro k con una lectura de las columnas vx y vy del bloque.
+ * @param k Número de cuadro.
+ * @param vx,vy Vectores de destino.
+ */
+void LectorColumnar::Velocidades(std::uint64_t k, std::vector<double>& vx, std::vector<double>& vy) const {
+    const BloqueColumnar& b = BloqueDe(k);
+    const std::uint64_t N = cab.N, kb = b.cuadros, j = k - b.primer_cuadro;
+    std::vector<double> columnas(2 * N * kb);
+    LeaDoubles(b.desplazamiento + Posicion(N, kb, 2, 0) * sizeof(double), columnas.data(), columnas.size());
+    vx.resize(N);
+    vy.resize(N);
+    for (std::uint64_t i = 0; i < N; ++i) {
+        vx[i] = columnas[i * kb + j];
+        vy[i] = columnas[(N + i) * kb + j];
+    }
+}
+
+/**
+ * @brief Reconstruye el cuadro k leyendo su bloque completo.
+ * @param k Número de cuadro.
+ * @param c Cuadro de destino.
+ */
+void LectorColumnar::Lea(std::uint64_t k, Cuadro& c) const {
+    const BloqueColumnar& b = BloqueDe(k);
+    const std::uint64_t N = cab.N, kb = b.cuadros, j = k - b.primer_cuadro;
+    std::vector<double> datos(kb * (1 + 4 * N));
+    LeaDoubles(b.desplazamiento, datos.data(), datos.size());
+    c.t = datos[j];
+    c.Redimensione(N);
+    std::vector<double>* columnas[4] = {&c.x, &c.y, &c.vx, &c.vy};
+    for (int campo = 0; campo < 4; ++campo)
+        for (std::uint64_t i = 0; i < N; ++i)
+            (*columnas[campo])[i] = datos[Posicion(N, kb, campo, i) + j];
+}
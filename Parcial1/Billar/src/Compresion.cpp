@@ -0,0 +1,376 @@
+/**
+ * @file Compresion.cpp
+ * @brief Implementación del códec comprimido de trayectorias.
+ */
+
+#include "Compresion.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+/** @brief Cabecera del archivo comprimido tal como se guarda en disco (64 bytes). */
+struct CabeceraDisco {
+    char magia[8];
+    std::uint32_t version;
+    std::uint32_t intervalo_clave;
+    std::uint64_t N;
+    double W, H, R, dt_frame, tolerancia;
+};
+static_assert(sizeof(CabeceraDisco) == 64, "La cabecera comprimida debe ocupar 64 bytes");
+
+/** @brief Cola del archivo que ubica el índice de cuadros clave (32 bytes). */
+struct ColaDisco {
+    std::uint64_t num_entradas;
+    std::uint64_t num_cuadros;
+    std::uint64_t desplazamiento_indice;
+    char magia[8];
+};
+static_assert(sizeof(ColaDisco) == 32, "La cola del índice debe ocupar 32 bytes");
+
+const std::size_t BYTES_REGISTRO = 1 + sizeof(double) + sizeof(std::uint32_t); ///< tipo + t + longitud.
+
+std::uint64_t Zigzag(std::int64_t v) { return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63); }
+std::int64_t DesZigzag(std::uint64_t u) { return static_cast<std::int64_t>(u >> 1) ^ -static_cast<std::int64_t>(u & 1); }
+
+std::uint64_t Bits(double v) { std::uint64_t b; std::memcpy(&b, &v, 8); return b; }
+double Real(std::uint64_t b) { double v; std::memcpy(&v, &b, 8); return v; }
+
+void PongaVarint(std::vector<std::uint8_t>& buf, std::uint64_t u) {
+    while (u >= 0x80) {
+        buf.push_back(static_cast<std::uint8_t>(u | 0x80));
+        u >>= 7;
+    }
+    buf.push_back(static_cast<std::uint8_t>(u));
+}
+
+std::uint64_t LeaVarint(const std::uint8_t*& p, const std::uint8_t* fin) {
+    std::uint64_t u = 0;
+    for (int corrimiento = 0; corrimiento < 64; corrimiento += 7) {
+        if (p == fin) throw std::runtime_error("Cuadro comprimido truncado.");
+        std::uint8_t b = *p++;
+        u |= static_cast<std::uint64_t>(b & 0x7f) << corrimiento;
+        if (!(b & 0x80)) return u;
+    }
+    throw std::runtime_error("Varint inválido en el cuadro comprimido.");
+}
+
+/**
+ * @brief Codifica posiciones cuantizadas como residuos respecto a la predicción lineal.
+ *
+ * En un cuadro clave el estado previo es cero, así se usa el mismo código.
+ */
+void CodifiquePosiciones(std::vector<std::uint8_t>& buf, const double* x, std::vector<std::int64_t>& q,
+                         const std::vector<std::uint64_t>& bv, double paso, double despl) {
+    for (std::size_t i = 0; i < q.size(); ++i) {
+        std::int64_t nuevo = std::llround(x[i] / paso);
+        std::int64_t pred = q[i] + std::llround(Real(bv[i]) * despl);
+        PongaVarint(buf, Zigzag(nuevo - pred));
+        q[i] = nuevo;
+    }
+}
+
+void DecodifiquePosiciones(const std::uint8_t*& p, const std::uint8_t* fin, std::vector<std::int64_t>& q,
+                           const std::vector<std::uint64_t>& bv, double despl) {
+    for (std::size_t i = 0; i < q.size(); ++i) {
+        std::int64_t pred = q[i] + std::llround(Real(bv[i]) * despl);
+        q[i] = pred + DesZigzag(LeaVarint(p, fin));
+    }
+}
+
+/**
+ * @brief Codifica velocidades sin pérdida: corridas de XOR nulos y bytes significativos.
+ *
+ * Cada valor distinto se guarda como un byte (bytes nulos altos << 4 | bytes nulos bajos)
+ * seguido de los bytes centrales del XOR; un rebote en pared solo cambia el signo y ocupa 2 bytes.
+ */
+void CodifiqueVelocidades(std::vector<std::uint8_t>& buf, const double* v, std::vector<std::uint64_t>& bv) {
+    const std::size_t n = bv.size();
+    std::size_t i = 0;
+    while (i < n) {
+        std::size_t corrida = 0;
+        while (i + corrida < n && Bits(v[i + corrida]) == bv[i + corrida]) ++corrida;
+        PongaVarint(buf, corrida);
+        i += corrida;
+        if (i == n) break;
+
+        std::uint64_t b = Bits(v[i]);
+        std::uint64_t x = b ^ bv[i];
+        int altos = __builtin_clzll(x) / 8, bajos = __builtin_ctzll(x) / 8;
+        buf.push_back(static_cast<std::uint8_t>(altos << 4 | bajos));
+        for (int k = bajos; k < 8 - altos; ++k)
+            buf.push_back(static_cast<std::uint8_t>(x >> (8 * k)));
+        bv[i] = b;
+        ++i;
+    }
+}
+
+void DecodifiqueVelocidades(const std::uint8_t*& p, const std::uint8_t* fin, std::vector<std::uint64_t>& bv) {
+    const std::size_t n = bv.size();
+    std::size_t i = 0;
+    while (i < n) {
+        std::uint64_t corrida = LeaVarint(p, fin);
+        if (corrida > n - i) throw std::runtime_error("Corrida inválida en el cuadro comprimido.");
+        i += corrida;
+        if (i == n) break;
+
+        if (p == fin) throw std::runtime_error("Cuadro comprimido truncado.");
+        int altos = *p >> 4, bajos = *p & 0x0f;
+        ++p;
+        if (altos + bajos >= 8 || fin - p < 8 - altos - bajos)
+            throw std::runtime_error("Velocidad inválida en el cuadro comprimido.");
+        std::uint64_t x = 0;
+        for (int k = bajos; k < 8 - altos; ++k)
+            x |= static_cast<std::uint64_t>(*p++) << (8 * k);
+        bv[i] ^= x;
+        ++i;
+    }
+}
+
+} // namespace
+
+// ==========================================================
+//                         ESCRITOR
+// ==========================================================
+
+/**
+ * @brief Abre el archivo comprimido y escribe la cabecera.
+ * @param ruta Ruta del archivo.
+ * @param cab Parámetros de la corrida.
+ * @param tolerancia Error máximo de las posiciones.
+ * @param intervalo_clave_ Cuadros entre cuadros clave.
+ */
+EscritorComprimido::EscritorComprimido(const std::string& ruta, const CabeceraTrayectoria& cab,
+                                       double tolerancia, std::uint32_t intervalo_clave_)
+    : f(ruta, std::ios::binary), N(cab.N), paso(2.0 * tolerancia), intervalo_clave(intervalo_clave_) {
+    if (!(tolerancia > 0.0))
+        throw std::invalid_argument("La tolerancia de cuantización debe ser positiva.");
+    if (intervalo_clave == 0)
+        throw std::invalid_argument("El intervalo entre cuadros clave debe ser al menos 1.");
+    if (!f)
+        throw std::runtime_error("No se pudo abrir el archivo de salida: " + ruta);
+
+    desplazamiento_pred = cab.dt_frame / paso;
+    qx.assign(N, 0);
+    qy.assign(N, 0);
+    bvx.assign(N, 0);
+    bvy.assign(N, 0);
+    buffer.reserve(BYTES_REGISTRO + 8 * N);
+
+    CabeceraDisco d{};
+    std::memcpy(d.magia, "BILLARCZ", 8);
+    d.version = 1;
+    d.intervalo_clave = intervalo_clave;
+    d.N = N;
+    d.W = cab.W;
+    d.H = cab.H;
+    d.R = cab.R;
+    d.dt_frame = cab.dt_frame;
+    d.tolerancia = tolerancia;
+    f.write(reinterpret_cast<const char*>(&d), sizeof(d));
+}
+
+/**
+ * @brief Codifica el cuadro en el búfer y lo escribe con una sola llamada.
+ * @param c Cuadro con N bolas.
+ */
+void EscritorComprimido::Escriba(const Cuadro& c) {
+    if (c.Tamano() != N)
+        throw std::invalid_argument("El cuadro no tiene el número de bolas declarado en la cabecera.");
+
+    const bool clave = (cuadros % intervalo_clave == 0);
+    if (clave) {
+        std::fill(qx.begin(), qx.end(), 0);
+        std::fill(qy.begin(), qy.end(), 0);
+        std::fill(bvx.begin(), bvx.end(), 0);
+        std::fill(bvy.begin(), bvy.end(), 0);
+        indice.push_back({cuadros, bytes, c.t});
+    }
+
+    buffer.assign(BYTES_REGISTRO, 0);
+    buffer[0] = clave ? 0 : 1;
+    std::memcpy(&buffer[1], &c.t, sizeof(double));
+
+    // Las posiciones se predicen con las velocidades del cuadro anterior,
+    // por eso se codifican antes de actualizar las velocidades.
+    CodifiquePosiciones(buffer, c.x.data(), qx, bvx, paso, desplazamiento_pred);
+    CodifiquePosiciones(buffer, c.y.data(), qy, bvy, paso, desplazamiento_pred);
+    CodifiqueVelocidades(buffer, c.vx.data(), bvx);
+    CodifiqueVelocidades(buffer, c.vy.data(), bvy);
+
+    std::uint32_t longitud = static_cast<std::uint32_t>(buffer.size() - BYTES_REGISTRO);
+    std::memcpy(&buffer[1 + sizeof(double)], &longitud, sizeof(longitud));
+    f.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    bytes += buffer.size();
+    ++cuadros;
+}
+
+/** @brief Escribe el índice de cuadros clave y la cola, y cierra el archivo. */
+void EscritorComprimido::Cierre() {
+    if (!f.is_open()) return;
+    f.write(reinterpret_cast<const char*>(indice.data()),
+            static_cast<std::streamsize>(indice.size() * sizeof(EntradaIndice)));
+    ColaDisco cola{};
+    cola.num_entradas = indice.size();
+    cola.num_cuadros = cuadros;
+    cola.desplazamiento_indice = bytes;
+    std::memcpy(cola.magia, "BCZINDEX", 8);
+    f.write(reinterpret_cast<const char*>(&cola), sizeof(cola));
+    f.close();
+}
+
+// ==========================================================
+//                          LECTOR
+// ==========================================================
+
+/**
+ * @brief Abre el archivo comprimido, valida la cabecera y carga el índice.
+ * @param ruta Ruta del archivo.
+ */
+LectorComprimido::LectorComprimido(const std::string& ruta) : f(ruta, std::ios::binary) {
+    if (!f)
+        throw std::runtime_error("No se pudo abrir el archivo: " + ruta);
+    CabeceraDisco d{};
+    if (!f.read(reinterpret_cast<char*>(&d), sizeof(d)) || std::memcmp(d.magia, "BILLARCZ", 8) != 0)
+        throw std::runtime_error("El archivo no es una trayectoria comprimida del billar: " + ruta);
+    if (d.version != 1)
+        throw std::runtime_error("Versión de trayectoria comprimida no soportada.");
+
+    cab.W = d.W;
+    cab.H = d.H;
+    cab.R = d.R;
+    cab.dt_frame = d.dt_frame;
+    cab.N = d.N;
+    tolerancia = d.tolerancia;
+    paso = 2.0 * tolerancia;
+    desplazamiento_pred = cab.dt_frame / paso;
+    qx.assign(cab.N, 0);
+    qy.assign(cab.N, 0);
+    bvx.assign(cab.N, 0);
+    bvy.assign(cab.N, 0);
+
+    CargueIndice();
+}
+
+/**
+ * @brief Lee el índice de la cola del archivo; si falta, recorre los registros.
+ */
+void LectorComprimido::CargueIndice() {
+    f.seekg(0, std::ios::end);
+    const std::uint64_t tamano = static_cast<std::uint64_t>(f.tellg());
+
+    if (tamano >= 64 + sizeof(ColaDisco)) {
+        ColaDisco cola{};
+        f.seekg(static_cast<std::streamoff>(tamano - sizeof(ColaDisco)));
+        f.read(reinterpret_cast<char*>(&cola), sizeof(cola));
+        if (std::memcmp(cola.magia, "BCZINDEX", 8) == 0 &&
+            cola.desplazamiento_indice + cola.num_entradas * sizeof(EntradaIndice) + sizeof(ColaDisco) == tamano) {
+            indice.resize(cola.num_entradas);
+            f.seekg(static_cast<std::streamoff>(cola.desplazamiento_indice));
+            f.read(reinterpret_cast<char*>(indice.data()),
+                   static_cast<std::streamsize>(indice.size() * sizeof(EntradaIndice)));
+            num_cuadros = cola.num_cuadros;
+            fin_datos = cola.desplazamiento_indice;
+            return;
+        }
+    }
+
+    // Sin índice: se recorren las cabeceras de los registros completos.
+    f.clear();
+    std::uint64_t pos = 64;
+    while (pos + BYTES_REGISTRO <= tamano) {
+        std::uint8_t tipo;
+        double t;
+        std::uint32_t longitud;
+        f.seekg(static_cast<std::streamoff>(pos));
+        f.read(reinterpret_cast<char*>(&tipo), 1);
+        f.read(reinterpret_cast<char*>(&t), sizeof(t));
+        f.read(reinterpret_cast<char*>(&longitud), sizeof(longitud));
+        if (!f || pos + BYTES_REGISTRO + longitud > tamano) break;
+        if (tipo == 0) indice.push_back({num_cuadros, pos, t});
+        pos += BYTES_REGISTRO + longitud;
+        ++num_cuadros;
+    }
+    f.clear();
+    fin_datos = pos;
+}
+
+/**
+ * @brief Decodifica el siguiente cuadro de la lectura secuencial.
+ * @param c Cuadro de destino.
+ * @return false al llegar al final.
+ */
+bool LectorComprimido::Siguiente(Cuadro& c) {
+    if (siguiente >= num_cuadros || posicion >= fin_datos) return false;
+
+    std::uint8_t tipo;
+    double t;
+    std::uint32_t longitud;
+    f.seekg(static_cast<std::streamoff>(posicion));
+    f.read(reinterpret_cast<char*>(&tipo), 1);
+    f.read(reinterpret_cast<char*>(&t), sizeof(t));
+    f.read(reinterpret_cast<char*>(&longitud), sizeof(longitud));
+    buffer.resize(longitud);
+    f.read(reinterpret_cast<char*>(buffer.data()), longitud);
+    if (!f) throw std::runtime_error("Cuadro comprimido truncado.");
+
+    if (tipo == 0) {
+        std::fill(qx.begin(), qx.end(), 0);
+        std::fill(qy.begin(), qy.end(), 0);
+        std::fill(bvx.begin(), bvx.end(), 0);
+        std::fill(bvy.begin(), bvy.end(), 0);
+    } else if (tipo != 1 || siguiente == 0) {
+        throw std::runtime_error("Tipo de cuadro comprimido inválido.");
+    }
+
+    const std::uint8_t* p = buffer.data();
+    const std::uint8_t* fin = p + buffer.size();
+    DecodifiquePosiciones(p, fin, qx, bvx, desplazamiento_pred);
+    DecodifiquePosiciones(p, fin, qy, bvy, desplazamiento_pred);
+    DecodifiqueVelocidades(p, fin, bvx);
+    DecodifiqueVelocidades(p, fin, bvy);
+
+    const std::size_t N = cab.N;
+    c.t = t;
+    c.Redimensione(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        c.x[i] = qx[i] * paso;
+        c.y[i] = qy[i] * paso;
+        c.vx[i] = Real(bvx[i]);
+        c.vy[i] = Real(bvy[i]);
+    }
+
+    posicion += BYTES_REGISTRO + longitud;
+    ++siguiente;
+    return true;
+}
+
+/**
+ * @brief Decodifica el cuadro k.
+ *
+ * Si k está entre la posición secuencial actual y el próximo cuadro clave se sigue
+ * decodificando desde ahí; si no, se salta al cuadro clave anterior a k.
+ *
+ * @param k Número de cuadro.
+ * @param c Cuadro de destino.
+ */
+void LectorComprimido::Lea(std::uint64_t k, Cuadro& c) {
+    if (k >= num_cuadros)
+        throw std::out_of_range("Cuadro fuera del archivo comprimido.");
+
+    auto it = std::upper_bound(indice.begin(), indice.end(), k,
+                               [](std::uint64_t v, const EntradaIndice& e) { return v < e.cuadro; });
+    if (it == indice.begin())
+        throw std::runtime_error("El archivo comprimido no tiene cuadro clave inicial.");
+    const EntradaIndice& clave = *(it - 1);
+    if (siguiente <= clave.cuadro || siguiente > k) {
+        siguiente = clave.cuadro;
+        posicion = clave.desplazamiento;
+    }
+    while (siguiente <= k) {
+        if (!Siguiente(c))
+            throw std::runtime_error("Cuadro comprimido truncado.");
+    }
+}
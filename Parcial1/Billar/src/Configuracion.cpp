@@ -0,0 +1,376 @@
+/**
+ * @file Configuracion.cpp
+ * @brief Implementación de la lectura de parámetros desde la línea de comandos y archivos.
+ */
+
+#include "Configuracion.h"
+#include "Seleccion.h"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+/** @brief Quita espacios al inicio y al final. */
+std::string Recorte(const std::string& s) {
+    const char* blancos = " \t\r\n";
+    std::size_t a = s.find_first_not_of(blancos);
+    if (a == std::string::npos) return "";
+    std::size_t b = s.find_last_not_of(blancos);
+    return s.substr(a, b - a + 1);
+}
+
+/** @brief Convierte a entero; todo el texto debe ser un número. */
+long long ComoEntero(const std::string& clave, const std::string& valor) {
+    try {
+        std::size_t usados = 0;
+        long long v = std::stoll(valor, &usados);
+        if (usados == valor.size()) return v;
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument("Valor entero no válido para '" + clave + "': " + valor);
+}
+
+/** @brief Convierte a real; todo el texto debe ser un número. */
+double ComoReal(const std::string& clave, const std::string& valor) {
+    try {
+        std::size_t usados = 0;
+        double v = std::stod(valor, &usados);
+        if (usados == valor.size()) return v;
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument("Valor real no válido para '" + clave + "': " + valor);
+}
+
+/** @brief Convierte "si"/"no" (o 1/0) a booleano. */
+bool ComoBooleano(const std::string& clave, const std::string& valor) {
+    if (valor == "si" || valor == "1") return true;
+    if (valor == "no" || valor == "0") return false;
+    throw std::invalid_argument("Valor 'si' o 'no' esperado para '" + clave + "': " + valor);
+}
+
+/** @brief Separa "v1,v2,..." en valores recortados. */
+std::vector<std::string> SepareValores(const std::string& lista) {
+    std::vector<std::string> valores;
+    std::stringstream ss(lista);
+    std::string v;
+    while (std::getline(ss, v, ','))
+        if (!Recorte(v).empty()) valores.push_back(Recorte(v));
+    return valores;
+}
+
+/** @brief Construye un barrido a partir de "clave=v1,v2,..." y valida los valores. */
+Barrido LeaBarrido(const std::string& clave, const std::string& lista) {
+    Barrido b{Recorte(clave), SepareValores(lista)};
+    if (b.valores.empty())
+        throw std::invalid_argument("El barrido de '" + b.clave + "' no tiene valores.");
+    Configuracion prueba;
+    for (const std::string& v : b.valores)
+        AsigneParametro(prueba, b.clave, v);
+    return b;
+}
+
+/** @brief Convierte un real a texto sin perder los dígitos significativos habituales. */
+std::string Texto(double v) {
+    std::ostringstream ss;
+    ss << std::setprecision(15) << v;
+    return ss.str();
+}
+
+} // namespace
+
+/**
+ * @brief Asigna el parámetro `clave` a partir de su valor en texto.
+ * @param c Configuración.
+ * @param clave Nombre del parámetro.
+ * @param valor Valor en texto.
+ */
+void AsigneParametro(Configuracion& c, const std::string& clave, const std::string& valor) {
+    if (clave == "N") {
+        long long v = ComoEntero(clave, valor);
+        if (v < 0) throw std::invalid_argument("N no puede ser negativo.");
+        c.N = static_cast<int>(v);
+    } else if (clave == "tf") {
+        c.tf = ComoReal(clave, valor);
+        if (!(c.tf >= 0.0)) throw std::invalid_argument("tf no puede ser negativo.");
+    } else if (clave == "W") {
+        c.W = ComoReal(clave, valor);
+        if (!(c.W > 0.0)) throw std::invalid_argument("El ancho W debe ser positivo.");
+    } else if (clave == "H") {
+        c.H = ComoReal(clave, valor);
+        if (!(c.H > 0.0)) throw std::invalid_argument("El alto H debe ser positivo.");
+    } else if (clave == "dt_sim") {
+        c.dt_sim = ComoReal(clave, valor);
+        if (!(c.dt_sim > 0.0)) throw std::invalid_argument("dt_sim debe ser positivo.");
+    } else if (clave == "cfl") {
+        c.cfl = ComoReal(clave, valor);
+        if (!(c.cfl >= 0.0 && c.cfl <= 1.0)) throw std::invalid_argument("cfl debe estar en [0, 1].");
+    } else if (clave == "dt_frame") {
+        c.dt_frame = ComoReal(clave, valor);
+        if (!(c.dt_frame > 0.0)) throw std::invalid_argument("dt_frame debe ser positivo.");
+    } else if (clave == "m") {
+        c.m = ComoReal(clave, valor);
+        if (!(c.m > 0.0)) throw std::invalid_argument("La masa debe ser positiva.");
+    } else if (clave == "r") {
+        c.r = ComoReal(clave, valor);
+        if (!(c.r > 0.0)) throw std::invalid_argument("El radio debe ser positivo.");
+    } else if (clave == "vmax") {
+        c.vmax = ComoReal(clave, valor);
+        if (!(c.vmax >= 0.0)) throw std::invalid_argument("vmax no puede ser negativa.");
+    } else if (clave == "inicial") {
+        if (valor != "rejilla" && valor != "maxwell")
+            throw std::invalid_argument("Estado inicial no válido. Elija 'rejilla' o 'maxwell'.");
+        c.inicial = valor;
+    } else if (clave == "kT") {
+        c.kT = ComoReal(clave, valor);
+        if (c.kT < 0.0) throw std::invalid_argument("kT no puede ser negativa.");
+    } else if (clave == "integrador") {
+        if (valor != "euler" && valor != "verlet" && valor != "eventos")
+            throw std::invalid_argument("Integrador no válido. Elija 'euler', 'verlet' o 'eventos'.");
+        c.integrador = valor;
+    } else if (clave == "motor") {
+        if (valor != "fuerza_bruta" && valor != "celdas" && valor != "paralelo" && valor != "vecinos")
+            throw std::invalid_argument("Motor de colisiones no válido. Elija 'fuerza_bruta', 'celdas', 'paralelo' o 'vecinos'.");
+        c.motor = valor;
+    } else if (clave == "piel") {
+        c.piel = ComoReal(clave, valor);
+        if (!(c.piel > 0.0)) throw std::invalid_argument("piel debe ser positiva.");
+    } else if (clave == "hilos") {
+        long long v = ComoEntero(clave, valor);
+        if (v < 1) throw std::invalid_argument("El número de hilos debe ser al menos 1.");
+        c.hilos = static_cast<int>(v);
+    } else if (clave == "determinista") {
+        c.determinista = ComoBooleano(clave, valor);
+    } else if (clave == "simd") {
+        if (valor != "auto" && valor != "escalar" && valor != "avx2" && valor != "avx512")
+            throw std::invalid_argument("Nivel SIMD no válido. Elija 'auto', 'escalar', 'avx2' o 'avx512'.");
+        c.simd = valor;
+    } else if (clave == "precision") {
+        if (valor != "doble" && valor != "simple" && valor != "validacion")
+            throw std::invalid_argument("Precisión no válida. Elija 'doble', 'simple' o 'validacion'.");
+        c.precision = valor;
+    } else if (clave == "formato") {
+        if (valor != "texto" && valor != "binario32" && valor != "binario64" && valor != "comprimido" &&
+            valor != "columnar" && valor != "ninguno")
+            throw std::invalid_argument("Formato no válido. Elija 'texto', 'binario32', 'binario64', 'comprimido', 'columnar' o 'ninguno'.");
+        c.formato = valor;
+    } else if (clave == "tolerancia") {
+        c.tolerancia = ComoReal(clave, valor);
+    } else if (clave == "animacion") {
+        if (valor != "ninguna" && valor != "gif" && valor != "ppm")
+            throw std::invalid_argument("Animación no válida. Elija 'ninguna', 'gif' o 'ppm'.");
+        c.animacion = valor;
+    } else if (clave == "pixeles") {
+        long long v = ComoEntero(clave, valor);
+        if (v < 16 || v > 8192) throw std::invalid_argument("pixeles debe estar entre 16 y 8192.");
+        c.pixeles = static_cast<int>(v);
+    } else if (clave == "salida_cada") {
+        long long v = ComoEntero(clave, valor);
+        if (v < 1) throw std::invalid_argument("salida_cada debe ser al menos 1.");
+        c.salida_cada = static_cast<int>(v);
+    } else if (clave == "trazadores") {
+        LeaRangosTrazadores(valor);
+        c.trazadores = valor;
+    } else if (clave == "region") {
+        if (!valor.empty()) LeaRegion(valor);
+        c.region = valor;
+    } else if (clave == "semilla") {
+        long long v = ComoEntero(clave, valor);
+        if (v < 0) throw std::invalid_argument("La semilla no puede ser negativa.");
+        c.semilla = static_cast<std::uint64_t>(v);
+    } else if (clave == "replicas") {
+        long long v = ComoEntero(clave, valor);
+        if (v < 1) throw std::invalid_argument("El número de réplicas debe ser al menos 1.");
+        c.replicas = static_cast<int>(v);
+    } else if (clave == "salida") {
+        c.salida = valor;
+    } else if (clave == "reanude") {
+        c.reanude = valor;
+    } else if (clave == "checkpoint_cada") {
+        long long v = ComoEntero(clave, valor);
+        if (v < 0) throw std::invalid_argument("checkpoint_cada no puede ser negativo.");
+        c.checkpoint_cada = static_cast<int>(v);
+    } else if (clave == "reorden_cada") {
+        long long v = ComoEntero(clave, valor);
+        if (v < 0) throw std::invalid_argument("reorden_cada no puede ser negativo.");
+        c.reorden_cada = static_cast<int>(v);
+    } else if (clave == "resumen_cada") {
+        long long v = ComoEntero(clave, valor);
+        if (v < 0) throw std::invalid_argument("resumen_cada no puede ser negativo.");
+        c.resumen_cada = static_cast<int>(v);
+    } else if (clave == "balance_cada") {
+        long long v = ComoEntero(clave, valor);
+        if (v < 0) throw std::invalid_argument("balance_cada no puede ser negativo.");
+        c.balance_cada = static_cast<int>(v);
+    } else if (clave == "deriva_maxima") {
+        c.deriva_maxima = ComoReal(clave, valor);
+        if (!(c.deriva_maxima >= 0.0)) throw std::invalid_argument("deriva_maxima no puede ser negativa.");
+    } else {
+        throw std::invalid_argument("Parámetro desconocido: " + clave);
+    }
+}
+
+/**
+ * @brief Lee un archivo `clave = valor` (con `barrido clave = v1, v2`).
+ * @param ruta Ruta del archivo.
+ * @param c Configuración.
+ * @param barridos Barridos leídos.
+ */
+void CargueConfiguracion(const std::string& ruta, Configuracion& c, std::vector<Barrido>& barridos) {
+    std::ifstream f(ruta);
+    if (!f)
+        throw std::runtime_error("No se pudo abrir el archivo de configuración: " + ruta);
+
+    std::string linea;
+    int numero = 0;
+    while (std::getline(f, linea)) {
+        ++numero;
+        linea = Recorte(linea.substr(0, linea.find('#')));
+        if (linea.empty()) continue;
+
+        std::size_t igual = linea.find('=');
+        if (igual == std::string::npos)
+            throw std::invalid_argument(ruta + ":" + std::to_string(numero) + ": se esperaba 'clave = valor'.");
+        std::string clave = Recorte(linea.substr(0, igual));
+        std::string valor = Recorte(linea.substr(igual + 1));
+        try {
+            if (clave.rfind("barrido ", 0) == 0)
+                barridos.push_back(LeaBarrido(clave.substr(8), valor));
+            else
+                AsigneParametro(c, clave, valor);
+        } catch (const std::invalid_argument& e) {
+            throw std::invalid_argument(ruta + ":" + std::to_string(numero) + ": " + e.what());
+        }
+    }
+}
+
+/**
+ * @brief Lee las opciones de la línea de comandos en orden.
+ * @param argc,argv Argumentos del programa.
+ * @return Opciones.
+ */
+OpcionesLinea LeaLineaComandos(int argc, char* argv[]) {
+    OpcionesLinea op;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--ayuda" || arg == "-h") {
+            op.ayuda = true;
+            continue;
+        }
+        if (arg.rfind("--", 0) != 0 || i + 1 >= argc)
+            throw std::invalid_argument("Opción no válida o sin valor: " + arg);
+        std::string clave = arg.substr(2);
+        std::string valor = argv[++i];
+
+        if (clave == "config") {
+            CargueConfiguracion(valor, op.base, op.barridos);
+        } else if (clave == "barrido") {
+            std::size_t igual = valor.find('=');
+            if (igual == std::string::npos)
+                throw std::invalid_argument("Se esperaba --barrido clave=v1,v2,...");
+            op.barridos.push_back(LeaBarrido(valor.substr(0, igual), valor.substr(igual + 1)));
+        } else if (clave == "trabajos") {
+            long long v = ComoEntero(clave, valor);
+            if (v < 0) throw std::invalid_argument("El número de trabajos no puede ser negativo.");
+            op.trabajos = static_cast<int>(v);
+        } else {
+            AsigneParametro(op.base, clave, valor);
+        }
+    }
+    return op;
+}
+
+/**
+ * @brief Genera el producto cartesiano de los barridos sobre la configuración base.
+ * @param base Parámetros comunes.
+ * @param barridos Barridos.
+ * @return Una configuración por combinación.
+ */
+std::vector<Configuracion> ExpandaBarridos(const Configuracion& base, const std::vector<Barrido>& barridos) {
+    std::vector<Configuracion> corridas{base};
+    for (const Barrido& b : barridos) {
+        std::vector<Configuracion> siguientes;
+        siguientes.reserve(corridas.size() * b.valores.size());
+        for (const Configuracion& c : corridas) {
+            for (const std::string& v : b.valores) {
+                siguientes.push_back(c);
+                AsigneParametro(siguientes.back(), b.clave, v);
+            }
+        }
+        corridas = std::move(siguientes);
+    }
+    return corridas;
+}
+
+/**
+ * @brief Enumera los parámetros como texto, en el mismo orden que la estructura.
+ * @param c Configuración.
+ */
+std::vector<std::pair<std::string, std::string>> Parametros(const Configuracion& c) {
+    return {
+        {"N", std::to_string(c.N)},
+        {"tf", Texto(c.tf)},
+        {"W", Texto(c.W)},
+        {"H", Texto(c.H)},
+        {"dt_sim", Texto(c.dt_sim)},
+        {"cfl", Texto(c.cfl)},
+        {"dt_frame", Texto(c.dt_frame)},
+        {"m", Texto(c.m)},
+        {"r", Texto(c.r)},
+        {"vmax", Texto(c.vmax)},
+        {"inicial", c.inicial},
+        {"kT", Texto(c.kT)},
+        {"integrador", c.integrador},
+        {"motor", c.motor},
+        {"piel", Texto(c.piel)},
+        {"hilos", std::to_string(c.hilos)},
+        {"determinista", c.determinista ? "si" : "no"},
+        {"simd", c.simd},
+        {"precision", c.precision},
+        {"formato", c.formato},
+        {"tolerancia", Texto(c.tolerancia)},
+        {"animacion", c.animacion},
+        {"pixeles", std::to_string(c.pixeles)},
+        {"salida_cada", std::to_string(c.salida_cada)},
+        {"trazadores", c.trazadores},
+        {"region", c.region},
+        {"semilla", std::to_string(c.semilla)},
+        {"replicas", std::to_string(c.replicas)},
+        {"salida", c.salida},
+        {"reanude", c.reanude},
+        {"checkpoint_cada", std::to_string(c.checkpoint_cada)},
+        {"reorden_cada", std::to_string(c.reorden_cada)},
+        {"resumen_cada", std::to_string(c.resumen_cada)},
+        {"balance_cada", std::to_string(c.balance_cada)},
+        {"deriva_maxima", Texto(c.deriva_maxima)},
+    };
+}
+
+/**
+ * @brief Escribe la configuración como archivo `clave = valor`.
+ * @param f Flujo de salida.
+ * @param c Configuración.
+ */
+void EscribaConfiguracion(std::ostream& f, const Configuracion& c) {
+    for (const auto& [clave, valor] : Parametros(c))
+        if (!valor.empty()) f << clave << " = " << valor << "\n";
+}
+
+/**
+ * @brief Escribe la ayuda de la línea de comandos con los valores por defecto.
+ * @param f Flujo de salida.
+ * @param programa Nombre del ejecutable.
+ */
+void EscribaAyuda(std::ostream& f, const std::string& programa) {
+    f << "Uso: " << programa << " [opciones]\n"
+      << "Sin opciones el programa pregunta los parámetros de forma interactiva.\n\n"
+      << "  --config <archivo>           lee 'clave = valor' (y 'barrido clave = v1, v2')\n"
+      << "  --<clave> <valor>            fija un parámetro\n"
+      << "  --barrido <clave>=v1,v2,...  una corrida por valor (producto de todos los barridos)\n"
+      << "  --trabajos <K>               hilos para corridas o réplicas (0: automático)\n"
+      << "  --ayuda                      muestra esta ayuda\n\n"
+      << "Parámetros y valores por defecto:\n";
+    for (const auto& [clave, valor] : Parametros(Configuracion()))
+        f << "  " << std::left << std::setw(16) << clave << valor << "\n";
+}
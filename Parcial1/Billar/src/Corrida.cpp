@@ -0,0 +1,612 @@
+/**
+ * @file Corrida.cpp
+ * @brief Implementación de las corridas no interactivas y de los barridos en paralelo.
+ */
+
+#include "Corrida.h"
+#include "Sistema.h"
+#include "Trayectoria.h"
+#include "EscritorAsincrono.h"
+#include "Compresion.h"
+#include "Columnar.h"
+#include "Animacion.h"
+#include "Seleccion.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+/** @brief Energía cinética total de las bolas, sumada en double. */
+template <class Real>
+double EnergiaCinetica(const ParticulasT<Real>& P) {
+    double e = 0.0;
+    for (std::size_t i = 0; i < P.Tamano(); ++i) {
+        const double vx = P.vx[i], vy = P.vy[i];
+        e += 0.5 * P.m[i] * (vx * vx + vy * vy);
+    }
+    return e;
+}
+
+/**
+ * @struct Conservadas
+ * @brief Energía y momento de un estado, con la escala Σ m|v| para normalizar el momento.
+ */
+struct Conservadas {
+    double energia = 0.0, px = 0.0, py = 0.0, escala = 0.0;
+};
+
+/** @brief Suma en double la energía, el momento y Σ m|v| de las bolas. */
+template <class Real>
+Conservadas MidaConservadas(const ParticulasT<Real>& P) {
+    Conservadas q;
+    for (std::size_t i = 0; i < P.Tamano(); ++i) {
+        const double vx = P.vx[i], vy = P.vy[i], m = P.m[i];
+        q.energia += 0.5 * m * (vx * vx + vy * vy);
+        q.px += m * vx;
+        q.py += m * vy;
+        q.escala += m * std::sqrt(vx * vx + vy * vy);
+    }
+    return q;
+}
+
+/** @brief Diferencia relativa |b - a| / |a| (0 si ambas son cero). */
+double DiferenciaRelativa(double a, double b) {
+    if (a == b) return 0.0;
+    return std::abs(b - a) / std::max(std::abs(a), std::numeric_limits<double>::min());
+}
+
+/** @brief Indica si el texto es un número JSON válido (para escribir parámetros sin comillas). */
+bool EsNumero(const std::string& s) {
+    if (s.empty()) return false;
+    char* fin = nullptr;
+    std::strtod(s.c_str(), &fin);
+    return *fin == '\0' && s.find_first_not_of("0123456789+-.eE") == std::string::npos;
+}
+
+} // namespace
+
+/**
+ * @brief Crea el escritor de trayectorias del formato pedido.
+ * @param formato Nombre del formato.
+ * @param base Ruta sin extensión.
+ * @param cab Parámetros de la corrida.
+ * @param tolerancia Tolerancia del formato comprimido.
+ * @param ruta Ruta del archivo creado (salida).
+ * @return Escritor, o nulo con el formato "ninguno".
+ */
+std::unique_ptr<Escritor> CreeEscritor(const std::string& formato, const std::string& base,
+                                       const CabeceraTrayectoria& cab, double tolerancia, std::string& ruta) {
+    if (cab.variable && formato != "texto" && formato != "ninguno")
+        throw std::invalid_argument("Con región de salida el número de bolas cambia por cuadro: use formato texto o ninguno.");
+    if (formato == "texto") {
+        ruta = base + ".dat";
+        return std::make_unique<EscritorTexto>(ruta, cab);
+    } else if (formato == "binario32" || formato == "binario64") {
+        ruta = base + ".bin";
+        return std::make_unique<EscritorBinario>(ruta, cab, formato == "binario32" ? 4 : 8);
+    } else if (formato == "comprimido") {
+        ruta = base + ".bcz";
+        return std::make_unique<EscritorComprimido>(ruta, cab, tolerancia);
+    } else if (formato == "columnar") {
+        ruta = base + ".bcol";
+        return std::make_unique<EscritorColumnar>(ruta, cab);
+    } else if (formato != "ninguno") {
+        throw std::invalid_argument("Formato no válido. Elija 'texto', 'binario32', 'binario64', 'comprimido', 'columnar' o 'ninguno'.");
+    }
+    ruta.clear();
+    return nullptr;
+}
+
+/**
+ * @brief Crea el escritor de la animación pedida en la configuración.
+ *
+ * Como el script de Python, con más de 500 cuadros se dibuja uno de cada
+ * cuadros/300. El tono más rojo corresponde al doble de la rapidez típica
+ * inicial (vmax o sqrt(2 kT / m)).
+ *
+ * @param c Parámetros de la corrida.
+ * @param cab Caja, radio y número de bolas.
+ * @param base Ruta sin extensión.
+ * @param ruta Ruta del archivo creado (salida).
+ * @return Escritor, o nulo con animacion = "ninguna".
+ */
+std::unique_ptr<Escritor> CreeAnimacion(const Configuracion& c, const CabeceraTrayectoria& cab,
+                                        const std::string& base, std::string& ruta) {
+    ruta.clear();
+    if (c.animacion == "ninguna") return nullptr;
+    const long cuadros = static_cast<long>(c.tf / cab.dt_frame) + 1;
+    const int muestreo = cuadros > 500 ? static_cast<int>(cuadros / 300) : 1;
+    const double v_tipica = std::max(c.vmax, std::sqrt(2.0 * c.kT / c.m));
+    ruta = base + "." + c.animacion;
+    return std::make_unique<EscritorAnimacion>(ruta, cab, c.animacion, c.pixeles, muestreo, 2.0 * v_tipica);
+}
+
+/**
+ * @brief Calcula la capacidad máxima de bolas en la caja
+ * @param W Ancho de la caja
+ * @param H Alto de la caja
+ * @param r Radio de cada bola
+ * @return Número máximo de bolas que caben en la caja
+ */
+int CalcularCapacidadMaxima(double W, double H, double r) {
+    // Calcula cuántas bolas caben en una disposición de rejilla hexagonal
+    // que es más eficiente que la cuadrada
+    double diametro = 2 * r;
+    int columnas = std::max(1, static_cast<int>((W - r) / diametro));
+    int filas = std::max(1, static_cast<int>((H - r) / (diametro * std::sqrt(3) / 2)));
+
+    return columnas * filas;
+}
+
+/**
+ * @brief Escapa una cadena para JSON, con comillas.
+ * @param s Texto.
+ */
+std::string TextoJson(const std::string& s) {
+    std::string r = "\"";
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') {
+            r += '\\';
+            r += ch;
+        } else if (static_cast<unsigned char>(ch) < 0x20) {
+            char u[8];
+            std::snprintf(u, sizeof(u), "\\u%04x", ch);
+            r += u;
+        } else {
+            r += ch;
+        }
+    }
+    return r + "\"";
+}
+
+/**
+ * @brief Escribe un real en JSON (null si no es finito).
+ * @param v Valor.
+ */
+std::string RealJson(double v) {
+    if (!std::isfinite(v)) return "null";
+    std::ostringstream ss;
+    ss << std::setprecision(10) << v;
+    return ss.str();
+}
+
+/**
+ * @brief Escribe los parámetros como objeto JSON en una sola línea.
+ * @param f Flujo de salida.
+ * @param c Configuración.
+ */
+void EscribaParametrosJson(std::ostream& f, const Configuracion& c) {
+    f << "{";
+    bool primero = true;
+    for (const auto& [clave, valor] : Parametros(c)) {
+        f << (primero ? "" : ", ") << TextoJson(clave) << ": " << (EsNumero(valor) ? valor : TextoJson(valor));
+        primero = false;
+    }
+    f << "}";
+}
+
+/**
+ * @brief Crea el estado inicial (o lo carga del checkpoint) y aplica las opciones de ejecución.
+ * @param sim Sistema vacío.
+ * @param c Parámetros.
+ * @param semilla Semilla de las condiciones iniciales (0: la del sistema).
+ */
+template <class Real>
+void PrepareSistema(SistemaT<Real>& sim, const Configuracion& c, std::uint64_t semilla) {
+    if (!c.reanude.empty()) {
+        sim.CargueCheckpoint(c.reanude);
+    } else {
+        sim.SeleccioneIntegrador(c.integrador);
+        sim.SeleccioneMotorColisiones(c.motor);
+        sim.DefinaCaja(c.W, c.H);
+        sim.Reserve(c.N);
+        if (semilla != 0) sim.DefinaSemilla(semilla);
+        sim.DefinaHilos(c.hilos);
+        if (c.inicial == "maxwell")
+            sim.InicialiceMaxwell(c.m, c.r, c.kT);
+        else
+            sim.InicialiceRejilla(c.m, c.r, c.vmax);
+    }
+    sim.DefinaHilos(c.hilos);
+    sim.DefinaDeterminista(c.determinista);
+    sim.SeleccioneSimd(c.simd);
+    sim.DefinaReorden(c.reorden_cada);
+    sim.DefinaPiel(c.piel);
+}
+
+/**
+ * @brief Pasos de tamaño dt_sim en cada cuadro (al menos uno).
+ * @param c Parámetros.
+ */
+long PasosPorCuadro(const Configuracion& c) {
+    return std::max(1L, std::lround(c.dt_frame / c.dt_sim));
+}
+
+/**
+ * @brief Avanza un cuadro con paso fijo, adaptativo o por eventos.
+ * @param sim Sistema.
+ * @param c Parámetros.
+ * @return Pasos dados.
+ */
+template <class Real>
+long AvanceCuadro(SistemaT<Real>& sim, const Configuracion& c) {
+    if (sim.PorEventos()) {
+        sim.Paso(c.dt_frame); // El motor por eventos salta directo de choque en choque
+        return 1;
+    }
+    if (c.cfl > 0.0)
+        return sim.AvanceAdaptativo(c.dt_frame, c.cfl);
+    const long pasos_por_frame = PasosPorCuadro(c);
+    for (long i = 0; i < pasos_por_frame; ++i)
+        sim.Paso(c.dt_sim);
+    return pasos_por_frame;
+}
+
+/**
+ * @brief Pasos entre muestras de observables para tener una por cuadro.
+ * @param sim Sistema.
+ * @param c Parámetros.
+ */
+template <class Real>
+int IntervaloObservables(const SistemaT<Real>& sim, const Configuracion& c) {
+    // AvanceAdaptativo ya muestrea al final de cada cuadro; 1 solo activa los observables
+    if (sim.PorEventos() || c.cfl > 0.0)
+        return 1;
+    return static_cast<int>(PasosPorCuadro(c));
+}
+
+/**
+ * @brief Límite del histograma de rapideces: tres veces la rapidez típica inicial.
+ *
+ * La rapidez típica es vmax con la rejilla y sqrt(2 kT / m) con Maxwell. Si no es
+ * positiva, o si el estado viene de un checkpoint, se usa la rapidez máxima de las bolas.
+ *
+ * @param sim Sistema ya preparado.
+ * @param c Parámetros.
+ */
+template <class Real>
+double RapidezMaximaHistograma(const SistemaT<Real>& sim, const Configuracion& c) {
+    double v_tipica = 0.0;
+    if (c.reanude.empty())
+        v_tipica = c.inicial == "maxwell" ? std::sqrt(2.0 * c.kT / c.m) : c.vmax;
+    if (!(v_tipica > 0.0)) {
+        const ParticulasT<Real>& P = sim.GetParticulas();
+        for (std::size_t i = 0; i < P.Tamano(); ++i) {
+            const double vx = P.vx[i], vy = P.vy[i];
+            v_tipica = std::max(v_tipica, std::sqrt(vx * vx + vy * vy));
+        }
+    }
+    // Bolas en reposo: cualquier límite positivo sirve
+    return 3.0 * (v_tipica > 0.0 ? v_tipica : 1.0);
+}
+
+#define BILLAR_INSTANCIE_CORRIDA(Real)                                                        \
+    template void PrepareSistema<Real>(SistemaT<Real>&, const Configuracion&, std::uint64_t); \
+    template long AvanceCuadro<Real>(SistemaT<Real>&, const Configuracion&);                  \
+    template int IntervaloObservables<Real>(const SistemaT<Real>&, const Configuracion&);     \
+    template double RapidezMaximaHistograma<Real>(const SistemaT<Real>&, const Configuracion&);
+
+BILLAR_INSTANCIE_CORRIDA(double)
+BILLAR_INSTANCIE_CORRIDA(float)
+#undef BILLAR_INSTANCIE_CORRIDA
+
+namespace {
+
+/**
+ * @brief Cuerpo de EjecuteCorrida para bolas en `Real`.
+ *
+ * Con `precision = validacion` (Real = double) una copia en float parte del mismo
+ * estado y avanza los mismos cuadros; tras cada cuadro se comparan la energía y el
+ * momento de ambas, y al final las temperaturas medias y el chi-cuadrado.
+ *
+ * @param c Parámetros.
+ * @param directorio Directorio de salida.
+ * @param progreso Muestra el avance en la consola.
+ * @return Resultado de la corrida.
+ */
+template <class Real>
+ResultadoCorrida CorraSistema(const Configuracion& c, const std::string& directorio, bool progreso) {
+    ResultadoCorrida res;
+    res.directorio = directorio;
+    try {
+        std::filesystem::create_directories(directorio);
+        {
+            std::ofstream f(directorio + "/parametros.cfg");
+            EscribaConfiguracion(f, c);
+        }
+
+        // --- Sistema: corrida nueva o checkpoint ---
+        // La semilla se fija aquí para que la copia de validación parta del mismo estado.
+        const std::uint64_t semilla =
+            c.semilla != 0 ? c.semilla : static_cast<std::uint64_t>(std::time(nullptr));
+        SistemaT<Real> sim;
+        PrepareSistema(sim, c, semilla);
+        sim.DefinaBalance(c.balance_cada, c.deriva_maxima);
+
+        // --- Copia en float para comparar precisiones ---
+        std::unique_ptr<SistemaT<float>> sombra;
+        std::ofstream archivo_validacion;
+        if (c.precision == "validacion") {
+            sombra = std::make_unique<SistemaT<float>>();
+            PrepareSistema(*sombra, c, semilla);
+            archivo_validacion.open(directorio + "/validacion.dat");
+            archivo_validacion << "# t E_doble E_simple dif_energia dif_momento\n" << std::setprecision(12);
+        }
+
+        const std::size_t N = sim.GetN();
+        const SeleccionSalida seleccion(c.salida_cada, c.trazadores, c.region, N);
+        CabeceraTrayectoria cab;
+        cab.W = sim.GetCaja().GetW();
+        cab.H = sim.GetCaja().GetH();
+        cab.R = N > 0 ? sim.GetParticulas().r[0] : c.r;
+        cab.N = seleccion.GetTrazadores().empty() ? N : seleccion.GetTrazadores().size();
+        cab.ids = seleccion.GetTrazadores();
+        cab.variable = seleccion.Variable();
+        cab.dt_frame = c.dt_frame * c.salida_cada;
+        cab.capacidad = CalcularCapacidadMaxima(cab.W, cab.H, cab.R);
+
+        // --- Salida de trayectorias ---
+        // Una corrida reanudada escribe sus archivos aparte para no pisar los de la corrida original.
+        const std::string sufijo = c.reanude.empty() ? "" : "_reanudada";
+        std::unique_ptr<EscritorAsincrono> escritor;
+        auto destinos = std::make_unique<EscritorMultiple>();
+        destinos->Agregue(CreeEscritor(c.formato, directorio + "/trayectorias" + sufijo, cab, c.tolerancia,
+                                       res.ruta_trayectoria));
+        // La animación y el conteo de la región se escriben en el mismo hilo que la trayectoria.
+        destinos->Agregue(CreeAnimacion(c, cab, directorio + "/animacion" + sufijo, res.ruta_animacion));
+        if (seleccion.Variable()) {
+            res.ruta_conteo = directorio + "/conteo_region" + sufijo + ".dat";
+            destinos->Agregue(std::make_unique<EscritorConteo>(res.ruta_conteo));
+        }
+        if (!cab.ids.empty()) {
+            std::ofstream archivo_ids(directorio + "/trazadores.dat");
+            archivo_ids << "# id de las bolas trazadoras, en el orden de la trayectoria\n";
+            for (std::uint32_t i : cab.ids) archivo_ids << i << "\n";
+        }
+        // La escritura corre en otro hilo; con 4 búferes la simulación solo espera
+        // si el disco se atrasa más de 3 cuadros.
+        if (destinos->Tamano() > 0)
+            escritor = std::make_unique<EscritorAsincrono>(std::move(destinos), 4, cab.N);
+
+        // --- Bucle principal de simulación ---
+        const std::string ruta_checkpoint = directorio + "/checkpoint.bin";
+        // Observables: una muestra por cuadro; la copia en float usa los mismos intervalos del histograma.
+        const double v_histograma = RapidezMaximaHistograma(sim, c);
+        sim.DefinaObservables(IntervaloObservables(sim, c), 60, v_histograma);
+        if (sombra)
+            sombra->DefinaObservables(IntervaloObservables(*sombra, c), 60, v_histograma);
+
+        double t = sim.GetTiempo();
+        res.t_inicial = t;
+        res.energia_inicial = EnergiaCinetica(sim.GetParticulas());
+        auto inicio = std::chrono::steady_clock::now();
+
+        while (t <= c.tf) {
+            if (escritor && seleccion.Escribe(res.cuadros)) {
+                sim.CopieCuadro(escritor->ObtengaLibre(), t, seleccion);
+                escritor->Publique();
+                ++res.cuadros_escritos;
+            }
+            res.pasos += AvanceCuadro(sim, c);
+            t += c.dt_frame;
+            ++res.cuadros;
+            if (sombra) {
+                AvanceCuadro(*sombra, c);
+                const Conservadas a = MidaConservadas(sim.GetParticulas());
+                const Conservadas b = MidaConservadas(sombra->GetParticulas());
+                const double dif_e = DiferenciaRelativa(a.energia, b.energia);
+                const double dif_p = a.escala > 0.0 ? std::hypot(b.px - a.px, b.py - a.py) / a.escala : 0.0;
+                res.validacion_energia = std::max(res.validacion_energia, dif_e);
+                res.validacion_momento = std::max(res.validacion_momento, dif_p);
+                archivo_validacion << sim.GetTiempo() << " " << a.energia << " " << b.energia << " "
+                                   << dif_e << " " << dif_p << "\n";
+            }
+
+            if (c.checkpoint_cada > 0 && res.cuadros % c.checkpoint_cada == 0)
+                sim.GuardeCheckpoint(ruta_checkpoint);
+            if constexpr (INSTRUMENTACION_ACTIVA) {
+                if (c.resumen_cada > 0 && res.cuadros % c.resumen_cada == 0)
+                    sim.GetInstrumentacion().EscribaLinea(std::cerr, t);
+            }
+            if (progreso)
+                std::cout << "\rProgreso: " << std::fixed << std::setprecision(1)
+                          << (t / c.tf) * 100.0 << "%" << std::flush;
+        }
+        if (escritor) {
+            escritor->Cierre();
+            res.segundos_espera_io = escritor->GetSegundosEspera();
+        }
+        res.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        if (progreso) std::cout << "\n";
+
+        sim.GuardeCheckpoint(ruta_checkpoint);
+        if constexpr (INSTRUMENTACION_ACTIVA) {
+            std::ofstream archivo_instr(directorio + "/instrumentacion.json");
+            sim.GetInstrumentacion().EscribaJson(archivo_instr);
+        }
+
+        // --- Observables y resumen ---
+        const Observables& obs = sim.GetObservables();
+        AjusteMaxwell ajuste = obs.AjusteMaxwellBoltzmann();
+        std::ofstream archivo_obs(directorio + "/observables.dat");
+        obs.EscribaResumen(archivo_obs);
+
+        res.t_final = sim.GetTiempo();
+        // Balance: la última resincronización da la deriva final; el impulso en las paredes
+        // se acumuló durante los pasos, así que la presión no requiere trabajo extra.
+        sim.ResincroniceBalance();
+        const BalanceConservado& balance = sim.GetBalance();
+        res.impulso_izquierda = balance.impulso.izquierda;
+        res.impulso_derecha = balance.impulso.derecha;
+        res.impulso_abajo = balance.impulso.abajo;
+        res.impulso_arriba = balance.impulso.arriba;
+        const double lapso = res.t_final - balance.t_inicial;
+        if (lapso > 0.0)
+            res.presion = balance.impulso.Total() / (2.0 * (cab.W + cab.H) * lapso);
+        res.energia_final = EnergiaCinetica(sim.GetParticulas());
+        res.temperatura = obs.GetTemperatura().GetMedia();
+        res.chi2_maxwell = ajuste.chi2;
+        if (N > 0 && res.temperatura > 0.0)
+            res.compresibilidad = res.presion * cab.W * cab.H / (static_cast<double>(N) * res.temperatura);
+        res.deriva_energia = balance.deriva_energia;
+        res.deriva_momento = balance.deriva_momento;
+        res.resincronizaciones = balance.resincronizaciones;
+        res.alarmas_deriva = balance.alarmas;
+        res.grados_maxwell = ajuste.grados;
+        if (sim.PorEventos()) res.eventos = sim.GetEventos().GetEventos();
+        if (sombra) {
+            const Observables& obs_simple = sombra->GetObservables();
+            res.validacion_temperatura = DiferenciaRelativa(res.temperatura, obs_simple.GetTemperatura().GetMedia());
+            res.validacion_chi2 = DiferenciaRelativa(ajuste.chi2, obs_simple.AjusteMaxwellBoltzmann().chi2);
+        }
+        res.construcciones_vecinos = sim.GetVecinos().GetConstrucciones();
+        res.vecinos_por_bola = sim.GetVecinos().GetLargoMedio(N);
+        const Acumulador& dt_usados = sim.GetPasosAdaptativos();
+        if (dt_usados.GetN() > 0) {
+            res.dt_medio = dt_usados.GetMedia();
+            res.dt_minimo = dt_usados.GetMinimo();
+            res.dt_maximo = dt_usados.GetMaximo();
+        }
+        if (res.segundos > 0.0)
+            res.bolas_pasos_por_segundo = static_cast<double>(N) * res.pasos / res.segundos;
+        res.exito = true;
+    } catch (const std::exception& e) {
+        res.error = e.what();
+    }
+    return res;
+}
+
+} // namespace
+
+/**
+ * @brief Arma el sistema, avanza hasta tf y escribe las salidas de la corrida.
+ *
+ * `precision = simple` corre el sistema en float; `doble` y `validacion` en double.
+ *
+ * @param c Parámetros.
+ * @param directorio Directorio de salida.
+ * @param progreso Muestra el avance en la consola.
+ * @return Resultado de la corrida.
+ */
+ResultadoCorrida EjecuteCorrida(const Configuracion& c, const std::string& directorio, bool progreso) {
+    if (c.precision == "simple")
+        return CorraSistema<float>(c, directorio, progreso);
+    return CorraSistema<double>(c, directorio, progreso);
+}
+
+/**
+ * @brief Reparte las corridas entre `trabajos` hilos; cada hilo toma la siguiente libre.
+ * @param corridas Configuraciones.
+ * @param trabajos Corridas simultáneas.
+ * @return Resultados en el orden de `corridas`.
+ */
+std::vector<ResultadoCorrida> EjecuteBarrido(const std::vector<Configuracion>& corridas, int trabajos) {
+    std::vector<ResultadoCorrida> resultados(corridas.size());
+    std::atomic<std::size_t> siguiente{0};
+    std::mutex mtx_consola;
+
+    auto Trabajador = [&]() {
+        for (std::size_t k = siguiente++; k < corridas.size(); k = siguiente++) {
+            const Configuracion& c = corridas[k];
+            std::string dir = c.salida;
+            if (corridas.size() > 1) {
+                char nombre[32];
+                std::snprintf(nombre, sizeof(nombre), "/corrida_%03zu", k);
+                dir += nombre;
+            }
+            resultados[k] = EjecuteCorrida(c, dir);
+
+            std::lock_guard<std::mutex> lock(mtx_consola);
+            const ResultadoCorrida& r = resultados[k];
+            std::cout << "[" << k + 1 << "/" << corridas.size() << "] " << dir << ": ";
+            if (r.exito)
+                std::cout << std::fixed << std::setprecision(2) << r.segundos << " s, "
+                          << std::scientific << std::setprecision(3) << r.bolas_pasos_por_segundo
+                          << " bolas*pasos/s" << std::defaultfloat << "\n";
+            else
+                std::cout << "ERROR: " << r.error << "\n";
+        }
+    };
+
+    const int n = std::max(1, std::min<int>(trabajos, static_cast<int>(corridas.size())));
+    std::vector<std::thread> hilos;
+    for (int h = 1; h < n; ++h)
+        hilos.emplace_back(Trabajador);
+    Trabajador();
+    for (std::thread& h : hilos)
+        h.join();
+    return resultados;
+}
+
+/**
+ * @brief Escribe un objeto JSON con una entrada por corrida (parámetros y resultados).
+ * @param f Flujo de salida.
+ * @param corridas Configuraciones.
+ * @param resultados Resultados.
+ */
+void EscribaResumenJson(std::ostream& f, const std::vector<Configuracion>& corridas,
+                        const std::vector<ResultadoCorrida>& resultados) {
+    f << "{\n  \"corridas\": [\n";
+    for (std::size_t k = 0; k < corridas.size(); ++k) {
+        const ResultadoCorrida& r = resultados[k];
+        f << "    {\n      \"parametros\": ";
+        EscribaParametrosJson(f, corridas[k]);
+        f << ",\n"
+          << "      \"exito\": " << (r.exito ? "true" : "false") << ",\n"
+          << "      \"error\": " << TextoJson(r.error) << ",\n"
+          << "      \"directorio\": " << TextoJson(r.directorio) << ",\n"
+          << "      \"trayectoria\": " << TextoJson(r.ruta_trayectoria) << ",\n"
+          << "      \"animacion\": " << TextoJson(r.ruta_animacion) << ",\n"
+          << "      \"conteo_region\": " << TextoJson(r.ruta_conteo) << ",\n"
+          << "      \"segundos\": " << RealJson(r.segundos) << ",\n"
+          << "      \"segundos_espera_io\": " << RealJson(r.segundos_espera_io) << ",\n"
+          << "      \"pasos\": " << r.pasos << ",\n"
+          << "      \"cuadros\": " << r.cuadros << ",\n"
+          << "      \"cuadros_escritos\": " << r.cuadros_escritos << ",\n"
+          << "      \"eventos\": " << r.eventos << ",\n"
+          << "      \"bolas_pasos_por_segundo\": " << RealJson(r.bolas_pasos_por_segundo) << ",\n"
+          << "      \"t_inicial\": " << RealJson(r.t_inicial) << ",\n"
+          << "      \"t_final\": " << RealJson(r.t_final) << ",\n"
+          << "      \"energia_inicial\": " << RealJson(r.energia_inicial) << ",\n"
+          << "      \"energia_final\": " << RealJson(r.energia_final) << ",\n"
+          << "      \"temperatura\": " << RealJson(r.temperatura) << ",\n"
+          << "      \"chi2_maxwell\": " << RealJson(r.chi2_maxwell) << ",\n"
+          << "      \"grados_maxwell\": " << r.grados_maxwell << ",\n"
+          << "      \"dt_medio\": " << RealJson(r.dt_medio) << ",\n"
+          << "      \"dt_minimo\": " << RealJson(r.dt_minimo) << ",\n"
+          << "      \"dt_maximo\": " << RealJson(r.dt_maximo) << ",\n"
+          << "      \"construcciones_vecinos\": " << r.construcciones_vecinos << ",\n"
+          << "      \"vecinos_por_bola\": " << RealJson(r.vecinos_por_bola) << ",\n"
+          << "      \"validacion_energia\": " << RealJson(r.validacion_energia) << ",\n"
+          << "      \"validacion_momento\": " << RealJson(r.validacion_momento) << ",\n"
+          << "      \"validacion_temperatura\": " << RealJson(r.validacion_temperatura) << ",\n"
+          << "      \"validacion_chi2\": " << RealJson(r.validacion_chi2) << ",\n"
+          << "      \"impulso_izquierda\": " << RealJson(r.impulso_izquierda) << ",\n"
+          << "      \"impulso_derecha\": " << RealJson(r.impulso_derecha) << ",\n"
+          << "      \"impulso_abajo\": " << RealJson(r.impulso_abajo) << ",\n"
+          << "      \"impulso_arriba\": " << RealJson(r.impulso_arriba) << ",\n"
+          << "      \"presion\": " << RealJson(r.presion) << ",\n"
+          << "      \"compresibilidad\": " << RealJson(r.compresibilidad) << ",\n"
+          << "      \"deriva_energia\": " << RealJson(r.deriva_energia) << ",\n"
+          << "      \"deriva_momento\": " << RealJson(r.deriva_momento) << ",\n"
+          << "      \"resincronizaciones\": " << r.resincronizaciones << ",\n"
+          << "      \"alarmas_deriva\": " << r.alarmas_deriva << "\n"
+          << "    }" << (k + 1 < corridas.size() ? "," : "") << "\n";
+    }
+    f << "  ]\n}\n";
+}
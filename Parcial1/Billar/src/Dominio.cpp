@@ -0,0 +1,386 @@
+/**
+ * @file Dominio.cpp
+ * @brief Implementación de la descomposición de la caja en franjas, una por rango MPI.
+ */
+
+#include "Dominio.h"
+#include "Bola.h"
+#include "Reordenamiento.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/** @brief Reales por bola en los mensajes de migración y de fantasmas (x, y, vx, vy, m, 1/m, r, id). */
+constexpr std::size_t CAMPOS_BOLA = 8;
+
+/** @brief Reales por fantasma devuelto (índice, x, y, vx, vy). */
+constexpr std::size_t CAMPOS_DEVUELTO = 5;
+
+/**
+ * @brief Agrega al final de P las bolas de un búfer empaquetado con Dominio::Empaque.
+ * @param P Bolas.
+ * @param buffer Bolas empaquetadas.
+ */
+void Agregue(ParticulasT<double>& P, const std::vector<double>& buffer) {
+    for (std::size_t k = 0; k + CAMPOS_BOLA <= buffer.size(); k += CAMPOS_BOLA) {
+        P.x.push_back(buffer[k]);
+        P.y.push_back(buffer[k + 1]);
+        P.vx.push_back(buffer[k + 2]);
+        P.vy.push_back(buffer[k + 3]);
+        P.m.push_back(buffer[k + 4]);
+        P.inv_m.push_back(buffer[k + 5]);
+        P.r.push_back(buffer[k + 6]);
+        P.id.push_back(static_cast<std::uint32_t>(buffer[k + 7]));
+    }
+}
+
+/**
+ * @brief Conserva solo las primeras n bolas, sin tocar sus identificadores.
+ * @param P Bolas.
+ * @param n Bolas que quedan.
+ */
+void Recorte(ParticulasT<double>& P, std::size_t n) {
+    P.x.resize(n);
+    P.y.resize(n);
+    P.vx.resize(n);
+    P.vy.resize(n);
+    P.m.resize(n);
+    P.inv_m.resize(n);
+    P.r.resize(n);
+    P.id.resize(n);
+}
+
+} // namespace
+
+/**
+ * @brief Asigna la franja propia.
+ *
+ * La franja k cubre [k W / P, (k + 1) W / P). Las bolas fuera de la caja (posibles
+ * con paredes simples) pertenecen a la franja del extremo más cercano.
+ *
+ * @param C Caja completa.
+ * @param integrador "verlet" o "euler".
+ * @param comm Comunicador.
+ * @throws std::invalid_argument Si el integrador no es válido.
+ */
+Dominio::Dominio(const Caja& C, const std::string& integrador, MPI_Comm comm)
+    : comunicador(comm), caja(C) {
+    if (integrador == "verlet")
+        espejo = true;
+    else if (integrador == "euler")
+        espejo = false;
+    else
+        throw std::invalid_argument("El dominio MPI solo admite los integradores 'verlet' y 'euler'.");
+
+    MPI_Comm_rank(comunicador, &rango);
+    MPI_Comm_size(comunicador, &rangos);
+    izquierda = rango > 0 ? rango - 1 : MPI_PROC_NULL;
+    derecha = rango < rangos - 1 ? rango + 1 : MPI_PROC_NULL;
+    x0 = caja.GetW() * rango / rangos;
+    x1 = caja.GetW() * (rango + 1) / rangos;
+}
+
+/**
+ * @brief Toma las bolas propias, calcula el halo y arma las rejillas.
+ * @param propias Bolas con x en [GetDesde(), GetHasta()).
+ * @throws std::invalid_argument Si las franjas son más angostas que el halo.
+ */
+void Dominio::Cargue(ParticulasT<double> propias) {
+    double r_max = 0.0;
+    for (double r : propias.r)
+        r_max = std::max(r_max, r);
+    MPI_Allreduce(MPI_IN_PLACE, &r_max, 1, MPI_DOUBLE, MPI_MAX, comunicador);
+    halo = 2.0 * r_max;
+    if (rangos > 1 && x1 - x0 < halo)
+        throw std::invalid_argument("Las franjas (ancho W/P) son más angostas que el diámetro de las bolas; use menos rangos.");
+
+    if (halo > 0.0) {
+        Caja franja, banda;
+        franja.Defina(x1 - x0, caja.GetH());
+        banda.Defina(2.0 * halo, caja.GetH());
+        celdas.Defina(franja, halo, x0);
+        celdas_borde.Defina(banda, halo, x1 - halo);
+    }
+    bolas = std::move(propias);
+}
+
+/**
+ * @brief Agrega al búfer los campos de la bola i.
+ * @param i Bola.
+ * @param buffer Búfer de envío.
+ */
+void Dominio::Empaque(std::size_t i, std::vector<double>& buffer) const {
+    buffer.insert(buffer.end(), {bolas.x[i], bolas.y[i], bolas.vx[i], bolas.vy[i],
+                                 bolas.m[i], bolas.inv_m[i], bolas.r[i],
+                                 static_cast<double>(bolas.id[i])});
+}
+
+/**
+ * @brief Envía `a_izquierda` y `a_derecha` a los vecinos y recibe `de_derecha` y `de_izquierda`.
+ *
+ * Primero se intercambian los tamaños y luego los datos, siempre con MPI_Sendrecv
+ * para que no haya bloqueos mutuos. Con un vecino MPI_PROC_NULL el mensaje se omite
+ * y el búfer recibido queda vacío.
+ */
+void Dominio::Intercambie() {
+    const double inicio = MPI_Wtime();
+    int enviados[2] = {static_cast<int>(a_izquierda.size()), static_cast<int>(a_derecha.size())};
+    int recibidos[2] = {0, 0};
+    MPI_Sendrecv(&enviados[0], 1, MPI_INT, izquierda, 0, &recibidos[1], 1, MPI_INT, derecha, 0,
+                 comunicador, MPI_STATUS_IGNORE);
+    MPI_Sendrecv(&enviados[1], 1, MPI_INT, derecha, 1, &recibidos[0], 1, MPI_INT, izquierda, 1,
+                 comunicador, MPI_STATUS_IGNORE);
+    de_izquierda.resize(recibidos[0]);
+    de_derecha.resize(recibidos[1]);
+    MPI_Sendrecv(a_izquierda.data(), enviados[0], MPI_DOUBLE, izquierda, 2,
+                 de_derecha.data(), recibidos[1], MPI_DOUBLE, derecha, 2, comunicador, MPI_STATUS_IGNORE);
+    MPI_Sendrecv(a_derecha.data(), enviados[1], MPI_DOUBLE, derecha, 3,
+                 de_izquierda.data(), recibidos[0], MPI_DOUBLE, izquierda, 3, comunicador, MPI_STATUS_IGNORE);
+    contadores.segundos_comunicacion += MPI_Wtime() - inicio;
+}
+
+/**
+ * @brief Envía a cada vecino las bolas que salieron de la franja y recibe las que entraron.
+ *
+ * Las bolas que quedan conservan su orden relativo; las que llegan se agregan al final,
+ * primero las del vecino izquierdo.
+ *
+ * @throws std::runtime_error Si una bola recibida tampoco cae en esta franja.
+ */
+void Dominio::Migre() {
+    a_izquierda.clear();
+    a_derecha.clear();
+    const std::size_t n = bolas.Tamano();
+    std::size_t quedan = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double x = bolas.x[i];
+        if (x < x0 && izquierda != MPI_PROC_NULL) {
+            Empaque(i, a_izquierda);
+        } else if (x >= x1 && derecha != MPI_PROC_NULL) {
+            Empaque(i, a_derecha);
+        } else {
+            if (quedan != i) {
+                bolas.x[quedan] = bolas.x[i];
+                bolas.y[quedan] = bolas.y[i];
+                bolas.vx[quedan] = bolas.vx[i];
+                bolas.vy[quedan] = bolas.vy[i];
+                bolas.m[quedan] = bolas.m[i];
+                bolas.inv_m[quedan] = bolas.inv_m[i];
+                bolas.r[quedan] = bolas.r[i];
+                bolas.id[quedan] = bolas.id[i];
+            }
+            ++quedan;
+        }
+    }
+    Recorte(bolas, quedan);
+    Intercambie();
+    Agregue(bolas, de_izquierda);
+    Agregue(bolas, de_derecha);
+    contadores.migraciones += (de_izquierda.size() + de_derecha.size()) / CAMPOS_BOLA;
+
+    for (std::size_t i = quedan; i < bolas.Tamano(); ++i) {
+        const double x = bolas.x[i];
+        if ((x < x0 && izquierda != MPI_PROC_NULL) || (x >= x1 && derecha != MPI_PROC_NULL))
+            throw std::runtime_error("Una bola cruzó más de una franja en un paso; reduzca dt_sim o use menos rangos.");
+    }
+}
+
+/**
+ * @brief Resuelve los choques que cruzan los bordes entre los rangos k y k + 1 con k de la paridad dada.
+ *
+ * El rango derecho envía como fantasmas las bolas a menos de un halo de su borde
+ * izquierdo. El rango izquierdo copia en `borde` sus bolas a menos de un halo de su
+ * borde derecho, agrega los fantasmas y prueba cada par (propia, fantasma) en una
+ * rejilla de dos columnas. Luego devuelve el estado final de los fantasmas que
+ * cambiaron, y el dueño lo copia sobre sus bolas.
+ *
+ * @param paridad 0 para los bordes 0-1, 2-3, ...; 1 para los bordes 1-2, 3-4, ...
+ */
+void Dominio::ResuelvaBorde(int paridad) {
+    const bool soy_izquierdo = rango % 2 == paridad && derecha != MPI_PROC_NULL;
+    const bool soy_derecho = rango % 2 != paridad && izquierda != MPI_PROC_NULL;
+
+    // 1. El rango derecho envía sus fantasmas.
+    a_izquierda.clear();
+    a_derecha.clear();
+    enviadas.clear();
+    if (soy_derecho) {
+        for (std::size_t i = 0; i < bolas.Tamano(); ++i) {
+            if (bolas.x[i] < x0 + halo) {
+                enviadas.push_back(static_cast<std::uint32_t>(i));
+                Empaque(i, a_izquierda);
+            }
+        }
+    }
+    Intercambie();
+
+    // 2. El rango izquierdo resuelve los pares (propia, fantasma).
+    a_izquierda.clear();
+    a_derecha.clear();
+    if (soy_izquierdo && !de_derecha.empty()) {
+        Recorte(borde, 0);
+        zona.clear();
+        for (std::size_t i = 0; i < bolas.Tamano(); ++i) {
+            if (bolas.x[i] >= x1 - halo) {
+                zona.push_back(static_cast<std::uint32_t>(i));
+                borde.x.push_back(bolas.x[i]);
+                borde.y.push_back(bolas.y[i]);
+                borde.vx.push_back(bolas.vx[i]);
+                borde.vy.push_back(bolas.vy[i]);
+                borde.m.push_back(bolas.m[i]);
+                borde.inv_m.push_back(bolas.inv_m[i]);
+                borde.r.push_back(bolas.r[i]);
+                borde.id.push_back(bolas.id[i]);
+            }
+        }
+        const int n_zona = static_cast<int>(zona.size());
+        Agregue(borde, de_derecha);
+        contadores.fantasmas += de_derecha.size() / CAMPOS_BOLA;
+
+        celdas_borde.Construya(borde);
+        std::uint64_t pruebas = 0;
+        for (int i = 0; i < n_zona; ++i) {
+            Bola bi(borde, i);
+            celdas_borde.RecorraVecinas(i, [&](int j) {
+                if (j >= n_zona) {
+                    bi.ChoqueElastico(Bola(borde, j));
+                    ++pruebas;
+                }
+            });
+        }
+        contadores.pruebas_pares += pruebas;
+
+        for (int a = 0; a < n_zona; ++a) {
+            const std::size_t i = zona[a];
+            bolas.x[i] = borde.x[a];
+            bolas.y[i] = borde.y[a];
+            bolas.vx[i] = borde.vx[a];
+            bolas.vy[i] = borde.vy[a];
+        }
+        for (std::size_t k = 0; n_zona + k < borde.Tamano(); ++k) {
+            const std::size_t g = n_zona + k;
+            const double* original = &de_derecha[k * CAMPOS_BOLA];
+            if (borde.x[g] != original[0] || borde.y[g] != original[1] ||
+                borde.vx[g] != original[2] || borde.vy[g] != original[3])
+                a_derecha.insert(a_derecha.end(), {static_cast<double>(k), borde.x[g], borde.y[g],
+                                                   borde.vx[g], borde.vy[g]});
+        }
+    }
+
+    // 3. El dueño recibe el estado final de sus bolas que chocaron con el vecino.
+    Intercambie();
+    for (std::size_t k = 0; k + CAMPOS_DEVUELTO <= de_izquierda.size(); k += CAMPOS_DEVUELTO) {
+        const std::size_t i = enviadas[static_cast<std::size_t>(de_izquierda[k])];
+        bolas.x[i] = de_izquierda[k + 1];
+        bolas.y[i] = de_izquierda[k + 2];
+        bolas.vx[i] = de_izquierda[k + 3];
+        bolas.vy[i] = de_izquierda[k + 4];
+    }
+}
+
+/**
+ * @brief Avanza un paso del dominio.
+ *
+ * El orden es el del paso fijo de Sistema: movimiento y paredes (con la caja global),
+ * luego choques. Entre ambos migran las bolas que cambiaron de franja. Con un solo
+ * rango el resultado es idéntico al de Sistema con el motor de celdas.
+ *
+ * @param dt Paso de tiempo.
+ */
+void Dominio::Paso(double dt) {
+    if (espejo)
+        MuevaYResuelvaParedes<true>(bolas, caja, dt, nivel_simd);
+    else
+        MuevaYResuelvaParedes<false>(bolas, caja, dt, nivel_simd);
+
+    if (rangos > 1)
+        Migre();
+    if (halo > 0.0) {
+        celdas.Construya(bolas);
+        contadores.pruebas_pares += celdas.ResuelvaChoques(bolas).pruebas;
+        if (rangos > 1) {
+            ResuelvaBorde(0);
+            ResuelvaBorde(1);
+        }
+    }
+
+    tiempo += dt;
+    ++contadores.pasos;
+    if (intervalo_reorden > 0 && contadores.pasos % intervalo_reorden == 0 && bolas.Tamano() > 1 && halo > 0.0) {
+        OrdenMorton(bolas, caja.GetW(), caja.GetH(), halo, orden);
+        PermuteParticulas(bolas, orden);
+    }
+}
+
+/**
+ * @brief Reúne (id, x, y, vx, vy) de todas las bolas en el rango 0 con MPI_Gatherv.
+ *
+ * Cada id debe llegar exactamente una vez: una bola perdida o duplicada entre rangos
+ * dejaría en el cuadro los valores de otro instante.
+ *
+ * @param c Cuadro de salida (solo en el rango 0).
+ * @param t Instante del cuadro.
+ */
+void Dominio::Reuna(Cuadro& c, double t) {
+    constexpr int CAMPOS_CUADRO = 5;
+    a_izquierda.clear();
+    for (std::size_t i = 0; i < bolas.Tamano(); ++i)
+        a_izquierda.insert(a_izquierda.end(), {static_cast<double>(bolas.id[i]),
+                                               bolas.x[i], bolas.y[i], bolas.vx[i], bolas.vy[i]});
+    const int enviados = static_cast<int>(a_izquierda.size());
+    std::vector<int> conteos(rango == 0 ? rangos : 0), desplazamientos;
+    MPI_Gather(&enviados, 1, MPI_INT, conteos.data(), 1, MPI_INT, 0, comunicador);
+    if (rango == 0) {
+        desplazamientos.assign(rangos, 0);
+        for (int k = 1; k < rangos; ++k)
+            desplazamientos[k] = desplazamientos[k - 1] + conteos[k - 1];
+        de_izquierda.resize(desplazamientos.back() + conteos.back());
+    }
+    MPI_Gatherv(a_izquierda.data(), enviados, MPI_DOUBLE, de_izquierda.data(), conteos.data(),
+                desplazamientos.data(), MPI_DOUBLE, 0, comunicador);
+    if (rango != 0) return;
+
+    c.t = t;
+    if (de_izquierda.size() != CAMPOS_CUADRO * c.Tamano())
+        throw std::runtime_error("El cuadro reunido no tiene todas las bolas.");
+    std::vector<unsigned char> visto(c.Tamano(), 0);
+    for (std::size_t k = 0; k + CAMPOS_CUADRO <= de_izquierda.size(); k += CAMPOS_CUADRO) {
+        const std::size_t id = static_cast<std::size_t>(de_izquierda[k]);
+        if (id >= c.Tamano())
+            throw std::runtime_error("Identificador de bola fuera de rango al reunir el cuadro.");
+        if (visto[id]++)
+            throw std::runtime_error("Bola " + std::to_string(id) + " repetida al reunir el cuadro.");
+        c.x[id] = de_izquierda[k + 1];
+        c.y[id] = de_izquierda[k + 2];
+        c.vx[id] = de_izquierda[k + 3];
+        c.vy[id] = de_izquierda[k + 4];
+    }
+}
+
+/** @brief Suma de 0.5 m v² de las bolas propias de todos los rangos. */
+double Dominio::EnergiaTotal() const {
+    double e = 0.0;
+    for (std::size_t i = 0; i < bolas.Tamano(); ++i)
+        e += 0.5 * bolas.m[i] * (bolas.vx[i] * bolas.vx[i] + bolas.vy[i] * bolas.vy[i]);
+    double total = 0.0;
+    MPI_Allreduce(&e, &total, 1, MPI_DOUBLE, MPI_SUM, comunicador);
+    return total;
+}
+
+/** @brief Suma de las bolas propias de todos los rangos. */
+std::uint64_t Dominio::NTotal() const {
+    std::uint64_t n = bolas.Tamano(), total = 0;
+    MPI_Allreduce(&n, &total, 1, MPI_UINT64_T, MPI_SUM, comunicador);
+    return total;
+}
+
+/** @brief Máximo de bolas propias entre los rangos sobre el promedio (1: reparto perfecto). */
+double Dominio::Desbalance() const {
+    const double n = static_cast<double>(bolas.Tamano());
+    double maximo = 0.0, suma = 0.0;
+    MPI_Allreduce(&n, &maximo, 1, MPI_DOUBLE, MPI_MAX, comunicador);
+    MPI_Allreduce(&n, &suma, 1, MPI_DOUBLE, MPI_SUM, comunicador);
+    return suma > 0.0 ? maximo * rangos / suma : 1.0;
+}
@@ -0,0 +1,317 @@
+/**
+ * @file Ensamble.cpp
+ * @brief Implementación del ensamble de réplicas y de su reducción ordenada.
+ */
+
+#include "Ensamble.h"
+#include "Corrida.h"
+#include "Sistema.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+/**
+ * @struct ResumenReplica
+ * @brief Promedios temporales de una réplica, listos para incorporarse al ensamble.
+ */
+struct ResumenReplica {
+    bool exito = false;
+    std::string error;
+    long pasos = 0;
+    double energia = 0.0;
+    double temperatura = 0.0;
+    double px = 0.0;
+    double py = 0.0;
+    double chi2 = 0.0;
+    Histograma rapideces;
+};
+
+/** @brief Cuantil 0.975 de la t de Student con `grados` grados de libertad. */
+double CuantilStudent(std::uint64_t grados) {
+    static const double tabla[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if (grados >= 1 && grados <= 30) return tabla[grados - 1];
+    // Desarrollo de Cornish–Fisher alrededor del cuantil normal.
+    const double z = 1.959963984540054;
+    const double v = static_cast<double>(grados);
+    const double z3 = z * z * z, z5 = z3 * z * z;
+    return z + (z3 + z) / (4.0 * v) + (5.0 * z5 + 16.0 * z3 + 3.0 * z) / (96.0 * v * v);
+}
+
+/**
+ * @brief Avanza una réplica hasta tf sin escribir nada y resume sus observables.
+ * @tparam Real Tipo de las bolas.
+ * @param c Parámetros comunes.
+ * @param semilla Semilla de la réplica.
+ */
+template <class Real>
+ResumenReplica EjecuteReplicaCon(const Configuracion& c, std::uint64_t semilla) {
+    ResumenReplica r;
+    try {
+        SistemaT<Real> sim;
+        PrepareSistema(sim, c, semilla);
+        sim.DefinaObservables(IntervaloObservables(sim, c), 60, RapidezMaximaHistograma(sim, c));
+
+        for (double t = sim.GetTiempo(); t <= c.tf; t += c.dt_frame)
+            r.pasos += AvanceCuadro(sim, c);
+
+        const Observables& obs = sim.GetObservables();
+        r.energia = obs.GetEnergia().GetMedia();
+        r.temperatura = obs.GetTemperatura().GetMedia();
+        r.px = obs.GetPx().GetMedia();
+        r.py = obs.GetPy().GetMedia();
+        r.chi2 = obs.AjusteMaxwellBoltzmann().chi2;
+        r.rapideces = obs.GetRapideces();
+        r.exito = true;
+    } catch (const std::exception& e) {
+        r.error = e.what();
+    }
+    return r;
+}
+
+/**
+ * @brief Réplica en float con `precision = simple`; en double con `doble` y `validacion`
+ * (en un ensamble la validación no agrega una copia por réplica).
+ */
+ResumenReplica EjecuteReplica(const Configuracion& c, std::uint64_t semilla) {
+    if (c.precision == "simple")
+        return EjecuteReplicaCon<float>(c, semilla);
+    return EjecuteReplicaCon<double>(c, semilla);
+}
+
+/** @brief Incorpora una réplica al resultado del ensamble. */
+void Incorpore(ResultadoEnsamble& res, std::size_t k, const ResumenReplica& r) {
+    res.pasos += r.pasos;
+    if (!r.exito) {
+        res.errores.push_back("réplica " + std::to_string(k) + ": " + r.error);
+        return;
+    }
+    ++res.completas;
+    res.energia.Agregue(r.energia);
+    res.temperatura.Agregue(r.temperatura);
+    res.px.Agregue(r.px);
+    res.py.Agregue(r.py);
+    res.chi2_maxwell.Agregue(r.chi2);
+    res.rapideces.Sume(r.rapideces);
+}
+
+/** @brief Escribe una línea `nombre media error inferior superior` del resumen. */
+void EscribaIntervalo(std::ostream& f, const char* nombre, const Acumulador& a) {
+    Intervalo iv = IntervaloConfianza(a);
+    f << std::left << std::setw(14) << nombre << std::right << " " << iv.media << " " << iv.error
+      << " " << iv.inferior << " " << iv.superior << "\n";
+}
+
+/** @brief Escribe un intervalo como objeto JSON. */
+void EscribaIntervaloJson(std::ostream& f, const Acumulador& a) {
+    Intervalo iv = IntervaloConfianza(a);
+    f << "{\"media\": " << RealJson(iv.media) << ", \"error\": " << RealJson(iv.error)
+      << ", \"inferior\": " << RealJson(iv.inferior) << ", \"superior\": " << RealJson(iv.superior) << "}";
+}
+
+} // namespace
+
+/**
+ * @brief Deriva la semilla de la réplica k con SplitMix64.
+ * @param base Semilla base.
+ * @param k Índice de la réplica.
+ */
+std::uint64_t SemillaReplica(std::uint64_t base, std::size_t k) {
+    std::uint64_t z = base + 0x9E3779B97F4A7C15ULL * (static_cast<std::uint64_t>(k) + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return z != 0 ? z : 1;
+}
+
+/**
+ * @brief Media, error estándar e intervalo del 95 % de los valores por réplica.
+ * @param a Acumulador.
+ */
+Intervalo IntervaloConfianza(const Acumulador& a) {
+    Intervalo iv;
+    iv.n = a.GetN();
+    iv.media = a.GetMedia();
+    if (iv.n > 1)
+        iv.error = a.GetDesviacion() / std::sqrt(static_cast<double>(iv.n));
+    const double ancho = iv.n > 1 ? CuantilStudent(iv.n - 1) * iv.error : 0.0;
+    iv.inferior = iv.media - ancho;
+    iv.superior = iv.media + ancho;
+    return iv;
+}
+
+/**
+ * @brief Reparte las réplicas entre hilos y las reduce en orden de índice.
+ *
+ * Cada hilo toma la siguiente réplica libre. Al terminar una réplica se guarda
+ * aparte y se incorporan todas las que ya forman un prefijo consecutivo, así solo
+ * esperan en memoria las que terminaron antes que alguna anterior.
+ *
+ * @param c Parámetros comunes.
+ * @param hilos Hilos de trabajo (0: todos los núcleos).
+ */
+ResultadoEnsamble EjecuteEnsamble(const Configuracion& c, int hilos) {
+    if (!c.reanude.empty())
+        throw std::invalid_argument("Un ensamble no puede reanudar un checkpoint: todas las réplicas serían iguales.");
+
+    ResultadoEnsamble res;
+    res.replicas = static_cast<std::size_t>(std::max(c.replicas, 1));
+    res.semilla = c.semilla != 0 ? c.semilla
+                                 : static_cast<std::uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+    if (hilos <= 0) hilos = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    res.hilos = std::min<int>(hilos, static_cast<int>(res.replicas));
+
+    std::atomic<std::size_t> siguiente{0};
+    std::mutex mtx;
+    std::map<std::size_t, ResumenReplica> pendientes; ///< Réplicas terminadas fuera de orden.
+    std::size_t proxima = 0;                          ///< Próxima réplica a incorporar.
+
+    auto Trabajador = [&]() {
+        for (std::size_t k = siguiente++; k < res.replicas; k = siguiente++) {
+            ResumenReplica r = EjecuteReplica(c, SemillaReplica(res.semilla, k));
+
+            std::lock_guard<std::mutex> lock(mtx);
+            pendientes.emplace(k, std::move(r));
+            for (auto it = pendientes.find(proxima); it != pendientes.end(); it = pendientes.find(proxima)) {
+                Incorpore(res, proxima, it->second);
+                pendientes.erase(it);
+                ++proxima;
+            }
+        }
+    };
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::vector<std::thread> trabajadores;
+    for (int h = 1; h < res.hilos; ++h)
+        trabajadores.emplace_back(Trabajador);
+    Trabajador();
+    for (std::thread& h : trabajadores)
+        h.join();
+    res.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    if (res.segundos > 0.0)
+        res.bolas_pasos_por_segundo = static_cast<double>(c.N) * res.pasos / res.segundos;
+    return res;
+}
+
+/**
+ * @brief Ejecuta los ensambles de un barrido y escribe `ensamble.dat` en cada directorio.
+ * @param corridas Configuraciones.
+ * @param hilos Hilos de cada ensamble.
+ * @return Resultados en el orden de `corridas`.
+ */
+std::vector<ResultadoEnsamble> EjecuteEnsambles(const std::vector<Configuracion>& corridas, int hilos) {
+    std::vector<ResultadoEnsamble> resultados(corridas.size());
+    for (std::size_t k = 0; k < corridas.size(); ++k) {
+        const Configuracion& c = corridas[k];
+        std::string dir = c.salida;
+        if (corridas.size() > 1) {
+            char nombre[32];
+            std::snprintf(nombre, sizeof(nombre), "/corrida_%03zu", k);
+            dir += nombre;
+        }
+        ResultadoEnsamble& r = resultados[k];
+        try {
+            r = EjecuteEnsamble(c, hilos);
+        } catch (const std::exception& e) {
+            r.replicas = static_cast<std::size_t>(c.replicas);
+            r.errores.push_back(e.what());
+        }
+        r.directorio = dir;
+
+        std::filesystem::create_directories(dir);
+        {
+            std::ofstream f(dir + "/parametros.cfg");
+            EscribaConfiguracion(f, c);
+        }
+        std::ofstream f(dir + "/ensamble.dat");
+        EscribaResumenEnsamble(f, r);
+
+        Intervalo T = IntervaloConfianza(r.temperatura);
+        std::cout << "[" << k + 1 << "/" << corridas.size() << "] " << dir << ": " << r.completas << "/"
+                  << r.replicas << " réplicas en " << std::fixed << std::setprecision(2) << r.segundos
+                  << " s con " << r.hilos << " hilo(s), T = " << std::setprecision(6) << T.media << " ± "
+                  << T.superior - T.media << std::defaultfloat << "\n";
+        for (const std::string& e : r.errores)
+            std::cout << "  ERROR: " << e << "\n";
+    }
+    return resultados;
+}
+
+/**
+ * @brief Escribe las medias con sus intervalos y el histograma de rapideces normalizado.
+ * @param f Flujo de salida.
+ * @param r Resultado del ensamble.
+ */
+void EscribaResumenEnsamble(std::ostream& f, const ResultadoEnsamble& r) {
+    f << std::scientific << std::setprecision(6);
+    f << "# REPLICAS: " << r.completas << " de " << r.replicas << "\n";
+    f << "# SEMILLA: " << r.semilla << "\n";
+    f << "# HILOS: " << r.hilos << "\n";
+    f << "# SEGUNDOS: " << r.segundos << "\n";
+    f << "# observable media error_estandar ic95_inferior ic95_superior\n";
+    EscribaIntervalo(f, "energia", r.energia);
+    EscribaIntervalo(f, "temperatura", r.temperatura);
+    EscribaIntervalo(f, "px", r.px);
+    EscribaIntervalo(f, "py", r.py);
+    EscribaIntervalo(f, "chi2_maxwell", r.chi2_maxwell);
+
+    const Histograma& h = r.rapideces;
+    if (h.Total() == 0) return;
+    f << "\n# v densidad (todas las réplicas)\n";
+    const double norma = 1.0 / (static_cast<double>(h.Total()) * h.Ancho());
+    for (std::size_t b = 0; b < h.Bins(); ++b)
+        f << (b + 0.5) * h.Ancho() << " " << h.Cuenta(b) * norma << "\n";
+}
+
+/**
+ * @brief Escribe un objeto JSON con una entrada por ensamble.
+ * @param f Flujo de salida.
+ * @param corridas Configuraciones.
+ * @param resultados Resultados.
+ */
+void EscribaResumenEnsamblesJson(std::ostream& f, const std::vector<Configuracion>& corridas,
+                                 const std::vector<ResultadoEnsamble>& resultados) {
+    f << "{\n  \"ensambles\": [\n";
+    for (std::size_t k = 0; k < corridas.size(); ++k) {
+        const ResultadoEnsamble& r = resultados[k];
+        f << "    {\n      \"parametros\": ";
+        EscribaParametrosJson(f, corridas[k]);
+        f << ",\n      \"errores\": [";
+        for (std::size_t e = 0; e < r.errores.size(); ++e)
+            f << (e ? ", " : "") << TextoJson(r.errores[e]);
+        f << "],\n"
+          << "      \"directorio\": " << TextoJson(r.directorio) << ",\n"
+          << "      \"replicas\": " << r.replicas << ",\n"
+          << "      \"completas\": " << r.completas << ",\n"
+          << "      \"semilla\": " << r.semilla << ",\n"
+          << "      \"hilos\": " << r.hilos << ",\n"
+          << "      \"segundos\": " << RealJson(r.segundos) << ",\n"
+          << "      \"bolas_pasos_por_segundo\": " << RealJson(r.bolas_pasos_por_segundo) << ",\n"
+          << "      \"energia\": ";
+        EscribaIntervaloJson(f, r.energia);
+        f << ",\n      \"temperatura\": ";
+        EscribaIntervaloJson(f, r.temperatura);
+        f << ",\n      \"px\": ";
+        EscribaIntervaloJson(f, r.px);
+        f << ",\n      \"py\": ";
+        EscribaIntervaloJson(f, r.py);
+        f << ",\n      \"chi2_maxwell\": ";
+        EscribaIntervaloJson(f, r.chi2_maxwell);
+        f << "\n    }" << (k + 1 < corridas.size() ? "," : "") << "\n";
+    }
+    f << "  ]\n}\n";
+}
@@ -0,0 +1,136 @@
+/**
+ * @file EscritorAsincrono.cpp
+ * @brief Implementación del escritor de trayectorias en segundo plano.
+ */
+
+#include "EscritorAsincrono.h"
+#include <chrono>
+#include <stdexcept>
+
+/**
+ * @brief Preasigna los búferes y arranca el hilo escritor.
+ * @param destino_ Escritor de destino.
+ * @param num_buferes Número de búferes (al menos 2).
+ * @param N Número de bolas por cuadro.
+ */
+EscritorAsincrono::EscritorAsincrono(std::unique_ptr<Escritor> destino_, std::size_t num_buferes, std::size_t N)
+    : destino(std::move(destino_)), pool(num_buferes) {
+    if (!destino)
+        throw std::invalid_argument("El escritor asíncrono necesita un escritor de destino.");
+    if (num_buferes < 2)
+        throw std::invalid_argument("El escritor asíncrono necesita al menos 2 búferes.");
+    for (std::size_t k = 0; k < pool.size(); ++k) {
+        pool[k].Redimensione(N);
+        libres.push_back(k);
+    }
+    hilo = std::thread(&EscritorAsincrono::Trabaje, this);
+}
+
+/** @brief Cierra el escritor si no se cerró antes; los errores se descartan. */
+EscritorAsincrono::~EscritorAsincrono() {
+    try {
+        Cierre();
+    } catch (...) {
+    }
+}
+
+/**
+ * @brief Bucle del hilo escritor: toma búferes llenos en orden y los escribe.
+ *
+ * La escritura ocurre fuera del candado, así el hilo de simulación puede
+ * tomar y publicar otros búferes mientras tanto.
+ */
+void EscritorAsincrono::Trabaje() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        hay_lleno.wait(lock, [this] { return !llenos.empty() || terminar; });
+        if (llenos.empty()) break; // terminar y sin pendientes
+
+        std::size_t k = llenos.front();
+        llenos.pop_front();
+        lock.unlock();
+        try {
+            if (!error) destino->Escriba(pool[k]);
+        } catch (...) {
+            lock.lock();
+            if (!error) error = std::current_exception();
+            lock.unlock();
+        }
+        lock.lock();
+        libres.push_back(k);
+        hay_libre.notify_one();
+    }
+}
+
+/** @brief Relanza el primer error del hilo escritor. */
+void EscritorAsincrono::RevisarError() {
+    std::exception_ptr e;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        e = error;
+    }
+    if (e) std::rethrow_exception(e);
+}
+
+/**
+ * @brief Entrega un búfer libre; si no hay, espera y acumula el tiempo de espera.
+ * @return Cuadro a llenar.
+ */
+Cuadro& EscritorAsincrono::ObtengaLibre() {
+    RevisarError();
+    std::unique_lock<std::mutex> lock(mtx);
+    if (cerrado)
+        throw std::logic_error("El escritor asíncrono ya está cerrado.");
+    if (tomado)
+        throw std::logic_error("Hay un búfer entregado que no se ha publicado.");
+    if (libres.empty()) {
+        auto t0 = std::chrono::steady_clock::now();
+        hay_libre.wait(lock, [this] { return !libres.empty(); });
+        segundos_espera += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        ++esperas;
+    }
+    actual = libres.front();
+    libres.pop_front();
+    tomado = true;
+    return pool[actual];
+}
+
+/** @brief Pone en cola el búfer entregado. */
+void EscritorAsincrono::Publique() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!tomado)
+            throw std::logic_error("No hay un búfer entregado para publicar.");
+        llenos.push_back(actual);
+        tomado = false;
+    }
+    hay_lleno.notify_one();
+}
+
+/**
+ * @brief Copia el cuadro en un búfer libre y lo publica.
+ * @param c Cuadro a escribir.
+ */
+void EscritorAsincrono::Escriba(const Cuadro& c) {
+    Cuadro& b = ObtengaLibre();
+    b.t = c.t;
+    b.x.assign(c.x.begin(), c.x.end());
+    b.y.assign(c.y.begin(), c.y.end());
+    b.vx.assign(c.vx.begin(), c.vx.end());
+    b.vy.assign(c.vy.begin(), c.vy.end());
+    Publique();
+}
+
+/** @brief Vacía la cola, detiene el hilo escritor y cierra el destino. */
+void EscritorAsincrono::Cierre() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (cerrado) return;
+        cerrado = true;
+        terminar = true;
+    }
+    hay_lleno.notify_one();
+    if (hilo.joinable()) hilo.join();
+    destino->Cierre();
+    RevisarError();
+}
@@ -0,0 +1,220 @@
+/**
+ * @file Eventos.cpp
+ * @brief Implementación del motor de dinámica molecular dirigido por eventos.
+ */
+
+#include "Eventos.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Avanza una bola en vuelo libre hasta el instante actual del motor.
+ * @param bolas Bolas del sistema.
+ * @param i Índice de la bola.
+ */
+void MotorEventos::Sincronice(Particulas& bolas, int i) {
+    Bola(bolas, i).Muevase(t - t_bola[i]);
+    t_bola[i] = t;
+}
+
+/** @brief Inserta la bola i al inicio de la lista de su celda. */
+void MotorEventos::Inserte(int i) {
+    int c = cy[i] * nx + cx[i];
+    ant[i] = -1;
+    sig[i] = cabeza[c];
+    if (cabeza[c] >= 0) ant[cabeza[c]] = i;
+    cabeza[c] = i;
+}
+
+/** @brief Retira la bola i de la lista de su celda. */
+void MotorEventos::Retire(int i) {
+    int c = cy[i] * nx + cx[i];
+    if (ant[i] >= 0) sig[ant[i]] = sig[i];
+    else cabeza[c] = sig[i];
+    if (sig[i] >= 0) ant[sig[i]] = ant[i];
+}
+
+/**
+ * @brief Predice el próximo cruce de celda de la bola i en un eje.
+ * @param b Bola i, sincronizada.
+ * @param i Índice de la bola.
+ * @param eje_x Eje del cruce.
+ */
+void MotorEventos::PredigaCruce(const Bola& b, int i, bool eje_x) {
+    double v = eje_x ? b.Getvx() : b.Getvy();
+    double p = eje_x ? b.Getx() : b.Gety();
+    double lado = eje_x ? lx : ly;
+    int c = eje_x ? cx[i] : cy[i];
+    int n = eje_x ? nx : ny;
+
+    double dt;
+    if (v > 0 && c < n - 1) dt = ((c + 1) * lado - p) / v;
+    else if (v < 0 && c > 0) dt = (c * lado - p) / v;
+    else return;
+
+    cola.push({t + std::max(0.0, dt), i, -1, choques[i], 0, eje_x ? Tipo::CeldaX : Tipo::CeldaY});
+}
+
+/**
+ * @brief Predice los choques de la bola i con las bolas de su celda y de las celdas vecinas.
+ * @param bolas Bolas del sistema.
+ * @param i Índice de la bola, sincronizada.
+ */
+void MotorEventos::PredigaVecinos(Particulas& bolas, int i) {
+    for (int ey = std::max(cy[i] - 1, 0); ey <= std::min(cy[i] + 1, ny - 1); ++ey) {
+        for (int ex = std::max(cx[i] - 1, 0); ex <= std::min(cx[i] + 1, nx - 1); ++ex) {
+            for (int k = cabeza[ey * nx + ex]; k >= 0; k = sig[k]) {
+                if (k == i) continue;
+                Sincronice(bolas, k);
+                double dt = Bola(bolas, i).TiempoChoque(Bola(bolas, k));
+                if (std::isfinite(dt))
+                    cola.push({t + dt, i, k, choques[i], choques[k], Tipo::Bola});
+            }
+        }
+    }
+}
+
+/**
+ * @brief Predice todos los eventos futuros de la bola i.
+ *
+ * Se llama cuando cambia la velocidad de la bola: paredes, cruces de celda
+ * en ambos ejes y choques con las bolas vecinas.
+ *
+ * @param bolas Bolas del sistema.
+ * @param i Índice de la bola, sincronizada.
+ */
+void MotorEventos::Prediga(Particulas& bolas, int i) {
+    const Bola b(bolas, i);
+    double tx = b.TiempoPared(caja, true);
+    double ty = b.TiempoPared(caja, false);
+    if (std::isfinite(tx)) cola.push({t + tx, i, -1, choques[i], 0, Tipo::ParedX});
+    if (std::isfinite(ty)) cola.push({t + ty, i, -1, choques[i], 0, Tipo::ParedY});
+    PredigaCruce(b, i, true);
+    PredigaCruce(b, i, false);
+    PredigaVecinos(bolas, i);
+}
+
+/**
+ * @brief Descarta la cola y vuelve a predecir todos los eventos.
+ *
+ * La invalidación perezosa deja eventos obsoletos en la cola; reconstruirla
+ * de vez en cuando limita la memoria sin alterar la dinámica.
+ *
+ * @param bolas Bolas del sistema.
+ */
+void MotorEventos::Reconstruya(Particulas& bolas) {
+    cola = decltype(cola)();
+    const int N = static_cast<int>(bolas.Tamano());
+    for (int i = 0; i < N; ++i)
+        Sincronice(bolas, i);
+    for (int i = 0; i < N; ++i)
+        Prediga(bolas, i);
+}
+
+/**
+ * @brief Prepara la rejilla y predice los eventos iniciales.
+ * @param bolas Bolas del sistema.
+ * @param C Caja de la simulación.
+ */
+void MotorEventos::Inicie(Particulas& bolas, const Caja& C) {
+    const int N = static_cast<int>(bolas.Tamano());
+    caja = C;
+
+    double r_max = 0.0;
+    for (int i = 0; i < N; ++i)
+        r_max = std::max(r_max, bolas.r[i]);
+    double lado = (r_max > 0) ? 2.0 * r_max : std::max(C.GetW(), C.GetH());
+    nx = std::max(1, static_cast<int>(C.GetW() / lado));
+    ny = std::max(1, static_cast<int>(C.GetH() / lado));
+    lx = C.GetW() / nx;
+    ly = C.GetH() / ny;
+
+    t = 0.0;
+    t_bola.assign(N, 0.0);
+    choques.assign(N, 0);
+    cx.resize(N);
+    cy.resize(N);
+    sig.resize(N);
+    ant.resize(N);
+    cabeza.assign(static_cast<size_t>(nx) * ny, -1);
+
+    for (int i = 0; i < N; ++i) {
+        cx[i] = std::clamp(static_cast<int>(bolas.x[i] / lx), 0, nx - 1);
+        cy[i] = std::clamp(static_cast<int>(bolas.y[i] / ly), 0, ny - 1);
+        Inserte(i);
+    }
+    Reconstruya(bolas);
+}
+
+/**
+ * @brief Procesa en orden todos los eventos hasta t + dt.
+ *
+ * Los eventos obsoletos (contadores distintos) se descartan al salir de la cola.
+ * Al final todas las bolas quedan sincronizadas en t + dt para poder guardarlas.
+ *
+ * @param bolas Bolas del sistema.
+ * @param dt Intervalo de tiempo a avanzar.
+ * @return Impulso recibido por cada pared.
+ */
+ImpulsoParedes MotorEventos::Avance(Particulas& bolas, double dt) {
+    const double t_fin = t + dt;
+    ImpulsoParedes impulso;
+
+    while (!cola.empty() && cola.top().t <= t_fin) {
+        Evento e = cola.top();
+        cola.pop();
+        if (choques[e.i] != e.ci) continue;
+        if (e.tipo == Tipo::Bola && choques[e.j] != e.cj) continue;
+
+        t = std::max(t, e.t);
+        Bola b(bolas, e.i);
+        Sincronice(bolas, e.i);
+        ++eventos;
+
+        switch (e.tipo) {
+        case Tipo::Bola:
+            Sincronice(bolas, e.j);
+            b.ChoqueContacto(Bola(bolas, e.j));
+            ++choques[e.i];
+            ++choques[e.j];
+            ++choques_bolas;
+            Prediga(bolas, e.i);
+            Prediga(bolas, e.j);
+            break;
+        case Tipo::ParedX:
+            (b.Getvx() < 0 ? impulso.izquierda : impulso.derecha) += 2.0 * bolas.m[e.i] * std::fabs(b.Getvx());
+            b.ReboteX();
+            ++choques[e.i];
+            Prediga(bolas, e.i);
+            break;
+        case Tipo::ParedY:
+            (b.Getvy() < 0 ? impulso.abajo : impulso.arriba) += 2.0 * bolas.m[e.i] * std::fabs(b.Getvy());
+            b.ReboteY();
+            ++choques[e.i];
+            Prediga(bolas, e.i);
+            break;
+        case Tipo::CeldaX:
+            Retire(e.i);
+            cx[e.i] += (b.Getvx() > 0) ? 1 : -1;
+            Inserte(e.i);
+            PredigaCruce(b, e.i, true);
+            PredigaVecinos(bolas, e.i);
+            break;
+        case Tipo::CeldaY:
+            Retire(e.i);
+            cy[e.i] += (b.Getvy() > 0) ? 1 : -1;
+            Inserte(e.i);
+            PredigaCruce(b, e.i, false);
+            PredigaVecinos(bolas, e.i);
+            break;
+        }
+    }
+
+    t = t_fin;
+    for (int i = 0; i < static_cast<int>(bolas.Tamano()); ++i)
+        Sincronice(bolas, i);
+
+    if (cola.size() > 32 * bolas.Tamano() + 1024)
+        Reconstruya(bolas);
+    return impulso;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file Instrumentacion.cpp
+ * @brief Implementación de los informes de la instrumentación por fases.
+ */
+
+#include "Instrumentacion.h"
+#include <iomanip>
+
+/**
+ * @brief Nombre corto de la fase, usado en la línea de resumen y en el JSON.
+ * @param f Fase.
+ */
+const char* NombreFase(Fase f) {
+    switch (f) {
+        case Fase::Movimiento: return "movimiento";
+        case Fase::Paredes: return "paredes";
+        case Fase::Celdas: return "celdas";
+        case Fase::Choques: return "choques";
+        case Fase::Eventos: return "eventos";
+        case Fase::Observables: return "observables";
+        case Fase::Salida: return "salida";
+        default: return "?";
+    }
+}
+
+/**
+ * @brief Suma de los tiempos de todas las fases.
+ */
+double Instrumentacion::SegundosTotales() const {
+    double total = 0.0;
+    for (double s : segundos)
+        total += s;
+    return total;
+}
+
+/**
+ * @brief Línea de resumen: porcentaje por fase, ns por bola y paso, y contadores por paso.
+ * @param f Flujo de salida.
+ * @param t Tiempo simulado.
+ */
+void Instrumentacion::EscribaLinea(std::ostream& f, double t) const {
+    const double total = SegundosTotales();
+    const double p = pasos > 0 ? static_cast<double>(pasos) : 1.0;
+    f << std::fixed << std::setprecision(3) << "t=" << t << " pasos=" << pasos << std::setprecision(1);
+    for (int k = 0; k < NUM_FASES; ++k)
+        if (llamadas[k] > 0)
+            f << " " << NombreFase(static_cast<Fase>(k)) << "=" << (total > 0 ? 100.0 * segundos[k] / total : 0.0) << "%";
+    f << std::setprecision(2)
+      << " ns/bola/paso=" << (N > 0 ? 1e9 * total / (p * N) : 0.0)
+      << " pares/paso=" << choques.pruebas / p
+      << " contactos/paso=" << choques.contactos / p
+      << " rebotes/paso=" << rebotes_pared / p;
+    if (choques_eventos > 0)
+        f << " choques_eventos/paso=" << choques_eventos / p;
+    f << std::defaultfloat << "\n";
+}
+
+/**
+ * @brief Informe JSON con tiempos, llamadas y contadores totales y por paso.
+ * @param f Flujo de salida.
+ */
+void Instrumentacion::EscribaJson(std::ostream& f) const {
+    const double p = pasos > 0 ? static_cast<double>(pasos) : 1.0;
+    f << std::setprecision(10)
+      << "{\n  \"activa\": " << (INSTRUMENTACION_ACTIVA ? "true" : "false") << ",\n"
+      << "  \"N\": " << N << ",\n"
+      << "  \"pasos\": " << pasos << ",\n"
+      << "  \"segundos\": " << SegundosTotales() << ",\n"
+      << "  \"fases\": {\n";
+    for (int k = 0; k < NUM_FASES; ++k) {
+        f << "    \"" << NombreFase(static_cast<Fase>(k)) << "\": {\"segundos\": " << segundos[k]
+          << ", \"llamadas\": " << llamadas[k] << ", \"ns_por_paso\": " << 1e9 * segundos[k] / p << "}"
+          << (k + 1 < NUM_FASES ? "," : "") << "\n";
+    }
+    f << "  },\n"
+      << "  \"pares_probados\": " << choques.pruebas << ",\n"
+      << "  \"contactos\": " << choques.contactos << ",\n"
+      << "  \"impulsos\": " << choques.impulsos << ",\n"
+      << "  \"correcciones\": " << choques.correcciones << ",\n"
+      << "  \"rebotes_pared\": " << rebotes_pared << ",\n"
+      << "  \"choques_eventos\": " << choques_eventos << ",\n"
+      << "  \"por_paso\": {\"pares_probados\": " << choques.pruebas / p
+      << ", \"contactos\": " << choques.contactos / p << ", \"impulsos\": " << choques.impulsos / p
+      << ", \"correcciones\": " << choques.correcciones / p << ", \"rebotes_pared\": " << rebotes_pared / p << "}\n"
+      << "}\n";
+}
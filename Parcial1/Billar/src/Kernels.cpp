@@ -0,0 +1,844 @@
+/**
+ * @file Kernels.cpp
+ * @brief Implementación de los núcleos escalares, AVX2 y AVX-512 para movimiento y paredes.
+ *
+ * Cada versión vectorial evalúa exactamente las mismas operaciones, en el mismo orden,
+ * que la escalar; las ramas se reemplazan por máscaras y mezclas (blend). Este archivo
+ * se compila con -ffp-contract=off para que el compilador no fusione productos y sumas
+ * en FMA, lo que rompería la igualdad bit a bit entre caminos.
+ *
+ * Los núcleos públicos se instancian para double y float. Las versiones escalares son
+ * plantillas; las vectoriales tienen una sobrecarga por tipo (4/8 dobles u 8/16
+ * flotantes por registro).
+ */
+
+#include "Kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define BILLAR_X86 1
+#else
+#define BILLAR_X86 0
+#endif
+
+// ==========================================================
+//                     VERSIÓN ESCALAR
+// ==========================================================
+
+template <class T>
+static void MuevaEscalar(T* x, T* y, const T* vx, const T* vy,
+                         T dt, std::size_t i0, std::size_t n) {
+    for (std::size_t i = i0; i < n; ++i) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+}
+
+/** @brief Impulso 2 m |v| que recibe la pared al reflejarse la componente v de una bola. */
+template <class T>
+static inline double Impulso(T masa, T v) {
+    return 2.0 * static_cast<double>(masa) * std::fabs(static_cast<double>(v));
+}
+
+/** @brief Suma el impulso de los carriles marcados en `bits`, en orden de carril (el de las bolas). */
+template <class T>
+static inline void SumeImpulsos(const T* v, const T* masa, unsigned bits, double& acumulado) {
+    for (int k = 0; bits != 0; ++k, bits >>= 1)
+        if (bits & 1u) acumulado += Impulso(masa[k], v[k]);
+}
+
+template <class T>
+static void ParedesSimpleEscalar(const T* x, const T* y, T* vx, T* vy,
+                                 const T* r, const T* masa, T W, T H,
+                                 std::size_t i0, std::size_t n, ImpulsoParedes& imp) {
+    for (std::size_t i = i0; i < n; ++i) {
+        if (x[i] - r[i] < 0 && vx[i] < 0) {
+            imp.izquierda += Impulso(masa[i], vx[i]);
+            vx[i] *= -1;
+        }
+        if (x[i] + r[i] > W && vx[i] > 0) {
+            imp.derecha += Impulso(masa[i], vx[i]);
+            vx[i] *= -1;
+        }
+        if (y[i] - r[i] < 0 && vy[i] < 0) {
+            imp.abajo += Impulso(masa[i], vy[i]);
+            vy[i] *= -1;
+        }
+        if (y[i] + r[i] > H && vy[i] > 0) {
+            imp.arriba += Impulso(masa[i], vy[i]);
+            vy[i] *= -1;
+        }
+    }
+}
+
+template <class T>
+static void ParedesRobustoEscalar(T* x, T* y, T* vx, T* vy,
+                                  const T* r, const T* masa, T W, T H,
+                                  std::size_t i0, std::size_t n, ImpulsoParedes& imp) {
+    for (std::size_t i = i0; i < n; ++i) {
+        if (x[i] - r[i] < 0 && vx[i] < 0) {
+            x[i] = r[i] + (r[i] - x[i]);
+            imp.izquierda += Impulso(masa[i], vx[i]);
+            vx[i] *= -1;
+        }
+        if (x[i] + r[i] > W && vx[i] > 0) {
+            x[i] = W - r[i] - (x[i] + r[i] - W);
+            imp.derecha += Impulso(masa[i], vx[i]);
+            vx[i] *= -1;
+        }
+        if (y[i] - r[i] < 0 && vy[i] < 0) {
+            y[i] = r[i] + (r[i] - y[i]);
+            imp.abajo += Impulso(masa[i], vy[i]);
+            vy[i] *= -1;
+        }
+        if (y[i] + r[i] > H && vy[i] > 0) {
+            y[i] = H - r[i] - (y[i] + r[i] - H);
+            imp.arriba += Impulso(masa[i], vy[i]);
+            vy[i] *= -1;
+        }
+    }
+}
+
+/**
+ * @brief Mueve una bola y aplica sus rebotes en la misma pasada.
+ *
+ * Hace exactamente las mismas operaciones que MuevaEscalar seguido de
+ * ParedesSimpleEscalar o ParedesRobustoEscalar, así que da los mismos bits.
+ */
+template <bool Espejo, class T>
+static void MuevaYParedesEscalar(T* x, T* y, T* vx, T* vy, const T* r, const T* masa,
+                                 T dt, T W, T H, std::size_t i0, std::size_t n, ImpulsoParedes& imp) {
+    for (std::size_t i = i0; i < n; ++i) {
+        T px = x[i] + vx[i] * dt;
+        T py = y[i] + vy[i] * dt;
+        const T ri = r[i];
+        if (px - ri < 0 && vx[i] < 0) {
+            if constexpr (Espejo) px = ri + (ri - px);
+            imp.izquierda += Impulso(masa[i], vx[i]);
+            vx[i] *= -1;
+        }
+        if (px + ri > W && vx[i] > 0) {
+            if constexpr (Espejo) px = W - ri - (px + ri - W);
+            imp.derecha += Impulso(masa[i], vx[i]);
+            vx[i] *= -1;
+        }
+        if (py - ri < 0 && vy[i] < 0) {
+            if constexpr (Espejo) py = ri + (ri - py);
+            imp.abajo += Impulso(masa[i], vy[i]);
+            vy[i] *= -1;
+        }
+        if (py + ri > H && vy[i] > 0) {
+            if constexpr (Espejo) py = H - ri - (py + ri - H);
+            imp.arriba += Impulso(masa[i], vy[i]);
+            vy[i] *= -1;
+        }
+        x[i] = px;
+        y[i] = py;
+    }
+}
+
+#if BILLAR_X86
+
+// ==========================================================
+//                     VERSIÓN AVX2 (4 bolas)
+// ==========================================================
+
+__attribute__((target("avx2")))
+static void MuevaAVX2(double* x, double* y, const double* vx, const double* vy,
+                      double dt, std::size_t n) {
+    const __m256d vdt = _mm256_set1_pd(dt);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d px = _mm256_loadu_pd(x + i);
+        __m256d py = _mm256_loadu_pd(y + i);
+        px = _mm256_add_pd(px, _mm256_mul_pd(_mm256_loadu_pd(vx + i), vdt));
+        py = _mm256_add_pd(py, _mm256_mul_pd(_mm256_loadu_pd(vy + i), vdt));
+        _mm256_storeu_pd(x + i, px);
+        _mm256_storeu_pd(y + i, py);
+    }
+    MuevaEscalar(x, y, vx, vy, dt, i, n);
+}
+
+/** @brief Suma el impulso de los carriles de `v` marcados en `bits`. */
+__attribute__((target("avx2")))
+static inline void SumeImpulsosAVX2(__m256d v, const double* masa, unsigned bits, double& acumulado) {
+    alignas(32) double q[4];
+    _mm256_store_pd(q, v);
+    SumeImpulsos(q, masa, bits, acumulado);
+}
+
+/**
+ * @brief Refleja una componente contra la pared inferior (0) y superior (L) sin saltos.
+ *
+ * Si `espejo` es verdadero también corrige la posición, como en el método robusto.
+ */
+__attribute__((target("avx2")))
+static inline void ParedEjeAVX2(__m256d& p, __m256d& v, __m256d r, __m256d L, bool espejo,
+                                const double* masa, double& bajo, double& alto) {
+    const __m256d cero = _mm256_setzero_pd();
+    const __m256d menos_uno = _mm256_set1_pd(-1.0);
+
+    __m256d m = _mm256_and_pd(_mm256_cmp_pd(_mm256_sub_pd(p, r), cero, _CMP_LT_OQ),
+                              _mm256_cmp_pd(v, cero, _CMP_LT_OQ));
+    if (const unsigned bits = _mm256_movemask_pd(m)) SumeImpulsosAVX2(v, masa, bits, bajo);
+    if (espejo)
+        p = _mm256_blendv_pd(p, _mm256_add_pd(r, _mm256_sub_pd(r, p)), m);
+    v = _mm256_blendv_pd(v, _mm256_mul_pd(v, menos_uno), m);
+
+    m = _mm256_and_pd(_mm256_cmp_pd(_mm256_add_pd(p, r), L, _CMP_GT_OQ),
+                      _mm256_cmp_pd(v, cero, _CMP_GT_OQ));
+    if (const unsigned bits = _mm256_movemask_pd(m)) SumeImpulsosAVX2(v, masa, bits, alto);
+    if (espejo)
+        p = _mm256_blendv_pd(p, _mm256_sub_pd(_mm256_sub_pd(L, r),
+                                              _mm256_sub_pd(_mm256_add_pd(p, r), L)), m);
+    v = _mm256_blendv_pd(v, _mm256_mul_pd(v, menos_uno), m);
+}
+
+__attribute__((target("avx2")))
+static void ParedesAVX2(double* x, double* y, double* vx, double* vy, const double* r,
+                        const double* masa, double W, double H, std::size_t n, bool espejo,
+                        ImpulsoParedes& imp) {
+    const __m256d vW = _mm256_set1_pd(W);
+    const __m256d vH = _mm256_set1_pd(H);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d px = _mm256_loadu_pd(x + i), py = _mm256_loadu_pd(y + i);
+        __m256d qx = _mm256_loadu_pd(vx + i), qy = _mm256_loadu_pd(vy + i);
+        __m256d rr = _mm256_loadu_pd(r + i);
+        ParedEjeAVX2(px, qx, rr, vW, espejo, masa + i, imp.izquierda, imp.derecha);
+        ParedEjeAVX2(py, qy, rr, vH, espejo, masa + i, imp.abajo, imp.arriba);
+        if (espejo) {
+            _mm256_storeu_pd(x + i, px);
+            _mm256_storeu_pd(y + i, py);
+        }
+        _mm256_storeu_pd(vx + i, qx);
+        _mm256_storeu_pd(vy + i, qy);
+    }
+    if (espejo) ParedesRobustoEscalar(x, y, vx, vy, r, masa, W, H, i, n, imp);
+    else ParedesSimpleEscalar(x, y, vx, vy, r, masa, W, H, i, n, imp);
+}
+
+/** @brief Movimiento y paredes en una sola pasada, con los datos en registros. */
+template <bool Espejo>
+__attribute__((target("avx2")))
+static void MuevaYParedesAVX2(double* x, double* y, double* vx, double* vy, const double* r,
+                              const double* masa, double dt, double W, double H, std::size_t n,
+                              ImpulsoParedes& imp) {
+    const __m256d vdt = _mm256_set1_pd(dt);
+    const __m256d vW = _mm256_set1_pd(W);
+    const __m256d vH = _mm256_set1_pd(H);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d qx = _mm256_loadu_pd(vx + i), qy = _mm256_loadu_pd(vy + i);
+        __m256d px = _mm256_add_pd(_mm256_loadu_pd(x + i), _mm256_mul_pd(qx, vdt));
+        __m256d py = _mm256_add_pd(_mm256_loadu_pd(y + i), _mm256_mul_pd(qy, vdt));
+        __m256d rr = _mm256_loadu_pd(r + i);
+        ParedEjeAVX2(px, qx, rr, vW, Espejo, masa + i, imp.izquierda, imp.derecha);
+        ParedEjeAVX2(py, qy, rr, vH, Espejo, masa + i, imp.abajo, imp.arriba);
+        _mm256_storeu_pd(x + i, px);
+        _mm256_storeu_pd(y + i, py);
+        _mm256_storeu_pd(vx + i, qx);
+        _mm256_storeu_pd(vy + i, qy);
+    }
+    MuevaYParedesEscalar<Espejo>(x, y, vx, vy, r, masa, dt, W, H, i, n, imp);
+}
+
+// ==========================================================
+//               VERSIÓN AVX2 EN FLOAT (8 bolas)
+// ==========================================================
+
+__attribute__((target("avx2")))
+static void MuevaAVX2(float* x, float* y, const float* vx, const float* vy,
+                      float dt, std::size_t n) {
+    const __m256 vdt = _mm256_set1_ps(dt);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        px = _mm256_add_ps(px, _mm256_mul_ps(_mm256_loadu_ps(vx + i), vdt));
+        py = _mm256_add_ps(py, _mm256_mul_ps(_mm256_loadu_ps(vy + i), vdt));
+        _mm256_storeu_ps(x + i, px);
+        _mm256_storeu_ps(y + i, py);
+    }
+    MuevaEscalar(x, y, vx, vy, dt, i, n);
+}
+
+/** @brief Versión en float de SumeImpulsosAVX2. */
+__attribute__((target("avx2")))
+static inline void SumeImpulsosAVX2(__m256 v, const float* masa, unsigned bits, double& acumulado) {
+    alignas(32) float q[8];
+    _mm256_store_ps(q, v);
+    SumeImpulsos(q, masa, bits, acumulado);
+}
+
+/** @brief Versión en float de ParedEjeAVX2. */
+__attribute__((target("avx2")))
+static inline void ParedEjeAVX2(__m256& p, __m256& v, __m256 r, __m256 L, bool espejo,
+                                const float* masa, double& bajo, double& alto) {
+    const __m256 cero = _mm256_setzero_ps();
+    const __m256 menos_uno = _mm256_set1_ps(-1.0f);
+
+    __m256 m = _mm256_and_ps(_mm256_cmp_ps(_mm256_sub_ps(p, r), cero, _CMP_LT_OQ),
+                             _mm256_cmp_ps(v, cero, _CMP_LT_OQ));
+    if (const unsigned bits = _mm256_movemask_ps(m)) SumeImpulsosAVX2(v, masa, bits, bajo);
+    if (espejo)
+        p = _mm256_blendv_ps(p, _mm256_add_ps(r, _mm256_sub_ps(r, p)), m);
+    v = _mm256_blendv_ps(v, _mm256_mul_ps(v, menos_uno), m);
+
+    m = _mm256_and_ps(_mm256_cmp_ps(_mm256_add_ps(p, r), L, _CMP_GT_OQ),
+                      _mm256_cmp_ps(v, cero, _CMP_GT_OQ));
+    if (const unsigned bits = _mm256_movemask_ps(m)) SumeImpulsosAVX2(v, masa, bits, alto);
+    if (espejo)
+        p = _mm256_blendv_ps(p, _mm256_sub_ps(_mm256_sub_ps(L, r),
+                                              _mm256_sub_ps(_mm256_add_ps(p, r), L)), m);
+    v = _mm256_blendv_ps(v, _mm256_mul_ps(v, menos_uno), m);
+}
+
+__attribute__((target("avx2")))
+static void ParedesAVX2(float* x, float* y, float* vx, float* vy, const float* r,
+                        const float* masa, float W, float H, std::size_t n, bool espejo,
+                        ImpulsoParedes& imp) {
+    const __m256 vW = _mm256_set1_ps(W);
+    const __m256 vH = _mm256_set1_ps(H);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 px = _mm256_loadu_ps(x + i), py = _mm256_loadu_ps(y + i);
+        __m256 qx = _mm256_loadu_ps(vx + i), qy = _mm256_loadu_ps(vy + i);
+        __m256 rr = _mm256_loadu_ps(r + i);
+        ParedEjeAVX2(px, qx, rr, vW, espejo, masa + i, imp.izquierda, imp.derecha);
+        ParedEjeAVX2(py, qy, rr, vH, espejo, masa + i, imp.abajo, imp.arriba);
+        if (espejo) {
+            _mm256_storeu_ps(x + i, px);
+            _mm256_storeu_ps(y + i, py);
+        }
+        _mm256_storeu_ps(vx + i, qx);
+        _mm256_storeu_ps(vy + i, qy);
+    }
+    if (espejo) ParedesRobustoEscalar(x, y, vx, vy, r, masa, W, H, i, n, imp);
+    else ParedesSimpleEscalar(x, y, vx, vy, r, masa, W, H, i, n, imp);
+}
+
+template <bool Espejo>
+__attribute__((target("avx2")))
+static void MuevaYParedesAVX2(float* x, float* y, float* vx, float* vy, const float* r,
+                              const float* masa, float dt, float W, float H, std::size_t n,
+                              ImpulsoParedes& imp) {
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 vW = _mm256_set1_ps(W);
+    const __m256 vH = _mm256_set1_ps(H);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 qx = _mm256_loadu_ps(vx + i), qy = _mm256_loadu_ps(vy + i);
+        __m256 px = _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(qx, vdt));
+        __m256 py = _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(qy, vdt));
+        __m256 rr = _mm256_loadu_ps(r + i);
+        ParedEjeAVX2(px, qx, rr, vW, Espejo, masa + i, imp.izquierda, imp.derecha);
+        ParedEjeAVX2(py, qy, rr, vH, Espejo, masa + i, imp.abajo, imp.arriba);
+        _mm256_storeu_ps(x + i, px);
+        _mm256_storeu_ps(y + i, py);
+        _mm256_storeu_ps(vx + i, qx);
+        _mm256_storeu_ps(vy + i, qy);
+    }
+    MuevaYParedesEscalar<Espejo>(x, y, vx, vy, r, masa, dt, W, H, i, n, imp);
+}
+
+// ==========================================================
+//                   VERSIÓN AVX-512 (8 bolas)
+// ==========================================================
+
+__attribute__((target("avx512f")))
+static void MuevaAVX512(double* x, double* y, const double* vx, const double* vy,
+                        double dt, std::size_t n) {
+    const __m512d vdt = _mm512_set1_pd(dt);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d px = _mm512_loadu_pd(x + i);
+        __m512d py = _mm512_loadu_pd(y + i);
+        px = _mm512_add_pd(px, _mm512_mul_pd(_mm512_loadu_pd(vx + i), vdt));
+        py = _mm512_add_pd(py, _mm512_mul_pd(_mm512_loadu_pd(vy + i), vdt));
+        _mm512_storeu_pd(x + i, px);
+        _mm512_storeu_pd(y + i, py);
+    }
+    MuevaEscalar(x, y, vx, vy, dt, i, n);
+}
+
+/** @brief Versión AVX-512 de SumeImpulsosAVX2. */
+__attribute__((target("avx512f")))
+static inline void SumeImpulsosAVX512(__m512d v, const double* masa, unsigned bits, double& acumulado) {
+    alignas(64) double q[8];
+    _mm512_store_pd(q, v);
+    SumeImpulsos(q, masa, bits, acumulado);
+}
+
+/** @brief Versión AVX-512 de ParedEjeAVX2, con registros de máscara. */
+__attribute__((target("avx512f")))
+static inline void ParedEjeAVX512(__m512d& p, __m512d& v, __m512d r, __m512d L, bool espejo,
+                                  const double* masa, double& bajo, double& alto) {
+    const __m512d cero = _mm512_setzero_pd();
+    const __m512d menos_uno = _mm512_set1_pd(-1.0);
+
+    __mmask8 m = _mm512_cmp_pd_mask(_mm512_sub_pd(p, r), cero, _CMP_LT_OQ)
+               & _mm512_cmp_pd_mask(v, cero, _CMP_LT_OQ);
+    if (const unsigned bits = m) SumeImpulsosAVX512(v, masa, bits, bajo);
+    if (espejo)
+        p = _mm512_mask_blend_pd(m, p, _mm512_add_pd(r, _mm512_sub_pd(r, p)));
+    v = _mm512_mask_blend_pd(m, v, _mm512_mul_pd(v, menos_uno));
+
+    m = _mm512_cmp_pd_mask(_mm512_add_pd(p, r), L, _CMP_GT_OQ)
+      & _mm512_cmp_pd_mask(v, cero, _CMP_GT_OQ);
+    if (const unsigned bits = m) SumeImpulsosAVX512(v, masa, bits, alto);
+    if (espejo)
+        p = _mm512_mask_blend_pd(m, p, _mm512_sub_pd(_mm512_sub_pd(L, r),
+                                                      _mm512_sub_pd(_mm512_add_pd(p, r), L)));
+    v = _mm512_mask_blend_pd(m, v, _mm512_mul_pd(v, menos_uno));
+}
+
+__attribute__((target("avx512f")))
+static void ParedesAVX512(double* x, double* y, double* vx, double* vy, const double* r,
+                          const double* masa, double W, double H, std::size_t n, bool espejo,
+                          ImpulsoParedes& imp) {
+    const __m512d vW = _mm512_set1_pd(W);
+    const __m512d vH = _mm512_set1_pd(H);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d px = _mm512_loadu_pd(x + i), py = _mm512_loadu_pd(y + i);
+        __m512d qx = _mm512_loadu_pd(vx + i), qy = _mm512_loadu_pd(vy + i);
+        __m512d rr = _mm512_loadu_pd(r + i);
+        ParedEjeAVX512(px, qx, rr, vW, espejo, masa + i, imp.izquierda, imp.derecha);
+        ParedEjeAVX512(py, qy, rr, vH, espejo, masa + i, imp.abajo, imp.arriba);
+        if (espejo) {
+            _mm512_storeu_pd(x + i, px);
+            _mm512_storeu_pd(y + i, py);
+        }
+        _mm512_storeu_pd(vx + i, qx);
+        _mm512_storeu_pd(vy + i, qy);
+    }
+    if (espejo) ParedesRobustoEscalar(x, y, vx, vy, r, masa, W, H, i, n, imp);
+    else ParedesSimpleEscalar(x, y, vx, vy, r, masa, W, H, i, n, imp);
+}
+
+/** @brief Versión AVX-512 de MuevaYParedesAVX2. */
+template <bool Espejo>
+__attribute__((target("avx512f")))
+static void MuevaYParedesAVX512(double* x, double* y, double* vx, double* vy, const double* r,
+                                const double* masa, double dt, double W, double H, std::size_t n,
+                                ImpulsoParedes& imp) {
+    const __m512d vdt = _mm512_set1_pd(dt);
+    const __m512d vW = _mm512_set1_pd(W);
+    const __m512d vH = _mm512_set1_pd(H);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d qx = _mm512_loadu_pd(vx + i), qy = _mm512_loadu_pd(vy + i);
+        __m512d px = _mm512_add_pd(_mm512_loadu_pd(x + i), _mm512_mul_pd(qx, vdt));
+        __m512d py = _mm512_add_pd(_mm512_loadu_pd(y + i), _mm512_mul_pd(qy, vdt));
+        __m512d rr = _mm512_loadu_pd(r + i);
+        ParedEjeAVX512(px, qx, rr, vW, Espejo, masa + i, imp.izquierda, imp.derecha);
+        ParedEjeAVX512(py, qy, rr, vH, Espejo, masa + i, imp.abajo, imp.arriba);
+        _mm512_storeu_pd(x + i, px);
+        _mm512_storeu_pd(y + i, py);
+        _mm512_storeu_pd(vx + i, qx);
+        _mm512_storeu_pd(vy + i, qy);
+    }
+    MuevaYParedesEscalar<Espejo>(x, y, vx, vy, r, masa, dt, W, H, i, n, imp);
+}
+
+// ==========================================================
+//             VERSIÓN AVX-512 EN FLOAT (16 bolas)
+// ==========================================================
+
+__attribute__((target("avx512f")))
+static void MuevaAVX512(float* x, float* y, const float* vx, const float* vy,
+                        float dt, std::size_t n) {
+    const __m512 vdt = _mm512_set1_ps(dt);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 px = _mm512_loadu_ps(x + i);
+        __m512 py = _mm512_loadu_ps(y + i);
+        px = _mm512_add_ps(px, _mm512_mul_ps(_mm512_loadu_ps(vx + i), vdt));
+        py = _mm512_add_ps(py, _mm512_mul_ps(_mm512_loadu_ps(vy + i), vdt));
+        _mm512_storeu_ps(x + i, px);
+        _mm512_storeu_ps(y + i, py);
+    }
+    MuevaEscalar(x, y, vx, vy, dt, i, n);
+}
+
+/** @brief Versión en float de SumeImpulsosAVX512. */
+__attribute__((target("avx512f")))
+static inline void SumeImpulsosAVX512(__m512 v, const float* masa, unsigned bits, double& acumulado) {
+    alignas(64) float q[16];
+    _mm512_store_ps(q, v);
+    SumeImpulsos(q, masa, bits, acumulado);
+}
+
+/** @brief Versión en float de ParedEjeAVX512. */
+__attribute__((target("avx512f")))
+static inline void ParedEjeAVX512(__m512& p, __m512& v, __m512 r, __m512 L, bool espejo,
+                                  const float* masa, double& bajo, double& alto) {
+    const __m512 cero = _mm512_setzero_ps();
+    const __m512 menos_uno = _mm512_set1_ps(-1.0f);
+
+    __mmask16 m = _mm512_cmp_ps_mask(_mm512_sub_ps(p, r), cero, _CMP_LT_OQ)
+                & _mm512_cmp_ps_mask(v, cero, _CMP_LT_OQ);
+    if (const unsigned bits = m) SumeImpulsosAVX512(v, masa, bits, bajo);
+    if (espejo)
+        p = _mm512_mask_blend_ps(m, p, _mm512_add_ps(r, _mm512_sub_ps(r, p)));
+    v = _mm512_mask_blend_ps(m, v, _mm512_mul_ps(v, menos_uno));
+
+    m = _mm512_cmp_ps_mask(_mm512_add_ps(p, r), L, _CMP_GT_OQ)
+      & _mm512_cmp_ps_mask(v, cero, _CMP_GT_OQ);
+    if (const unsigned bits = m) SumeImpulsosAVX512(v, masa, bits, alto);
+    if (espejo)
+        p = _mm512_mask_blend_ps(m, p, _mm512_sub_ps(_mm512_sub_ps(L, r),
+                                                      _mm512_sub_ps(_mm512_add_ps(p, r), L)));
+    v = _mm512_mask_blend_ps(m, v, _mm512_mul_ps(v, menos_uno));
+}
+
+__attribute__((target("avx512f")))
+static void ParedesAVX512(float* x, float* y, float* vx, float* vy, const float* r,
+                          const float* masa, float W, float H, std::size_t n, bool espejo,
+                          ImpulsoParedes& imp) {
+    const __m512 vW = _mm512_set1_ps(W);
+    const __m512 vH = _mm512_set1_ps(H);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 px = _mm512_loadu_ps(x + i), py = _mm512_loadu_ps(y + i);
+        __m512 qx = _mm512_loadu_ps(vx + i), qy = _mm512_loadu_ps(vy + i);
+        __m512 rr = _mm512_loadu_ps(r + i);
+        ParedEjeAVX512(px, qx, rr, vW, espejo, masa + i, imp.izquierda, imp.derecha);
+        ParedEjeAVX512(py, qy, rr, vH, espejo, masa + i, imp.abajo, imp.arriba);
+        if (espejo) {
+            _mm512_storeu_ps(x + i, px);
+            _mm512_storeu_ps(y + i, py);
+        }
+        _mm512_storeu_ps(vx + i, qx);
+        _mm512_storeu_ps(vy + i, qy);
+    }
+    if (espejo) ParedesRobustoEscalar(x, y, vx, vy, r, masa, W, H, i, n, imp);
+    else ParedesSimpleEscalar(x, y, vx, vy, r, masa, W, H, i, n, imp);
+}
+
+template <bool Espejo>
+__attribute__((target("avx512f")))
+static void MuevaYParedesAVX512(float* x, float* y, float* vx, float* vy, const float* r,
+                                const float* masa, float dt, float W, float H, std::size_t n,
+                                ImpulsoParedes& imp) {
+    const __m512 vdt = _mm512_set1_ps(dt);
+    const __m512 vW = _mm512_set1_ps(W);
+    const __m512 vH = _mm512_set1_ps(H);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 qx = _mm512_loadu_ps(vx + i), qy = _mm512_loadu_ps(vy + i);
+        __m512 px = _mm512_add_ps(_mm512_loadu_ps(x + i), _mm512_mul_ps(qx, vdt));
+        __m512 py = _mm512_add_ps(_mm512_loadu_ps(y + i), _mm512_mul_ps(qy, vdt));
+        __m512 rr = _mm512_loadu_ps(r + i);
+        ParedEjeAVX512(px, qx, rr, vW, Espejo, masa + i, imp.izquierda, imp.derecha);
+        ParedEjeAVX512(py, qy, rr, vH, Espejo, masa + i, imp.abajo, imp.arriba);
+        _mm512_storeu_ps(x + i, px);
+        _mm512_storeu_ps(y + i, py);
+        _mm512_storeu_ps(vx + i, qx);
+        _mm512_storeu_ps(vy + i, qy);
+    }
+    MuevaYParedesEscalar<Espejo>(x, y, vx, vy, r, masa, dt, W, H, i, n, imp);
+}
+
+#endif // BILLAR_X86
+
+// ==========================================================
+//                  DESPACHO EN TIEMPO DE EJECUCIÓN
+// ==========================================================
+
+/**
+ * @brief Detecta el mejor nivel soportado por la CPU.
+ * @return Nivel más ancho disponible.
+ */
+NivelSimd NivelSimdDisponible() {
+#if BILLAR_X86
+    static const NivelSimd nivel = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return NivelSimd::AVX512;
+        if (__builtin_cpu_supports("avx2")) return NivelSimd::AVX2;
+        return NivelSimd::Escalar;
+    }();
+    return nivel;
+#else
+    return NivelSimd::Escalar;
+#endif
+}
+
+/**
+ * @brief Convierte un nombre en un nivel, verificando que la CPU lo soporte.
+ * @param nombre "escalar", "avx2", "avx512" o "auto".
+ * @return Nivel pedido.
+ * @throws std::invalid_argument Si el nombre no es válido o el nivel no está disponible.
+ */
+NivelSimd NivelSimdDesdeNombre(const std::string& nombre) {
+    NivelSimd nivel;
+    if (nombre == "auto") return NivelSimdDisponible();
+    else if (nombre == "escalar") nivel = NivelSimd::Escalar;
+    else if (nombre == "avx2") nivel = NivelSimd::AVX2;
+    else if (nombre == "avx512") nivel = NivelSimd::AVX512;
+    else throw std::invalid_argument("Nivel SIMD no válido. Elija 'auto', 'escalar', 'avx2' o 'avx512'.");
+
+    if (static_cast<int>(nivel) > static_cast<int>(NivelSimdDisponible()))
+        throw std::invalid_argument("La CPU no soporta el nivel SIMD '" + nombre + "'.");
+    return nivel;
+}
+
+/** @brief Retorna el nombre legible de un nivel. */
+const char* NombreNivelSimd(NivelSimd nivel) {
+    switch (nivel) {
+    case NivelSimd::AVX512: return "avx512";
+    case NivelSimd::AVX2: return "avx2";
+    default: return "escalar";
+    }
+}
+
+/**
+ * @brief Reparte el rango [0, n) en bloques entre varios hilos.
+ *
+ * Los bloques tienen un tamaño múltiplo de 8 bolas, así que cada hilo recorre
+ * vectores completos salvo en el último bloque. Como cada bola se actualiza de
+ * forma independiente, el resultado no depende del número de hilos.
+ */
+template <class F>
+static void EnBloques(std::size_t n, int hilos, F f) {
+    if (hilos <= 1) {
+        f(0, n);
+        return;
+    }
+    const std::size_t bloque = 8192;
+    const long nb = static_cast<long>((n + bloque - 1) / bloque);
+    #pragma omp parallel for num_threads(hilos) schedule(static)
+    for (long b = 0; b < nb; ++b) {
+        std::size_t i0 = b * bloque;
+        f(i0, std::min(n, i0 + bloque));
+    }
+}
+
+/**
+ * @brief Como EnBloques, pero cada bloque acumula su propio impulso en las paredes.
+ *
+ * Los impulsos de los bloques se suman en el orden de los bloques, también con un
+ * solo hilo, así que el total no depende del número de hilos.
+ */
+template <class F>
+static ImpulsoParedes EnBloquesConImpulso(std::size_t n, int hilos, F f) {
+    const std::size_t bloque = 8192;
+    const long nb = static_cast<long>((n + bloque - 1) / bloque);
+    ImpulsoParedes total;
+    if (hilos <= 1) {
+        for (long b = 0; b < nb; ++b) {
+            ImpulsoParedes parcial;
+            const std::size_t i0 = b * bloque;
+            f(i0, std::min(n, i0 + bloque), parcial);
+            total += parcial;
+        }
+        return total;
+    }
+    std::vector<ImpulsoParedes> parciales(nb);
+    #pragma omp parallel for num_threads(hilos) schedule(static)
+    for (long b = 0; b < nb; ++b) {
+        std::size_t i0 = b * bloque;
+        f(i0, std::min(n, i0 + bloque), parciales[b]);
+    }
+    for (const ImpulsoParedes& parcial : parciales)
+        total += parcial;
+    return total;
+}
+
+/**
+ * @brief Avanza las posiciones de todas las bolas con el nivel indicado.
+ * @param P Bolas del sistema.
+ * @param dt Paso de tiempo.
+ * @param nivel Conjunto de instrucciones a usar.
+ * @param hilos Número de hilos.
+ */
+template <class Real>
+void MuevaBolas(ParticulasT<Real>& P, double dt_, NivelSimd nivel, int hilos) {
+    Real *x = P.x.data(), *y = P.y.data();
+    const Real *vx = P.vx.data(), *vy = P.vy.data();
+    const Real dt = static_cast<Real>(dt_);
+    EnBloques(P.Tamano(), hilos, [=](std::size_t i0, std::size_t i1) {
+#if BILLAR_X86
+        if (nivel == NivelSimd::AVX512) return MuevaAVX512(x + i0, y + i0, vx + i0, vy + i0, dt, i1 - i0);
+        if (nivel == NivelSimd::AVX2) return MuevaAVX2(x + i0, y + i0, vx + i0, vy + i0, dt, i1 - i0);
+#else
+        (void)nivel;
+#endif
+        MuevaEscalar(x, y, vx, vy, dt, i0, i1);
+    });
+}
+
+/**
+ * @brief Aplica los rebotes contra las paredes con el nivel indicado.
+ * @param P Bolas del sistema.
+ * @param C Caja de la simulación.
+ * @param nivel Conjunto de instrucciones a usar.
+ * @param hilos Número de hilos.
+ * @param espejo Si es verdadero también corrige la posición (método robusto).
+ */
+template <class Real>
+static ImpulsoParedes ResuelvaParedes(ParticulasT<Real>& P, const Caja& C, NivelSimd nivel, int hilos, bool espejo) {
+    Real *x = P.x.data(), *y = P.y.data(), *vx = P.vx.data(), *vy = P.vy.data();
+    const Real *r = P.r.data(), *masa = P.m.data();
+    const Real W = static_cast<Real>(C.GetW()), H = static_cast<Real>(C.GetH());
+    return EnBloquesConImpulso(P.Tamano(), hilos, [=](std::size_t i0, std::size_t i1, ImpulsoParedes& imp) {
+#if BILLAR_X86
+        if (nivel == NivelSimd::AVX512)
+            return ParedesAVX512(x + i0, y + i0, vx + i0, vy + i0, r + i0, masa + i0, W, H, i1 - i0, espejo, imp);
+        if (nivel == NivelSimd::AVX2)
+            return ParedesAVX2(x + i0, y + i0, vx + i0, vy + i0, r + i0, masa + i0, W, H, i1 - i0, espejo, imp);
+#else
+        (void)nivel;
+#endif
+        if (espejo) ParedesRobustoEscalar(x, y, vx, vy, r, masa, W, H, i0, i1, imp);
+        else ParedesSimpleEscalar(x, y, vx, vy, r, masa, W, H, i0, i1, imp);
+    });
+}
+
+/**
+ * @brief Resuelve los rebotes simples (solo velocidad) con el nivel indicado.
+ * @param P Bolas del sistema.
+ * @param C Caja de la simulación.
+ * @param nivel Conjunto de instrucciones a usar.
+ * @param hilos Número de hilos.
+ * @return Impulso recibido por cada pared.
+ */
+template <class Real>
+ImpulsoParedes ResuelvaParedesSimple(ParticulasT<Real>& P, const Caja& C, NivelSimd nivel, int hilos) {
+    return ResuelvaParedes(P, C, nivel, hilos, false);
+}
+
+/**
+ * @brief Resuelve los rebotes robustos (velocidad y posición espejada) con el nivel indicado.
+ * @param P Bolas del sistema.
+ * @param C Caja de la simulación.
+ * @param nivel Conjunto de instrucciones a usar.
+ * @param hilos Número de hilos.
+ * @return Impulso recibido por cada pared.
+ */
+template <class Real>
+ImpulsoParedes ResuelvaParedesRobusto(ParticulasT<Real>& P, const Caja& C, NivelSimd nivel, int hilos) {
+    return ResuelvaParedes(P, C, nivel, hilos, true);
+}
+
+/**
+ * @brief Movimiento y rebotes fusionados, bloque por bloque.
+ * @param P Bolas del sistema.
+ * @param C Caja de la simulación.
+ * @param dt Paso de tiempo.
+ * @param nivel Conjunto de instrucciones a usar.
+ * @param hilos Número de hilos.
+ * @return Impulso recibido por cada pared.
+ */
+template <bool Espejo, class Real>
+ImpulsoParedes MuevaYResuelvaParedes(ParticulasT<Real>& P, const Caja& C, double dt_, NivelSimd nivel, int hilos) {
+    Real *x = P.x.data(), *y = P.y.data(), *vx = P.vx.data(), *vy = P.vy.data();
+    const Real *r = P.r.data(), *masa = P.m.data();
+    const Real dt = static_cast<Real>(dt_);
+    const Real W = static_cast<Real>(C.GetW()), H = static_cast<Real>(C.GetH());
+    return EnBloquesConImpulso(P.Tamano(), hilos, [=](std::size_t i0, std::size_t i1, ImpulsoParedes& imp) {
+#if BILLAR_X86
+        if (nivel == NivelSimd::AVX512)
+            return MuevaYParedesAVX512<Espejo>(x + i0, y + i0, vx + i0, vy + i0, r + i0, masa + i0, dt, W, H,
+                                               i1 - i0, imp);
+        if (nivel == NivelSimd::AVX2)
+            return MuevaYParedesAVX2<Espejo>(x + i0, y + i0, vx + i0, vy + i0, r + i0, masa + i0, dt, W, H,
+                                             i1 - i0, imp);
+#else
+        (void)nivel;
+#endif
+        MuevaYParedesEscalar<Espejo>(x, y, vx, vy, r, masa, dt, W, H, i0, i1, imp);
+    });
+}
+
+/**
+ * @brief Cuenta las condiciones de rebote de las cuatro paredes.
+ * @param P Bolas del sistema.
+ * @param C Caja de la simulación.
+ */
+template <class Real>
+std::uint64_t CuenteRebotesPared(const ParticulasT<Real>& P, const Caja& C) {
+    const Real W = static_cast<Real>(C.GetW()), H = static_cast<Real>(C.GetH());
+    std::uint64_t rebotes = 0;
+    for (std::size_t i = 0; i < P.Tamano(); ++i) {
+        rebotes += (P.x[i] - P.r[i] < 0 && P.vx[i] < 0) + (P.x[i] + P.r[i] > W && P.vx[i] > 0);
+        rebotes += (P.y[i] - P.r[i] < 0 && P.vy[i] < 0) + (P.y[i] + P.r[i] > H && P.vy[i] > 0);
+    }
+    return rebotes;
+}
+
+#define BILLAR_INSTANCIE_KERNELS(Real)                                                                    \
+    template void MuevaBolas<Real>(ParticulasT<Real>&, double, NivelSimd, int);                           \
+    template ImpulsoParedes ResuelvaParedesSimple<Real>(ParticulasT<Real>&, const Caja&, NivelSimd, int);  \
+    template ImpulsoParedes ResuelvaParedesRobusto<Real>(ParticulasT<Real>&, const Caja&, NivelSimd, int); \
+    template ImpulsoParedes MuevaYResuelvaParedes<false, Real>(ParticulasT<Real>&, const Caja&, double,    \
+                                                               NivelSimd, int);                            \
+    template ImpulsoParedes MuevaYResuelvaParedes<true, Real>(ParticulasT<Real>&, const Caja&, double,     \
+                                                              NivelSimd, int);                             \
+    template std::uint64_t CuenteRebotesPared<Real>(const ParticulasT<Real>&, const Caja&);
+
+BILLAR_INSTANCIE_KERNELS(double)
+BILLAR_INSTANCIE_KERNELS(float)
+#undef BILLAR_INSTANCIE_KERNELS
+
+/** @brief Compara bit a bit dos arreglos. */
+template <class T>
+static bool MismosBits(const VectorAlineado<T>& a, const VectorAlineado<T>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+/** @brief Aplica ambos caminos a copias de P y compara los bits (ver KernelsIdenticos). */
+template <class Real>
+static bool CaminosIdenticos(const ParticulasT<Real>& P, const Caja& C, double dt, NivelSimd nivel) {
+    ParticulasT<Real> a = P, b = P, c = P;
+    ImpulsoParedes ia, ib, ic;
+    for (int paso = 0; paso < 16; ++paso) {
+        MuevaBolas(a, dt, NivelSimd::Escalar);
+        MuevaBolas(b, dt, nivel);
+        if (paso % 2 == 0) {
+            ia += ResuelvaParedesRobusto(a, C, NivelSimd::Escalar);
+            ib += ResuelvaParedesRobusto(b, C, nivel);
+            ic += MuevaYResuelvaParedes<true>(c, C, dt, nivel);
+        } else {
+            ia += ResuelvaParedesSimple(a, C, NivelSimd::Escalar);
+            ib += ResuelvaParedesSimple(b, C, nivel);
+            ic += MuevaYResuelvaParedes<false>(c, C, dt, nivel);
+        }
+    }
+    const double impulsos[3][4] = {{ia.izquierda, ia.derecha, ia.abajo, ia.arriba},
+                                   {ib.izquierda, ib.derecha, ib.abajo, ib.arriba},
+                                   {ic.izquierda, ic.derecha, ic.abajo, ic.arriba}};
+    return std::memcmp(impulsos[0], impulsos[1], sizeof(impulsos[0])) == 0 &&
+           std::memcmp(impulsos[0], impulsos[2], sizeof(impulsos[0])) == 0 &&
+           MismosBits(a.x, b.x) && MismosBits(a.y, b.y) &&
+           MismosBits(a.vx, b.vx) && MismosBits(a.vy, b.vy) &&
+           MismosBits(a.x, c.x) && MismosBits(a.y, c.y) &&
+           MismosBits(a.vx, c.vx) && MismosBits(a.vy, c.vy);
+}
+
+/**
+ * @brief Comprueba que un nivel vectorial reproduce bit a bit al escalar, en double y en float.
+ * @param P Bolas de prueba.
+ * @param C Caja de la simulación.
+ * @param dt Paso de tiempo.
+ * @param nivel Nivel a comparar.
+ * @return true si todos los campos coinciden.
+ */
+bool KernelsIdenticos(const Particulas& P, const Caja& C, double dt, NivelSimd nivel) {
+    ParticulasT<float> F;
+    F.Redimensione(P.Tamano());
+    std::copy(P.x.begin(), P.x.end(), F.x.begin());
+    std::copy(P.y.begin(), P.y.end(), F.y.begin());
+    std::copy(P.vx.begin(), P.vx.end(), F.vx.begin());
+    std::copy(P.vy.begin(), P.vy.end(), F.vy.begin());
+    std::copy(P.m.begin(), P.m.end(), F.m.begin());
+    std::copy(P.inv_m.begin(), P.inv_m.end(), F.inv_m.begin());
+    std::copy(P.r.begin(), P.r.end(), F.r.begin());
+    return CaminosIdenticos(P, C, dt, nivel) && CaminosIdenticos(F, C, dt, nivel);
+}
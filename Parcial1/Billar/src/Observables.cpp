@@ -0,0 +1,210 @@
+/**
+ * @file Observables.cpp
+ * @brief Implementación de los acumuladores de observables en línea.
+ */
+
+#include "Observables.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Función gamma incompleta regularizada superior Q(a, x).
+ *
+ * Serie para x < a + 1 y fracción continua (Lentz) en otro caso.
+ */
+double GammaQ(double a, double x) {
+    if (x <= 0.0) return 1.0;
+    const double ln_pref = -x + a * std::log(x) - std::lgamma(a);
+    if (x < a + 1.0) {
+        double termino = 1.0 / a, suma = termino;
+        for (int n = 1; n < 500; ++n) {
+            termino *= x / (a + n);
+            suma += termino;
+            if (std::fabs(termino) < std::fabs(suma) * 1e-15) break;
+        }
+        return 1.0 - suma * std::exp(ln_pref);
+    }
+    const double diminuto = 1e-300;
+    double b = x + 1.0 - a, c = 1.0 / diminuto, d = 1.0 / b, h = d;
+    for (int n = 1; n < 500; ++n) {
+        double an = -n * (n - a);
+        b += 2.0;
+        d = an * d + b;
+        if (std::fabs(d) < diminuto) d = diminuto;
+        c = b + an / c;
+        if (std::fabs(c) < diminuto) c = diminuto;
+        d = 1.0 / d;
+        double delta = d * c;
+        h *= delta;
+        if (std::fabs(delta - 1.0) < 1e-15) break;
+    }
+    return std::exp(ln_pref) * h;
+}
+
+} // namespace
+
+/**
+ * @brief Agrega una muestra actualizando media y suma de cuadrados (Welford).
+ * @param x Muestra.
+ */
+void Acumulador::Agregue(double x) {
+    ++n;
+    double delta = x - media;
+    media += delta / n;
+    m2 += delta * (x - media);
+    if (n == 1) {
+        minimo = maximo = x;
+    } else {
+        minimo = std::min(minimo, x);
+        maximo = std::max(maximo, x);
+    }
+}
+
+/** @brief Retorna la desviación estándar muestral. */
+double Acumulador::GetDesviacion() const {
+    return std::sqrt(GetVarianza());
+}
+
+/**
+ * @brief Define los bins del histograma y borra las cuentas.
+ * @param bins Número de bins regulares.
+ * @param maximo_ Límite superior.
+ */
+void Histograma::Defina(std::size_t bins, double maximo_) {
+    if (bins == 0)
+        throw std::invalid_argument("El histograma necesita al menos un bin.");
+    if (!(maximo_ > 0.0))
+        throw std::invalid_argument("El límite superior del histograma debe ser positivo.");
+    maximo = maximo_;
+    cuenta.assign(bins + 1, 0);
+    total = 0;
+}
+
+/**
+ * @brief Suma las cuentas de otro histograma.
+ * @param otro Histograma con los mismos bins y límite.
+ */
+void Histograma::Sume(const Histograma& otro) {
+    if (cuenta.empty()) {
+        *this = otro;
+        return;
+    }
+    if (otro.cuenta.size() != cuenta.size() || otro.maximo != maximo)
+        throw std::invalid_argument("Solo se pueden sumar histogramas con los mismos bins.");
+    for (std::size_t b = 0; b < cuenta.size(); ++b)
+        cuenta[b] += otro.cuenta[b];
+    total += otro.total;
+}
+
+/**
+ * @brief Borra las muestras y define el histograma.
+ * @param bins Número de bins.
+ * @param v_maxima Límite superior de rapidez.
+ */
+void Observables::Inicie(std::size_t bins, double v_maxima) {
+    energia = Acumulador();
+    px = Acumulador();
+    py = Acumulador();
+    temperatura = Acumulador();
+    rapideces.Defina(bins, v_maxima);
+    t_ultimo = 0.0;
+}
+
+/**
+ * @brief Recorre las bolas una vez y agrega una muestra a cada observable.
+ * @param P Bolas del sistema.
+ * @param t Tiempo de la simulación.
+ */
+template <class Real>
+void Observables::Registre(const ParticulasT<Real>& P, double t) {
+    const std::size_t N = P.Tamano();
+    if (N == 0) return;
+
+    double e = 0.0, sx = 0.0, sy = 0.0, masa = 0.0;
+    for (std::size_t i = 0; i < N; ++i) {
+        const double vx = P.vx[i], vy = P.vy[i], m = P.m[i];
+        double v2 = vx * vx + vy * vy;
+        e += 0.5 * m * v2;
+        sx += m * vx;
+        sy += m * vy;
+        masa += m;
+        rapideces.Agregue(std::sqrt(v2));
+    }
+    energia.Agregue(e);
+    px.Agregue(sx);
+    py.Agregue(sy);
+    temperatura.Agregue(e / N); // 2 grados de libertad por bola: kT = <m v²/2>
+    masa_media = masa / N;
+    t_ultimo = t;
+}
+
+template void Observables::Registre<double>(const Particulas&, double);
+template void Observables::Registre<float>(const ParticulasT<float>&, double);
+
+/**
+ * @brief Prueba chi-cuadrado del histograma contra la distribución de rapideces en 2D.
+ *
+ * Con kT la temperatura media, la fracción de rapideces bajo v es
+ * F(v) = 1 - exp(-m v² / (2 kT)).
+ */
+AjusteMaxwell Observables::AjusteMaxwellBoltzmann() const {
+    AjusteMaxwell r;
+    const double kT = temperatura.GetMedia();
+    const std::size_t B = rapideces.Bins();
+    if (rapideces.Total() == 0 || kT <= 0.0) return r;
+
+    auto F = [&](double v) { return 1.0 - std::exp(-masa_media * v * v / (2.0 * kT)); };
+    const double total = static_cast<double>(rapideces.Total());
+    int usados = 0;
+    for (std::size_t b = 0; b <= B; ++b) {
+        double a = b * rapideces.Ancho();
+        double esperado = total * (b < B ? F(a + rapideces.Ancho()) - F(a) : 1.0 - F(a));
+        if (esperado < 5.0) continue;
+        double d = rapideces.Cuenta(b) - esperado;
+        r.chi2 += d * d / esperado;
+        ++usados;
+    }
+    // Se restan un grado por la normalización y otro por la temperatura estimada.
+    r.grados = std::max(usados - 2, 1);
+    r.p = GammaQ(0.5 * r.grados, 0.5 * r.chi2);
+    return r;
+}
+
+/**
+ * @brief Escribe el resumen de observables y el histograma normalizado.
+ * @param f Flujo de salida.
+ */
+void Observables::EscribaResumen(std::ostream& f) const {
+    auto Linea = [&](const char* nombre, const Acumulador& a) {
+        f << "# " << std::left << std::setw(14) << nombre << std::right
+          << " media: " << std::setw(14) << a.GetMedia()
+          << " desv: " << std::setw(14) << a.GetDesviacion()
+          << " min: " << std::setw(14) << a.GetMinimo()
+          << " max: " << std::setw(14) << a.GetMaximo() << "\n";
+    };
+    AjusteMaxwell ajuste = AjusteMaxwellBoltzmann();
+
+    f << std::scientific << std::setprecision(6);
+    f << "# MUESTRAS: " << energia.GetN() << "\n";
+    f << "# T_FINAL: " << t_ultimo << "\n";
+    Linea("ENERGIA", energia);
+    Linea("PX", px);
+    Linea("PY", py);
+    Linea("TEMPERATURA", temperatura);
+    f << "# CHI2_MAXWELL: " << ajuste.chi2 << " GRADOS: " << ajuste.grados << " P: " << ajuste.p << "\n";
+    f << "# " << std::setw(12) << "v_centro" << std::setw(15) << "densidad" << std::setw(15) << "maxwell" << "\n";
+
+    const double kT = temperatura.GetMedia();
+    const double ancho = rapideces.Ancho();
+    const double total = static_cast<double>(rapideces.Total());
+    for (std::size_t b = 0; b < rapideces.Bins(); ++b) {
+        double v = (b + 0.5) * ancho;
+        double densidad = total > 0 ? rapideces.Cuenta(b) / (total * ancho) : 0.0;
+        double teorica = kT > 0 ? masa_media * v / kT * std::exp(-masa_media * v * v / (2.0 * kT)) : 0.0;
+        f << std::setw(14) << v << std::setw(15) << densidad << std::setw(15) << teorica << "\n";
+    }
+}
@@ -0,0 +1,72 @@
+/**
+ * @file Reordenamiento.cpp
+ * @brief Implementación del orden de Morton y de la permutación de las bolas.
+ */
+
+#include "Reordenamiento.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @brief Ordena por (clave, índice) empacados en un entero de 64 bits.
+ * @param P Bolas.
+ * @param W,H Dimensiones de la caja.
+ * @param lado Lado de las celdas.
+ * @param orden Orden resultante.
+ */
+template <class Real>
+void OrdenMorton(const ParticulasT<Real>& P, double W, double H, double lado, std::vector<std::uint32_t>& orden) {
+    const std::size_t N = P.Tamano();
+    // La clave usa 16 bits por eje
+    lado = std::max({lado, W / 65536.0, H / 65536.0});
+    const std::uint32_t nx = static_cast<std::uint32_t>(std::max(1.0, std::ceil(W / lado)));
+    const std::uint32_t ny = static_cast<std::uint32_t>(std::max(1.0, std::ceil(H / lado)));
+
+    std::vector<std::uint64_t> claves(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        // Las bolas fuera de la caja van a la celda del borde
+        const std::uint32_t cx = static_cast<std::uint32_t>(std::clamp(P.x[i] / lado, 0.0, nx - 1.0));
+        const std::uint32_t cy = static_cast<std::uint32_t>(std::clamp(P.y[i] / lado, 0.0, ny - 1.0));
+        claves[i] = (static_cast<std::uint64_t>(ClaveMorton(cx, cy)) << 32) | i;
+    }
+    std::sort(claves.begin(), claves.end());
+
+    orden.resize(N);
+    for (std::size_t k = 0; k < N; ++k)
+        orden[k] = static_cast<std::uint32_t>(claves[k]);
+}
+
+namespace {
+
+/** @brief Aplica la permutación a un arreglo usando un búfer auxiliar. */
+template <class T>
+void Permute(VectorAlineado<T>& a, const std::vector<std::uint32_t>& orden, VectorAlineado<T>& auxiliar) {
+    auxiliar.resize(a.size());
+    for (std::size_t k = 0; k < orden.size(); ++k)
+        auxiliar[k] = a[orden[k]];
+    a.swap(auxiliar);
+}
+
+} // namespace
+
+/**
+ * @brief Mueve cada campo de las bolas al nuevo orden.
+ * @param P Bolas.
+ * @param orden Permutación.
+ */
+template <class Real>
+void PermuteParticulas(ParticulasT<Real>& P, const std::vector<std::uint32_t>& orden) {
+    if (orden.size() != P.Tamano())
+        throw std::invalid_argument("La permutación no tiene una entrada por bola.");
+    VectorAlineado<Real> auxiliar;
+    for (VectorAlineado<Real>* campo : {&P.x, &P.y, &P.vx, &P.vy, &P.m, &P.inv_m, &P.r})
+        Permute(*campo, orden, auxiliar);
+    VectorAlineado<std::uint32_t> auxiliar_id;
+    Permute(P.id, orden, auxiliar_id);
+}
+
+template void OrdenMorton<double>(const Particulas&, double, double, double, std::vector<std::uint32_t>&);
+template void OrdenMorton<float>(const ParticulasT<float>&, double, double, double, std::vector<std::uint32_t>&);
+template void PermuteParticulas<double>(Particulas&, const std::vector<std::uint32_t>&);
+template void PermuteParticulas<float>(ParticulasT<float>&, const std::vector<std::uint32_t>&);
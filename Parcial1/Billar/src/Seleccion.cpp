@@ -0,0 +1,129 @@
+/**
+ * @file Seleccion.cpp
+ * @brief Implementación de la lectura de trazadores y regiones, y de la selección de salida.
+ */
+
+#include "Seleccion.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+/** @brief Separa "v1,v2,..." en valores sin espacios alrededor; omite los vacíos. */
+std::vector<std::string> Separe(const std::string& lista) {
+    std::vector<std::string> valores;
+    std::stringstream ss(lista);
+    std::string v;
+    while (std::getline(ss, v, ',')) {
+        const std::size_t a = v.find_first_not_of(" \t");
+        if (a == std::string::npos) continue;
+        valores.push_back(v.substr(a, v.find_last_not_of(" \t") - a + 1));
+    }
+    return valores;
+}
+
+/** @brief Convierte a id de bola; todo el texto debe ser un entero no negativo de 32 bits. */
+std::uint32_t ComoId(const std::string& texto) {
+    try {
+        std::size_t usados = 0;
+        const long long v = std::stoll(texto, &usados);
+        if (usados == texto.size() && v >= 0 && v <= 0xFFFFFFFFLL)
+            return static_cast<std::uint32_t>(v);
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument("Id de trazador no válido: " + texto);
+}
+
+} // namespace
+
+/**
+ * @brief Lee una lista de ids y rangos inclusivos `a-b` sin expandirlos.
+ * @param texto Lista.
+ * @return Rangos.
+ */
+std::vector<RangoTrazadores> LeaRangosTrazadores(const std::string& texto) {
+    std::vector<RangoTrazadores> rangos;
+    for (const std::string& v : Separe(texto)) {
+        const std::size_t guion = v.find('-', 1);
+        if (guion == std::string::npos) {
+            const std::uint32_t a = ComoId(v);
+            rangos.push_back({a, a});
+            continue;
+        }
+        const std::uint32_t a = ComoId(v.substr(0, guion));
+        const std::uint32_t b = ComoId(v.substr(guion + 1));
+        if (b < a)
+            throw std::invalid_argument("Rango de trazadores invertido: " + v);
+        rangos.push_back({a, b});
+    }
+    return rangos;
+}
+
+/**
+ * @brief Expande los rangos de la lista; el tamaño queda acotado por N.
+ * @param texto Lista.
+ * @param N Número de bolas.
+ * @return Ids ordenados y sin repetir.
+ */
+std::vector<std::uint32_t> LeaTrazadores(const std::string& texto, std::size_t N) {
+    const std::vector<RangoTrazadores> rangos = LeaRangosTrazadores(texto);
+    for (const RangoTrazadores& rango : rangos)
+        if (rango.hasta >= N)
+            throw std::invalid_argument("El trazador " + std::to_string(rango.hasta) + " no existe: hay " +
+                                        std::to_string(N) + " bolas.");
+    std::vector<std::uint32_t> ids;
+    for (const RangoTrazadores& rango : rangos)
+        for (std::uint64_t i = rango.desde; i <= rango.hasta; ++i)
+            ids.push_back(static_cast<std::uint32_t>(i));
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+/**
+ * @brief Lee una región `x0,y0,x1,y1`.
+ * @param texto Cuatro reales separados por comas.
+ * @return Región.
+ */
+RegionSalida LeaRegion(const std::string& texto) {
+    const std::vector<std::string> v = Separe(texto);
+    double c[4];
+    bool valida = v.size() == 4;
+    for (std::size_t k = 0; valida && k < 4; ++k) {
+        try {
+            std::size_t usados = 0;
+            c[k] = std::stod(v[k], &usados);
+            valida = usados == v[k].size();
+        } catch (const std::exception&) {
+            valida = false;
+        }
+    }
+    if (!valida)
+        throw std::invalid_argument("Región no válida (se espera x0,y0,x1,y1): " + texto);
+    RegionSalida r{c[0], c[1], c[2], c[3]};
+    if (!(r.x1 > r.x0 && r.y1 > r.y0))
+        throw std::invalid_argument("La región debe cumplir x0 < x1 y y0 < y1: " + texto);
+    return r;
+}
+
+/**
+ * @brief Arma la selección y la tabla de ranuras de los trazadores.
+ * @param cada_ Decimación.
+ * @param texto_trazadores Lista de ids.
+ * @param texto_region Región.
+ * @param N Número de bolas.
+ */
+SeleccionSalida::SeleccionSalida(int cada_, const std::string& texto_trazadores, const std::string& texto_region,
+                                 std::size_t N)
+    : cada(cada_), trazadores(LeaTrazadores(texto_trazadores, N)), con_region(!texto_region.empty()) {
+    if (cada < 1)
+        throw std::invalid_argument("salida_cada debe ser al menos 1.");
+    if (con_region)
+        region = LeaRegion(texto_region);
+    if (trazadores.empty())
+        return;
+    ranura.assign(N, -1);
+    for (std::size_t s = 0; s < trazadores.size(); ++s)
+        ranura[trazadores[s]] = static_cast<std::int32_t>(s);
+}
@@ -3,88 +3,476 @@
  * @brief Implementación de la clase Sistema, que coordina la simulación del billar.
  * 
  * Este archivo contiene la lógica para el avance temporal, las colisiones entre bolas,
- * y la escritura de resultados a archivos de salida.
+ * y la escritura de resultados a archivos de salida. La clase se instancia al final
+ * para double y float.
  */
 
 #include "Sistema.h"
 #include <cstdlib>
 #include <cmath>
+#include <algorithm>
 #include <iostream>
-#include <iomanip>
 #include <stdexcept> // std::invalid_argument
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <type_traits>
 
 /**
  * @brief Selecciona el método de integración temporal.
  * 
- * @param nombre Nombre del integrador ("euler" o "verlet").
+ * @param nombre Nombre del integrador ("euler", "verlet" o "eventos").
  * @throws std::invalid_argument Si el nombre no es válido.
  */
-void Sistema::SeleccioneIntegrador(const std::string& nombre) {
+template <class Real>
+void SistemaT<Real>::SeleccioneIntegrador(const std::string& nombre) {
     if (nombre == "euler") {
         integrador_actual = Integrador::Euler;
     } else if (nombre == "verlet") {
         integrador_actual = Integrador::Verlet;
+    } else if (nombre == "eventos") {
+        if constexpr (!doble)
+            throw std::invalid_argument("El integrador por eventos requiere precisión doble.");
+        integrador_actual = Integrador::Eventos;
     } else {
-        throw std::invalid_argument("Integrador no válido. Elija 'euler' o 'verlet'.");
+        throw std::invalid_argument("Integrador no válido. Elija 'euler', 'verlet' o 'eventos'.");
     }
+    eventos_listos = false;
+    ElijaPaso();
 }
 
 /**
- * @brief Realiza un paso temporal del sistema según el integrador actual.
- * 
- * @param dt Paso de tiempo.
+ * @brief Selecciona el motor de búsqueda de choques entre bolas.
+ *
+ * Ambos motores resuelven los mismos pares; el de celdas solo evita probar
+ * pares que no pueden estar en contacto.
+ *
+ * @param nombre Nombre del motor ("fuerza_bruta", "celdas", "paralelo" o "vecinos").
+ * @throws std::invalid_argument Si el nombre no es válido.
  */
-void Sistema::Paso(double dt) {
-    if (integrador_actual == Integrador::Euler)
-        PasoEuler(dt);
-    else
-        PasoVerlet(dt);
+template <class Real>
+void SistemaT<Real>::SeleccioneMotorColisiones(const std::string& nombre) {
+    if (nombre == "fuerza_bruta") {
+        motor_actual = MotorColisiones::FuerzaBruta;
+    } else if (nombre == "celdas") {
+        motor_actual = MotorColisiones::Celdas;
+    } else if (nombre == "paralelo") {
+        motor_actual = MotorColisiones::Paralelo;
+    } else if (nombre == "vecinos") {
+        motor_actual = MotorColisiones::Vecinos;
+    } else {
+        throw std::invalid_argument("Motor de colisiones no válido. Elija 'fuerza_bruta', 'celdas', 'paralelo' o 'vecinos'.");
+    }
+    celdas_listas = false;
+    vecinos.Invalide();
+    ElijaPaso();
 }
 
 /**
- * @brief Implementación del integrador de Euler.
- * 
- * Avanza la simulación mediante integración explícita.
- * Es sencillo, pero físicamente inexacto para colisiones rápidas.
- * 
- * @param dt Paso de tiempo.
+ * @brief Define el número de hilos del motor paralelo y de los núcleos vectoriales.
+ * @param n Número de hilos.
+ * @throws std::invalid_argument Si n es menor que 1.
+ */
+template <class Real>
+void SistemaT<Real>::DefinaHilos(int n) {
+    if (n < 1)
+        throw std::invalid_argument("El número de hilos debe ser al menos 1.");
+    hilos = n;
+}
+
+/**
+ * @brief Selecciona el conjunto de instrucciones de los núcleos vectoriales.
+ * @param nombre "auto", "escalar", "avx2" o "avx512".
+ * @throws std::invalid_argument Si el nombre no es válido o la CPU no lo soporta.
+ */
+template <class Real>
+void SistemaT<Real>::SeleccioneSimd(const std::string& nombre) {
+    nivel_simd = NivelSimdDesdeNombre(nombre);
+}
+
+/**
+ * @brief Define cada cuántos pasos se reordenan las bolas.
+ * @param pasos Pasos entre reordenamientos (0: nunca).
+ * @throws std::invalid_argument Si es negativo.
+ */
+template <class Real>
+void SistemaT<Real>::DefinaReorden(int pasos) {
+    if (pasos < 0)
+        throw std::invalid_argument("El intervalo de reordenamiento no puede ser negativo.");
+    intervalo_reorden = pasos;
+}
+
+/**
+ * @brief Ordena las bolas por Morton con celdas del diámetro de la bola más grande.
+ *
+ * Es el mismo lado que usa el motor de celdas, así las bolas de una celda de
+ * choques quedan contiguas en memoria.
+ */
+template <class Real>
+void SistemaT<Real>::Reordene() {
+    double r_max = 0.0;
+    for (double r : bolas.r)
+        r_max = std::max(r_max, r);
+    if (bolas.Tamano() < 2 || r_max <= 0.0)
+        return;
+    OrdenMorton(bolas, caja.GetW(), caja.GetH(), 2.0 * r_max, orden);
+    Reordene(orden);
+}
+
+/**
+ * @brief Permuta las bolas y marca como inválidas las estructuras que guardan índices.
+ * @param nuevo_orden Permutación.
  */
-void Sistema::PasoEuler(double dt) {
-    // 1. Mover todas las bolas
-    for (auto& b : bolas)
-        b.Muevase(dt);
+template <class Real>
+void SistemaT<Real>::Reordene(const std::vector<std::uint32_t>& nuevo_orden) {
+    PermuteParticulas(bolas, nuevo_orden);
+    reordenadas = true;
+    eventos_listos = false;
+    vecinos.Invalide();
+}
 
-    // 2. Resolver colisiones con paredes
-    for (auto& b : bolas)
-        b.ResuelvaColisionParedesSimple(caja);
+/**
+ * @brief Resuelve los choques entre bolas con el motor fijado al compilar.
+ *
+ * Con el motor de celdas, el lado de celda es el diámetro de la bola más grande,
+ * así dos bolas en contacto siempre están en la misma celda o en celdas vecinas.
+ */
+template <class Real>
+template <MotorColisiones Motor>
+void SistemaT<Real>::ResuelvaChoques() {
+    ConteoChoques conteo;
+    if constexpr (Motor == MotorColisiones::FuerzaBruta) {
+        CronometroFase cronometro(instrumentacion, Fase::Choques);
+        const size_t N = bolas.Tamano();
+        for (size_t i = 0; i < N; ++i) {
+            BolaT<Real> bi(bolas, i);
+            for (size_t j = i + 1; j < N; ++j) {
+                const unsigned efecto = bi.ChoqueElastico(BolaT<Real>(bolas, j));
+                if constexpr (INSTRUMENTACION_ACTIVA)
+                    conteo.Agregue(efecto);
+            }
+        }
+        conteo.pruebas = N > 1 ? static_cast<std::uint64_t>(N) * (N - 1) / 2 : 0;
+    } else if constexpr (Motor == MotorColisiones::Vecinos) {
+        {
+            CronometroFase cronometro(instrumentacion, Fase::Celdas);
+            vecinos.Actualice(bolas, caja);
+        }
+        CronometroFase cronometro(instrumentacion, Fase::Choques);
+        conteo = vecinos.ResuelvaChoques(bolas);
+    } else {
+        constexpr bool paralelo = Motor == MotorColisiones::Paralelo;
+        if (!celdas_listas) {
+            double r_max = 0.0;
+            for (double r : bolas.r)
+                r_max = std::max(r_max, r);
+            double lado = 2.0 * r_max;
+            // Sin modo determinista el motor paralelo recorre celdas, no bolas: en gases
+            // diluidos se agrandan las celdas para que haya en promedio al menos una bola
+            // por celda. El modo determinista usa las mismas celdas que el motor serial.
+            if (paralelo && !determinista && bolas.Tamano() > 0)
+                lado = std::max(lado, std::sqrt(caja.GetW() * caja.GetH() / bolas.Tamano()));
+            celdas.Defina(caja, lado);
+            celdas_listas = true;
+        }
+        {
+            CronometroFase cronometro(instrumentacion, Fase::Celdas);
+            if constexpr (paralelo)
+                celdas.ConstruyaParalelo(bolas, hilos, determinista);
+            else
+                celdas.Construya(bolas);
+        }
+        CronometroFase cronometro(instrumentacion, Fase::Choques);
+        if constexpr (paralelo)
+            conteo = determinista ? celdas.ResuelvaChoquesOrdenado(bolas, hilos)
+                                  : celdas.ResuelvaChoquesParalelo(bolas, hilos);
+        else
+            conteo = celdas.ResuelvaChoques(bolas);
+    }
+    pruebas_pares += conteo.pruebas;
+    if constexpr (INSTRUMENTACION_ACTIVA)
+        instrumentacion.choques += conteo;
+}
+
+/**
+ * @brief Paso de Euler (ParedSimple) o de Verlet (ParedRobusta) con un motor de choques fijo.
+ *
+ * El movimiento y las paredes se hacen en una sola pasada sobre las bolas
+ * (MuevaYResuelvaParedes); los choques entre bolas necesitan todas las
+ * posiciones nuevas y van en una segunda pasada. Con la instrumentación
+ * compilada se usan las dos pasadas separadas para poder cronometrarlas.
+ *
+ * @tparam Paredes Política de paredes.
+ * @tparam Motor Motor de choques.
+ * @param dt Paso de tiempo.
+ */
+template <class Real>
+template <class Paredes, MotorColisiones Motor>
+void SistemaT<Real>::PasoFijo(double dt) {
+    // 1 y 2. Mover todas las bolas y resolver colisiones con paredes
+    if constexpr (INSTRUMENTACION_ACTIVA) {
+        {
+            CronometroFase cronometro(instrumentacion, Fase::Movimiento);
+            MuevaBolas(bolas, dt, nivel_simd, hilos);
+        }
+        CronometroFase cronometro(instrumentacion, Fase::Paredes);
+        instrumentacion.rebotes_pared += CuenteRebotesPared(bolas, caja);
+        if constexpr (Paredes::espejo)
+            AcumuleImpulso(ResuelvaParedesRobusto(bolas, caja, nivel_simd, hilos));
+        else
+            AcumuleImpulso(ResuelvaParedesSimple(bolas, caja, nivel_simd, hilos));
+    } else {
+        AcumuleImpulso(MuevaYResuelvaParedes<Paredes::espejo>(bolas, caja, dt, nivel_simd, hilos));
+    }
 
     // 3. Resolver colisiones entre bolas
-    for (size_t i = 0; i < bolas.size(); ++i)
-        for (size_t j = i + 1; j < bolas.size(); ++j)
-            bolas[i].ChoqueElastico(bolas[j]);
+    ResuelvaChoques<Motor>();
 }
 
 /**
- * @brief Implementación del integrador de Verlet.
- * 
- * Más estable y físicamente correcto, corrige la posición
- * de las bolas al colisionar con las paredes.
+ * @brief Fija la función de paso según el integrador y el motor actuales.
+ *
+ * Se llama solo al cambiar la configuración; en cada paso no se consulta
+ * ni el integrador ni el motor.
+ */
+template <class Real>
+void SistemaT<Real>::ElijaPaso() {
+    using M = MotorColisiones;
+    if (integrador_actual == Integrador::Eventos) {
+        paso_actual = &SistemaT::PasoEventos;
+        return;
+    }
+    const bool euler = integrador_actual == Integrador::Euler;
+    switch (motor_actual) {
+    case M::FuerzaBruta:
+        paso_actual = euler ? &SistemaT::PasoFijo<ParedSimple, M::FuerzaBruta>
+                            : &SistemaT::PasoFijo<ParedRobusta, M::FuerzaBruta>;
+        break;
+    case M::Celdas:
+        paso_actual = euler ? &SistemaT::PasoFijo<ParedSimple, M::Celdas>
+                            : &SistemaT::PasoFijo<ParedRobusta, M::Celdas>;
+        break;
+    case M::Paralelo:
+        paso_actual = euler ? &SistemaT::PasoFijo<ParedSimple, M::Paralelo>
+                            : &SistemaT::PasoFijo<ParedRobusta, M::Paralelo>;
+        break;
+    case M::Vecinos:
+        paso_actual = euler ? &SistemaT::PasoFijo<ParedSimple, M::Vecinos>
+                            : &SistemaT::PasoFijo<ParedRobusta, M::Vecinos>;
+        break;
+    }
+}
+
+/**
+ * @brief Construye un sistema vacío con Verlet y el motor de celdas.
+ */
+template <class Real>
+SistemaT<Real>::SistemaT() {
+    ElijaPaso();
+}
+
+/**
+ * @brief Aplica el integrador actual y actualiza tiempo, pasos e instrumentación.
+ * @param dt Paso de tiempo.
+ */
+template <class Real>
+void SistemaT<Real>::Integre(double dt) {
+    (this->*paso_actual)(dt);
+
+    tiempo += dt;
+    ++pasos;
+    if (intervalo_reorden > 0 && pasos % intervalo_reorden == 0 && !PorEventos())
+        Reordene();
+    if (intervalo_balance > 0 && pasos % intervalo_balance == 0)
+        ResincroniceBalance();
+    if constexpr (INSTRUMENTACION_ACTIVA) {
+        ++instrumentacion.pasos;
+        instrumentacion.N = bolas.Tamano();
+    }
+}
+
+/**
+ * @brief Realiza un paso temporal del sistema según el integrador actual.
  * 
  * @param dt Paso de tiempo.
  */
-void Sistema::PasoVerlet(double dt) {
-    // 1. Mover todas las bolas
-    for (auto& b : bolas)
-        b.Muevase(dt);
+template <class Real>
+void SistemaT<Real>::Paso(double dt) {
+    Integre(dt);
+    if (intervalo_observables > 0 && pasos % intervalo_observables == 0) {
+        CronometroFase cronometro(instrumentacion, Fase::Observables);
+        observables.Registre(bolas, tiempo);
+    }
+}
 
-    // 2. Resolver colisiones con paredes
-    for (auto& b : bolas)
-        b.ResuelvaColisionParedesRobusto(caja);
+/**
+ * @brief Paso con desplazamiento máximo `fraccion` * r_min.
+ * @param fraccion Fracción del radio.
+ * @throws std::invalid_argument Si la fracción no está en (0, 1].
+ */
+template <class Real>
+double SistemaT<Real>::PasoCFL(double fraccion) const {
+    if (!(fraccion > 0.0 && fraccion <= 1.0))
+        throw std::invalid_argument("La fracción CFL debe estar en (0, 1].");
+    const size_t N = bolas.Tamano();
+    double v2_max = 0.0;
+    double r_min = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < N; ++i) {
+        const double vx = bolas.vx[i], vy = bolas.vy[i];
+        v2_max = std::max(v2_max, vx * vx + vy * vy);
+        r_min = std::min(r_min, static_cast<double>(bolas.r[i]));
+    }
+    if (v2_max == 0.0)
+        return std::numeric_limits<double>::infinity();
+    return fraccion * r_min / std::sqrt(v2_max);
+}
 
-    // 3. Resolver colisiones entre bolas
-    for (size_t i = 0; i < bolas.size(); ++i)
-        for (size_t j = i + 1; j < bolas.size(); ++j)
-            bolas[i].ChoqueElastico(bolas[j]);
+/**
+ * @brief Avanza un intervalo con pasos CFL que terminan exactamente en su final.
+ * @param intervalo Tiempo a avanzar.
+ * @param fraccion Desplazamiento máximo por paso, en radios.
+ * @return Pasos tomados.
+ */
+template <class Real>
+long SistemaT<Real>::AvanceAdaptativo(double intervalo, double fraccion) {
+    if (PorEventos()) {
+        Paso(intervalo);
+        return 1;
+    }
+    long n_pasos = 0;
+    double avanzado = 0.0;
+    while (avanzado < intervalo) {
+        const double restante = intervalo - avanzado;
+        const double limite = PasoCFL(fraccion);
+        // Se divide el resto en partes iguales: el último paso no queda diminuto
+        const double partes = limite < restante ? std::ceil(restante / limite) : 1.0;
+        const double dt = partes > 1.0 ? restante / partes : restante;
+        Integre(dt);
+        dt_adaptativos.Agregue(dt);
+        avanzado = partes > 1.0 ? avanzado + dt : intervalo;
+        ++n_pasos;
+    }
+    if (intervalo_observables > 0) {
+        CronometroFase cronometro(instrumentacion, Fase::Observables);
+        observables.Registre(bolas, tiempo);
+    }
+    return n_pasos;
+}
+
+/**
+ * @brief Activa la acumulación de observables y borra las muestras previas.
+ * @param intervalo Pasos entre muestras (0 la desactiva).
+ * @param bins Número de bins del histograma de rapideces.
+ * @param v_maxima Límite superior del histograma.
+ * @throws std::invalid_argument Si el intervalo es negativo.
+ */
+template <class Real>
+void SistemaT<Real>::DefinaObservables(int intervalo, std::size_t bins, double v_maxima) {
+    if (intervalo < 0)
+        throw std::invalid_argument("El intervalo de observables no puede ser negativo.");
+    observables.Inicie(bins, v_maxima);
+    intervalo_observables = intervalo;
+}
+
+/**
+ * @brief Suma el impulso de un paso al balance.
+ *
+ * La pared izquierda y la de abajo empujan las bolas hacia +x y +y; la derecha
+ * y la de arriba, hacia -x y -y.
+ *
+ * @param imp Impulso recibido por cada pared en el paso.
+ */
+template <class Real>
+void SistemaT<Real>::AcumuleImpulso(const ImpulsoParedes& imp) {
+    balance.impulso += imp;
+    balance.px += imp.izquierda - imp.derecha;
+    balance.py += imp.abajo - imp.arriba;
+}
+
+/**
+ * @brief Suma sobre todas las bolas, en double.
+ * @param energia,px,py Energía cinética y momento total.
+ * @param escala Σ m|v|, con la que se normaliza la deriva de momento.
+ */
+template <class Real>
+void SistemaT<Real>::SumeConservadas(double& energia, double& px, double& py, double& escala) const {
+    energia = px = py = escala = 0.0;
+    for (size_t i = 0; i < bolas.Tamano(); ++i) {
+        const double m = bolas.m[i], vx = bolas.vx[i], vy = bolas.vy[i];
+        energia += 0.5 * m * (vx * vx + vy * vy);
+        px += m * vx;
+        py += m * vy;
+        escala += m * std::hypot(vx, vy);
+    }
+}
+
+/**
+ * @brief Inicia el balance desde el estado actual.
+ * @param intervalo Pasos entre resincronizaciones.
+ * @param umbral Deriva relativa máxima.
+ */
+template <class Real>
+void SistemaT<Real>::DefinaBalance(int intervalo, double umbral) {
+    if (intervalo < 0)
+        throw std::invalid_argument("El intervalo del balance no puede ser negativo.");
+    if (!(umbral >= 0.0))
+        throw std::invalid_argument("El umbral de deriva no puede ser negativo.");
+    intervalo_balance = intervalo;
+    umbral_deriva = umbral;
+    balance = BalanceConservado();
+    balance.t_inicial = tiempo;
+    double escala = 0.0;
+    SumeConservadas(balance.energia, balance.px, balance.py, escala);
+}
+
+/**
+ * @brief Compara los totales llevados con una suma completa y los reemplaza por ella.
+ */
+template <class Real>
+void SistemaT<Real>::ResincroniceBalance() {
+    double energia, px, py, escala;
+    SumeConservadas(energia, px, py, escala);
+    const double de = energia > 0.0 ? std::fabs(energia - balance.energia) / energia : 0.0;
+    const double dp = escala > 0.0 ? std::hypot(px - balance.px, py - balance.py) / escala : 0.0;
+    balance.deriva_energia = std::max(balance.deriva_energia, de);
+    balance.deriva_momento = std::max(balance.deriva_momento, dp);
+    if (umbral_deriva > 0.0 && (de > umbral_deriva || dp > umbral_deriva)) {
+        ++balance.alarmas;
+        std::cerr << "Alarma: deriva de las cantidades conservadas en t = " << tiempo
+                  << " (energía " << de << ", momento " << dp << ", umbral " << umbral_deriva << ")\n";
+    }
+    balance.energia = energia;
+    balance.px = px;
+    balance.py = py;
+    ++balance.resincronizaciones;
+}
+
+/**
+ * @brief Avanza el sistema con la dinámica dirigida por eventos.
+ *
+ * La cola de eventos se construye en el primer paso tras cualquier cambio
+ * de la caja, de las bolas o del integrador. MotorEventos trabaja sobre
+ * bolas en double; en float este paso no se puede elegir.
+ *
+ * @param dt Intervalo de tiempo a avanzar.
+ */
+template <class Real>
+void SistemaT<Real>::PasoEventos(double dt) {
+    if constexpr (doble) {
+        CronometroFase cronometro(instrumentacion, Fase::Eventos);
+        if (!eventos_listos) {
+            eventos.Inicie(bolas, caja);
+            eventos_listos = true;
+        }
+        const auto choques_antes = eventos.GetChoquesBolas();
+        AcumuleImpulso(eventos.Avance(bolas, dt));
+        if constexpr (INSTRUMENTACION_ACTIVA)
+            instrumentacion.choques_eventos += eventos.GetChoquesBolas() - choques_antes;
+        (void)choques_antes;
+    } else {
+        (void)dt;
+        throw std::logic_error("El integrador por eventos requiere precisión doble.");
+    }
 }
 
 /**
@@ -92,18 +480,137 @@ void Sistema::PasoVerlet(double dt) {
  * @param W Ancho de la caja.
  * @param H Alto de la caja.
  */
-void Sistema::DefinaCaja(double W, double H) {
+template <class Real>
+void SistemaT<Real>::DefinaCaja(double W, double H) {
     caja.Defina(W, H);
+    celdas_listas = false;
+    eventos_listos = false;
+    vecinos.Invalide();
 }
 
 /**
  * @brief Reserva memoria para N bolas en la simulación.
  * @param N Número de bolas.
  */
-void Sistema::Reserve(int N) {
-    bolas.resize(N);
+template <class Real>
+void SistemaT<Real>::Reserve(int N) {
+    bolas.Redimensione(N);
+    celdas_listas = false;
+    eventos_listos = false;
+    vecinos.Invalide();
+    reordenadas = false;
 }
 
+namespace {
+
+/** Bolas de cada bloque de inicialización; cada bloque usa su propio flujo aleatorio. */
+constexpr std::size_t BOLAS_POR_FLUJO = 4096;
+
+/**
+ * @brief Recorre las bolas de la rejilla inicial por bloques en paralelo.
+ *
+ * El bloque b recibe una copia de `rng` saltada b veces; al final `rng` queda
+ * después del último salto, así sus números siguientes no se repiten en ningún bloque.
+ * Cada bola depende solo de su índice y de su flujo, no del número de hilos.
+ *
+ * @param N Número de bolas.
+ * @param W,H Dimensiones de la caja.
+ * @param r Radio.
+ * @param rng Generador del sistema.
+ * @param hilos Hilos de OpenMP.
+ * @param velocidad Sorteo `velocidad(generador, i, vx, vy)` de la bola i.
+ * @param guarde Llamada `guarde(i, x, y, vx, vy)` con cada bola, en orden dentro de cada bloque.
+ */
+template <class Velocidad, class Guarde>
+void RecorraRejilla(long N, double W, double H, double r, Xoshiro256& rng, int hilos, Velocidad velocidad,
+                    Guarde guarde) {
+    const long cols = std::max(1L, static_cast<long>(std::sqrt(N * W / H)));
+    const long rows = (N + cols - 1) / cols;
+
+    const double dx = (cols > 1) ? (W - 2*r) / (cols - 1) : W / 2.0;
+    const double dy = (rows > 1) ? (H - 2*r) / (rows - 1) : H / 2.0;
+
+    const long bloques = (N + static_cast<long>(BOLAS_POR_FLUJO) - 1) / static_cast<long>(BOLAS_POR_FLUJO);
+    std::vector<Xoshiro256> flujos;
+    flujos.reserve(bloques);
+    for (long b = 0; b < bloques; ++b) {
+        flujos.push_back(rng);
+        rng.Salte();
+    }
+
+    #pragma omp parallel for num_threads(hilos) schedule(static)
+    for (long b = 0; b < bloques; ++b) {
+        Xoshiro256 generador = flujos[b];
+        const long inicio = b * static_cast<long>(BOLAS_POR_FLUJO);
+        const long fin = std::min<long>(N, inicio + static_cast<long>(BOLAS_POR_FLUJO));
+        long row = inicio / cols;
+        long col = inicio % cols;
+        for (long i = inicio; i < fin; ++i) {
+            double vx, vy;
+            velocidad(generador, i, vx, vy);
+            guarde(i, (cols > 1) ? r + col * dx : W / 2.0, (rows > 1) ? r + row * dy : H / 2.0, vx, vy);
+            if (++col == cols) {
+                col = 0;
+                ++row;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Ubica las bolas en rejilla y sortea sus velocidades por bloques en paralelo.
+ * @param P Bolas (ya dimensionadas).
+ * @param W,H Dimensiones de la caja.
+ * @param m Masa.
+ * @param r Radio.
+ * @param rng Generador del sistema.
+ * @param hilos Hilos de OpenMP.
+ * @param velocidad Sorteo `velocidad(generador, i, vx, vy)` de la bola i.
+ */
+template <class Real, class Velocidad>
+void LleneRejilla(ParticulasT<Real>& P, double W, double H, double m, double r, Xoshiro256& rng, int hilos,
+                  Velocidad velocidad) {
+    const double inv_m = 1.0 / m;
+    RecorraRejilla(static_cast<long>(P.Tamano()), W, H, r, rng, hilos, velocidad,
+                   [&](long i, double x, double y, double vx, double vy) {
+        P.x[i] = static_cast<Real>(x);
+        P.y[i] = static_cast<Real>(y);
+        P.vx[i] = static_cast<Real>(vx);
+        P.vy[i] = static_cast<Real>(vy);
+        P.m[i] = static_cast<Real>(m);
+        P.inv_m[i] = static_cast<Real>(inv_m);
+        P.r[i] = static_cast<Real>(r);
+        P.id[i] = static_cast<std::uint32_t>(i);
+    });
+}
+
+/** @brief Rapidez uniforme en [0, vmax) con dirección uniforme (InicialiceRejilla). */
+struct VelocidadUniforme {
+    double vmax;  ///< Rapidez máxima.
+    bool alterna; ///< Invierte la velocidad de las bolas impares.
+
+    void operator()(Xoshiro256& g, long i, double& vx, double& vy) const {
+        double ang = 2 * M_PI * g.Uniforme();
+        double v = vmax * g.Uniforme();
+        double signo = alterna && (i % 2 != 0) ? -1.0 : 1.0;
+        vx = signo * v * std::cos(ang);
+        vy = signo * v * std::sin(ang);
+    }
+};
+
+/** @brief Componentes normales de desviación sigma = sqrt(kT/m) (InicialiceMaxwell). */
+struct VelocidadMaxwell {
+    double sigma; ///< Desviación de cada componente.
+
+    void operator()(Xoshiro256& g, long, double& vx, double& vy) const {
+        g.Normales(vx, vy);
+        vx *= sigma;
+        vy *= sigma;
+    }
+};
+
+} // namespace
+
 /**
  * @brief Inicializa las bolas en una distribución de rejilla.
  * 
@@ -115,50 +622,144 @@ void Sistema::Reserve(int N) {
  * @param vmax Velocidad máxima inicial.
  * @param alterna Si es true, alterna la dirección de las velocidades.
  */
-void Sistema::InicialiceRejilla(double m, double r, double vmax, bool alterna) {
-    int N = bolas.size();
+template <class Real>
+void SistemaT<Real>::InicialiceRejilla(double m, double r, double vmax, bool alterna) {
+    int N = bolas.Tamano();
     if (N == 0) return;
 
-    srand(time(nullptr));
-    double W = caja.GetW(), H = caja.GetH();
+    LleneRejilla(bolas, caja.GetW(), caja.GetH(), m, r, rng, hilos, VelocidadUniforme{vmax, alterna});
+    celdas_listas = false;
+    eventos_listos = false;
+    vecinos.Invalide();
+    reordenadas = false;
+    DefinaBalance(intervalo_balance, umbral_deriva);
+
+    std::cout << "Inicialización en rejilla completada con " << N << " bolas.\n";
+}
 
-    int cols = static_cast<int>(std::sqrt(N * W / H));
-    int rows = (N > 0) ? (N + cols - 1) / cols : 0;
+/**
+ * @brief Inicializa las bolas en rejilla con velocidades normales de varianza kT/m.
+ * @param m Masa de cada bola.
+ * @param r Radio de cada bola.
+ * @param kT Temperatura.
+ */
+template <class Real>
+void SistemaT<Real>::InicialiceMaxwell(double m, double r, double kT) {
+    if (kT < 0.0)
+        throw std::invalid_argument("La temperatura inicial no puede ser negativa.");
+    int N = bolas.Tamano();
+    if (N == 0) return;
 
-    double dx = (cols > 1) ? (W - 2*r) / (cols - 1) : W / 2.0;
-    double dy = (rows > 1) ? (H - 2*r) / (rows - 1) : H / 2.0;
+    LleneRejilla(bolas, caja.GetW(), caja.GetH(), m, r, rng, hilos, VelocidadMaxwell{std::sqrt(kT / m)});
+    celdas_listas = false;
+    eventos_listos = false;
+    vecinos.Invalide();
+    reordenadas = false;
+    DefinaBalance(intervalo_balance, umbral_deriva);
 
-    for (int i = 0; i < N; ++i) {
-        int row = i / cols;
-        int col = i % cols;
+    std::cout << "Inicialización de Maxwell–Boltzmann completada con " << N << " bolas.\n";
+}
 
-        double x0 = (cols > 1) ? r + col * dx : W / 2.0;
-        double y0 = (rows > 1) ? r + row * dy : H / 2.0;
+/**
+ * @brief Copia posiciones y velocidades de las bolas en un cuadro.
+ * @param c Cuadro de destino.
+ * @param t Tiempo actual de la simulación.
+ */
+template <class Real>
+void SistemaT<Real>::CopieCuadro(Cuadro& c, double t) const {
+    CronometroFase cronometro(instrumentacion, Fase::Salida);
+    const size_t N = bolas.Tamano();
+    c.t = t;
+    c.Redimensione(N);
+    c.id.clear();
+    if (!reordenadas) {
+        std::copy(bolas.x.begin(), bolas.x.end(), c.x.begin());
+        std::copy(bolas.y.begin(), bolas.y.end(), c.y.begin());
+        std::copy(bolas.vx.begin(), bolas.vx.end(), c.vx.begin());
+        std::copy(bolas.vy.begin(), bolas.vy.end(), c.vy.begin());
+        return;
+    }
+    for (size_t k = 0; k < N; ++k) {
+        const std::uint32_t i = bolas.id[k];
+        c.x[i] = bolas.x[k];
+        c.y[i] = bolas.y[k];
+        c.vx[i] = bolas.vx[k];
+        c.vy[i] = bolas.vy[k];
+    }
+}
 
-        double ang = 2 * M_PI * ((double)rand() / RAND_MAX);
-        double v = vmax * ((double)rand() / RAND_MAX);
-        double vx = alterna && (i % 2 != 0) ? -v * cos(ang) : v * cos(ang);
-        double vy = alterna && (i % 2 != 0) ? -v * sin(ang) : v * sin(ang);
+/**
+ * @brief Copia en un cuadro las bolas trazadoras o las que están dentro de la región.
+ * @param c Cuadro de destino.
+ * @param t Tiempo actual de la simulación.
+ * @param seleccion Selección de salida.
+ */
+template <class Real>
+void SistemaT<Real>::CopieCuadro(Cuadro& c, double t, const SeleccionSalida& seleccion) const {
+    if (seleccion.Completa()) {
+        CopieCuadro(c, t);
+        return;
+    }
+    CronometroFase cronometro(instrumentacion, Fase::Salida);
+    const size_t N = bolas.Tamano();
+    c.t = t;
 
-        bolas[i].Inicie(x0, y0, vx, vy, m, r);
+    // Solo trazadores: el cuadro tiene siempre las mismas bolas, cada una en su ranura
+    if (!seleccion.Variable()) {
+        const std::vector<std::uint32_t>& ids = seleccion.GetTrazadores();
+        c.Redimensione(ids.size());
+        c.id.assign(ids.begin(), ids.end());
+        if (!reordenadas) {
+            for (size_t s = 0; s < ids.size(); ++s) {
+                const std::uint32_t i = ids[s];
+                c.x[s] = bolas.x[i];
+                c.y[s] = bolas.y[i];
+                c.vx[s] = bolas.vx[i];
+                c.vy[s] = bolas.vy[i];
+            }
+            return;
+        }
+        for (size_t k = 0; k < N; ++k) {
+            const std::int32_t s = seleccion.Ranura(bolas.id[k]);
+            if (s < 0) continue;
+            c.x[s] = bolas.x[k];
+            c.y[s] = bolas.y[k];
+            c.vx[s] = bolas.vx[k];
+            c.vy[s] = bolas.vy[k];
+        }
+        return;
     }
 
-    std::cout << "Inicialización en rejilla completada con " << N << " bolas.\n";
+    // Región: primero se eligen las bolas (id << 32 | posición) y luego se copian en orden de id
+    const RegionSalida& region = seleccion.GetRegion();
+    orden_salida.clear();
+    for (size_t k = 0; k < N; ++k) {
+        const std::uint32_t i = reordenadas ? bolas.id[k] : static_cast<std::uint32_t>(k);
+        if (seleccion.EsTrazadora(i) && region.Contiene(bolas.x[k], bolas.y[k]))
+            orden_salida.push_back(static_cast<std::uint64_t>(i) << 32 | k);
+    }
+    if (reordenadas)
+        std::sort(orden_salida.begin(), orden_salida.end());
+    const size_t M = orden_salida.size();
+    c.Redimensione(M);
+    c.id.resize(M);
+    for (size_t s = 0; s < M; ++s) {
+        const size_t k = orden_salida[s] & 0xFFFFFFFFu;
+        c.id[s] = static_cast<std::uint32_t>(orden_salida[s] >> 32);
+        c.x[s] = bolas.x[k];
+        c.y[s] = bolas.y[k];
+        c.vx[s] = bolas.vx[k];
+        c.vy[s] = bolas.vy[k];
+    }
 }
 
 /**
  * @brief Escribe el encabezado de columnas en un archivo de salida.
  * @param f Archivo de salida abierto.
  */
-void Sistema::Encabezado(std::ofstream& f) {
-    f << "# " << std::setw(9) << "t";
-    for (size_t i = 0; i < bolas.size(); i++) {
-        f << std::setw(15) << "x" + std::to_string(i)
-          << std::setw(15) << "y" + std::to_string(i)
-          << std::setw(15) << "vx" + std::to_string(i)
-          << std::setw(15) << "vy" + std::to_string(i);
-    }
-    f << "\n";
+template <class Real>
+void SistemaT<Real>::Encabezado(std::ofstream& f) {
+    EscribaEncabezadoTexto(f, bolas.Tamano());
 }
 
 /**
@@ -167,13 +768,353 @@ void Sistema::Encabezado(std::ofstream& f) {
  * @param f Archivo de salida abierto.
  * @param t Tiempo actual de la simulación.
  */
-void Sistema::Guarde(std::ofstream& f, double t) {
-    f << std::setw(10) << std::fixed << std::setprecision(4) << t;
-    for (const auto& b : bolas) {
-        f << std::setw(15) << std::fixed << std::setprecision(6) << b.Getx()
-          << std::setw(15) << std::fixed << std::setprecision(6) << b.Gety()
-          << std::setw(15) << std::fixed << std::setprecision(6) << b.Getvx()
-          << std::setw(15) << std::fixed << std::setprecision(6) << b.Getvy();
+template <class Real>
+void SistemaT<Real>::Guarde(std::ofstream& f, double t) {
+    // En double y sin reordenar se escribe directo desde las bolas
+    if constexpr (doble) {
+        if (!reordenadas) {
+            CronometroFase cronometro(instrumentacion, Fase::Salida);
+            EscribaFilaTexto(f, t, bolas.x.data(), bolas.y.data(), bolas.vx.data(), bolas.vy.data(), bolas.Tamano());
+            return;
+        }
+    }
+    CopieCuadro(cuadro_texto, t);
+    CronometroFase cronometro(instrumentacion, Fase::Salida);
+    EscribaFilaTexto(f, t, cuadro_texto.x.data(), cuadro_texto.y.data(), cuadro_texto.vx.data(),
+                     cuadro_texto.vy.data(), cuadro_texto.Tamano());
+}
+
+namespace {
+
+/** @brief Escribe un valor trivialmente copiable en binario. */
+template <class T>
+void EscribaValor(std::ofstream& f, const T& v) {
+    f.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+/** @brief Lee un valor trivialmente copiable; lanza si el archivo se acaba. */
+template <class T>
+T LeaValor(std::ifstream& f) {
+    T v;
+    if (!f.read(reinterpret_cast<char*>(&v), sizeof(T)))
+        throw std::runtime_error("Checkpoint truncado.");
+    return v;
+}
+
+/** @brief Escribe un arreglo de N elementos como doubles (los float se convierten). */
+template <class Real>
+void EscribaArreglo(std::ofstream& f, const VectorAlineado<Real>& a) {
+    if constexpr (std::is_same_v<Real, double>) {
+        f.write(reinterpret_cast<const char*>(a.data()), static_cast<std::streamsize>(a.size() * sizeof(double)));
+    } else {
+        const VectorAlineado<double> dobles(a.begin(), a.end());
+        EscribaArreglo(f, dobles);
+    }
+}
+
+/** @brief Lee un arreglo de doubles del tamaño actual de `a`, convirtiéndolo a su tipo. */
+template <class Real>
+void LeaArreglo(std::ifstream& f, VectorAlineado<Real>& a) {
+    if constexpr (std::is_same_v<Real, double>) {
+        if (!f.read(reinterpret_cast<char*>(a.data()), static_cast<std::streamsize>(a.size() * sizeof(double))))
+            throw std::runtime_error("Checkpoint truncado.");
+    } else {
+        VectorAlineado<double> dobles(a.size());
+        LeaArreglo(f, dobles);
+        std::copy(dobles.begin(), dobles.end(), a.begin());
+    }
+}
+
+const char MAGIA_CHECKPOINT[8] = {'B', 'I', 'L', 'L', 'A', 'R', 'C', 'P'};
+const std::uint32_t VERSION_CHECKPOINT = 3;
+
+/** @brief Campos del checkpoint anteriores a los arreglos de las bolas. */
+struct CabeceraCheckpoint {
+    std::uint32_t version = 0;
+    std::uint32_t integrador = 0;
+    std::uint32_t motor = 0;
+    std::int32_t hilos = 1;
+    std::uint8_t determinista = 1;
+    double W = 0.0, H = 0.0;
+    double tiempo = 0.0;
+    std::int64_t pasos = 0;
+    std::uint64_t estado_rng[4] = {0, 0, 0, 0};
+    std::uint64_t N = 0;
+};
+
+/**
+ * @brief Abre un checkpoint y lee y valida su cabecera; `f` queda al inicio de los arreglos.
+ *
+ * N se contrasta con lo que queda del archivo antes de reservar nada: cada bola ocupa
+ * seis double (x, y, vx, vy, m, r) y, desde la versión 3, un identificador uint32.
+ *
+ * @param f Archivo (se abre aquí).
+ * @param ruta Ruta del checkpoint.
+ * @return Cabecera.
+ */
+CabeceraCheckpoint LeaCabecera(std::ifstream& f, const std::string& ruta) {
+    f.open(ruta, std::ios::binary);
+    if (!f)
+        throw std::runtime_error("No se pudo abrir el checkpoint: " + ruta);
+
+    char magia[8];
+    if (!f.read(magia, sizeof(magia)) || std::memcmp(magia, MAGIA_CHECKPOINT, sizeof(magia)) != 0)
+        throw std::runtime_error("El archivo no es un checkpoint del billar: " + ruta);
+    CabeceraCheckpoint c;
+    // La versión 2 no tenía identificadores: sus bolas están en el orden original
+    c.version = LeaValor<std::uint32_t>(f);
+    if (c.version != VERSION_CHECKPOINT && c.version != 2)
+        throw std::runtime_error("Versión de checkpoint no soportada: " + ruta);
+
+    c.integrador = LeaValor<std::uint32_t>(f);
+    c.motor = LeaValor<std::uint32_t>(f);
+    c.hilos = LeaValor<std::int32_t>(f);
+    c.determinista = LeaValor<std::uint8_t>(f);
+    c.W = LeaValor<double>(f);
+    c.H = LeaValor<double>(f);
+    c.tiempo = LeaValor<double>(f);
+    c.pasos = LeaValor<std::int64_t>(f);
+    for (std::uint64_t& palabra : c.estado_rng)
+        palabra = LeaValor<std::uint64_t>(f);
+    if (c.integrador > static_cast<std::uint32_t>(Integrador::Eventos) ||
+        c.motor > static_cast<std::uint32_t>(MotorColisiones::Vecinos) || c.hilos < 1 ||
+        (c.estado_rng[0] | c.estado_rng[1] | c.estado_rng[2] | c.estado_rng[3]) == 0)
+        throw std::runtime_error("Checkpoint corrupto: " + ruta);
+    c.N = LeaValor<std::uint64_t>(f);
+
+    const std::streampos inicio = f.tellg();
+    f.seekg(0, std::ios::end);
+    const std::uint64_t restante = static_cast<std::uint64_t>(f.tellg() - inicio);
+    f.seekg(inicio);
+    const std::uint64_t por_bola = 6 * sizeof(double) + (c.version >= 3 ? sizeof(std::uint32_t) : 0);
+    if (!f || c.N > restante / por_bola)
+        throw std::runtime_error("Checkpoint corrupto: " + ruta);
+    return c;
+}
+
+} // namespace
+
+/**
+ * @brief Escribe el checkpoint en un archivo temporal y lo renombra.
+ * @param ruta Ruta final del checkpoint.
+ */
+template <class Real>
+void SistemaT<Real>::GuardeCheckpoint(const std::string& ruta) const {
+    const std::string temporal = ruta + ".tmp";
+    {
+        std::ofstream f(temporal, std::ios::binary | std::ios::trunc);
+        if (!f)
+            throw std::runtime_error("No se pudo abrir el checkpoint: " + temporal);
+
+        f.write(MAGIA_CHECKPOINT, sizeof(MAGIA_CHECKPOINT));
+        EscribaValor(f, VERSION_CHECKPOINT);
+        EscribaValor(f, static_cast<std::uint32_t>(integrador_actual));
+        EscribaValor(f, static_cast<std::uint32_t>(motor_actual));
+        EscribaValor(f, static_cast<std::int32_t>(hilos));
+        EscribaValor(f, static_cast<std::uint8_t>(determinista));
+        EscribaValor(f, caja.GetW());
+        EscribaValor(f, caja.GetH());
+        EscribaValor(f, tiempo);
+        EscribaValor(f, static_cast<std::int64_t>(pasos));
+        for (int k = 0; k < 4; ++k)
+            EscribaValor(f, rng.Estado(k));
+        EscribaValor(f, static_cast<std::uint64_t>(bolas.Tamano()));
+        EscribaArreglo(f, bolas.x);
+        EscribaArreglo(f, bolas.y);
+        EscribaArreglo(f, bolas.vx);
+        EscribaArreglo(f, bolas.vy);
+        EscribaArreglo(f, bolas.m);
+        EscribaArreglo(f, bolas.r);
+        f.write(reinterpret_cast<const char*>(bolas.id.data()),
+                static_cast<std::streamsize>(bolas.id.size() * sizeof(std::uint32_t)));
+
+        f.flush();
+        if (!f)
+            throw std::runtime_error("Error al escribir el checkpoint: " + temporal);
+    }
+    std::error_code ec;
+    std::filesystem::rename(temporal, ruta, ec);
+    if (ec)
+        throw std::runtime_error("No se pudo renombrar el checkpoint a " + ruta + ": " + ec.message());
+}
+
+/**
+ * @brief Lee un checkpoint y reemplaza el estado del sistema.
+ *
+ * El estado se arma en variables locales y solo se copia al sistema si
+ * el archivo se leyó completo.
+ *
+ * @param ruta Ruta del checkpoint.
+ */
+template <class Real>
+void SistemaT<Real>::CargueCheckpoint(const std::string& ruta) {
+    std::ifstream f;
+    const CabeceraCheckpoint cab = LeaCabecera(f, ruta);
+    if (!doble && cab.integrador == static_cast<std::uint32_t>(Integrador::Eventos))
+        throw std::runtime_error("El checkpoint usa el integrador por eventos, que requiere precisión doble: " + ruta);
+
+    const std::uint64_t N = cab.N;
+    ParticulasT<Real> nuevas;
+    nuevas.Redimensione(N);
+    LeaArreglo(f, nuevas.x);
+    LeaArreglo(f, nuevas.y);
+    LeaArreglo(f, nuevas.vx);
+    LeaArreglo(f, nuevas.vy);
+    LeaArreglo(f, nuevas.m);
+    LeaArreglo(f, nuevas.r);
+    for (std::size_t i = 0; i < N; ++i)
+        nuevas.inv_m[i] = static_cast<Real>(1.0 / nuevas.m[i]);
+    bool permutadas = false;
+    if (cab.version >= 3) {
+        if (!f.read(reinterpret_cast<char*>(nuevas.id.data()),
+                    static_cast<std::streamsize>(N * sizeof(std::uint32_t))))
+            throw std::runtime_error("Checkpoint truncado.");
+        std::vector<bool> visto(N, false);
+        for (std::size_t i = 0; i < N; ++i) {
+            const std::uint32_t k = nuevas.id[i];
+            if (k >= N || visto[k])
+                throw std::runtime_error("Checkpoint corrupto: " + ruta);
+            visto[k] = true;
+            permutadas = permutadas || k != i;
+        }
+    }
+
+    integrador_actual = static_cast<Integrador>(cab.integrador);
+    motor_actual = static_cast<MotorColisiones>(cab.motor);
+    hilos = cab.hilos;
+    determinista = cab.determinista != 0;
+    caja.Defina(cab.W, cab.H);
+    tiempo = cab.tiempo;
+    pasos = static_cast<long>(cab.pasos);
+    rng.DefinaEstado(cab.estado_rng);
+    bolas = std::move(nuevas);
+    reordenadas = permutadas;
+    ElijaPaso();
+    celdas_listas = false;
+    eventos_listos = false;
+    vecinos.Invalide();
+    DefinaBalance(intervalo_balance, umbral_deriva);
+}
+
+template class SistemaT<double>;
+template class SistemaT<float>;
+
+/**
+ * @brief Genera la rejilla inicial bola por bola y guarda solo las de la franja.
+ * @param N Número total de bolas.
+ * @param C Caja.
+ * @param m Masa.
+ * @param r Radio.
+ * @param maxwell Velocidades de Maxwell–Boltzmann.
+ * @param vmax Rapidez máxima.
+ * @param kT Temperatura.
+ * @param semilla Semilla.
+ * @param desde,hasta Franja.
+ */
+Particulas GenereFranja(std::uint64_t N, const Caja& C, double m, double r, bool maxwell, double vmax, double kT,
+                        std::uint64_t semilla, double desde, double hasta) {
+    if (maxwell && kT < 0.0)
+        throw std::invalid_argument("La temperatura inicial no puede ser negativa.");
+    Particulas P;
+    if (N == 0) return P;
+    Xoshiro256 rng(semilla);
+    const double inv_m = 1.0 / m;
+    // Un solo hilo: las bolas de la franja se agregan en orden de id.
+    auto guarde = [&](long i, double x, double y, double vx, double vy) {
+        if (!(x >= desde && x < hasta)) return;
+        P.x.push_back(x);
+        P.y.push_back(y);
+        P.vx.push_back(vx);
+        P.vy.push_back(vy);
+        P.m.push_back(m);
+        P.inv_m.push_back(inv_m);
+        P.r.push_back(r);
+        P.id.push_back(static_cast<std::uint32_t>(i));
+    };
+    if (maxwell)
+        RecorraRejilla(static_cast<long>(N), C.GetW(), C.GetH(), r, rng, 1, VelocidadMaxwell{std::sqrt(kT / m)}, guarde);
+    else
+        RecorraRejilla(static_cast<long>(N), C.GetW(), C.GetH(), r, rng, 1, VelocidadUniforme{vmax, false}, guarde);
+    return P;
+}
+
+/**
+ * @brief Lee la cabecera de un checkpoint.
+ * @param ruta Ruta del checkpoint.
+ */
+EncabezadoCheckpoint LeaEncabezadoCheckpoint(const std::string& ruta) {
+    std::ifstream f;
+    const CabeceraCheckpoint cab = LeaCabecera(f, ruta);
+    EncabezadoCheckpoint e;
+    e.caja.Defina(cab.W, cab.H);
+    e.tiempo = cab.tiempo;
+    e.N = cab.N;
+    return e;
+}
+
+/**
+ * @brief Lee por bloques las bolas de un checkpoint con x en [desde, hasta).
+ *
+ * Primero recorre las abscisas y anota qué bolas quedan; luego recorre cada uno de
+ * los demás arreglos copiando solo esas. Cada arreglo se lee de principio a fin en
+ * bloques de 64 Ki valores.
+ *
+ * @param ruta Ruta del checkpoint.
+ * @param desde,hasta Franja.
+ */
+Particulas LeaFranjaCheckpoint(const std::string& ruta, double desde, double hasta) {
+    constexpr std::uint64_t BLOQUE = 1 << 16;
+    std::ifstream f;
+    const CabeceraCheckpoint cab = LeaCabecera(f, ruta);
+    const std::uint64_t N = cab.N;
+
+    std::vector<std::uint64_t> propias;
+    Particulas P;
+    std::vector<double> bloque;
+    auto recorra = [&](auto&& tome) {
+        for (std::uint64_t inicio = 0, k = 0; inicio < N; inicio += BLOQUE) {
+            const std::uint64_t n = std::min(BLOQUE, N - inicio);
+            bloque.resize(n);
+            if (!f.read(reinterpret_cast<char*>(bloque.data()), static_cast<std::streamsize>(n * sizeof(double))))
+                throw std::runtime_error("Checkpoint truncado.");
+            tome(inicio, k);
+        }
+    };
+    recorra([&](std::uint64_t inicio, std::uint64_t&) {
+        for (std::uint64_t i = 0; i < bloque.size(); ++i)
+            if (bloque[i] >= desde && bloque[i] < hasta) {
+                propias.push_back(inicio + i);
+                P.x.push_back(bloque[i]);
+            }
+    });
+    for (VectorAlineado<double>* campo : {&P.y, &P.vx, &P.vy, &P.m, &P.r}) {
+        campo->reserve(propias.size());
+        recorra([&](std::uint64_t inicio, std::uint64_t& k) {
+            for (; k < propias.size() && propias[k] < inicio + bloque.size(); ++k)
+                campo->push_back(bloque[propias[k] - inicio]);
+        });
+    }
+    P.inv_m.resize(P.m.size());
+    for (std::size_t a = 0; a < P.m.size(); ++a)
+        P.inv_m[a] = 1.0 / P.m[a];
+
+    P.id.resize(propias.size());
+    if (cab.version < 3) {
+        for (std::size_t a = 0; a < propias.size(); ++a)
+            P.id[a] = static_cast<std::uint32_t>(propias[a]);
+        return P;
+    }
+    std::vector<std::uint32_t> ids;
+    for (std::uint64_t inicio = 0, k = 0; inicio < N; inicio += BLOQUE) {
+        const std::uint64_t n = std::min(BLOQUE, N - inicio);
+        ids.resize(n);
+        if (!f.read(reinterpret_cast<char*>(ids.data()), static_cast<std::streamsize>(n * sizeof(std::uint32_t))))
+            throw std::runtime_error("Checkpoint truncado.");
+        for (; k < propias.size() && propias[k] < inicio + n; ++k) {
+            P.id[k] = ids[propias[k] - inicio];
+            if (P.id[k] >= N)
+                throw std::runtime_error("Checkpoint corrupto: " + ruta);
+        }
     }
-    f << "\n";
+    return P;
 }
@@ -0,0 +1,229 @@
+/**
+ * @file Trayectoria.cpp
+ * @brief Implementación de los escritores de trayectorias en texto y binario.
+ */
+
+#include "Trayectoria.h"
+#include <cstring>
+#include <iomanip>
+#include <stdexcept>
+
+namespace {
+
+/** @brief Cabecera binaria tal como se guarda en disco (64 bytes). */
+struct CabeceraDisco {
+    char magia[8];
+    std::uint32_t version;
+    std::uint32_t bytes_real;
+    std::uint32_t campos;
+    std::uint32_t banderas;
+    std::uint64_t N;
+    double W, H, R, dt_frame;
+};
+static_assert(sizeof(CabeceraDisco) == 64, "La cabecera binaria debe ocupar 64 bytes");
+
+/** @brief Copia N valores double a un búfer como float o double. */
+template <class Real>
+char* Empaquete(char* p, const Cuadro& c) {
+    Real* q = reinterpret_cast<Real*>(p);
+    const std::size_t N = c.Tamano();
+    for (std::size_t i = 0; i < N; ++i) {
+        *q++ = static_cast<Real>(c.x[i]);
+        *q++ = static_cast<Real>(c.y[i]);
+        *q++ = static_cast<Real>(c.vx[i]);
+        *q++ = static_cast<Real>(c.vy[i]);
+    }
+    return reinterpret_cast<char*>(q);
+}
+
+} // namespace
+
+// ==========================================================
+//                      FORMATO DE TEXTO
+// ==========================================================
+
+/**
+ * @brief Escribe la línea de encabezado de columnas.
+ * @param f Flujo de salida.
+ * @param N Número de bolas.
+ * @param ids Ids de las bolas (nulo: 0..N-1).
+ */
+void EscribaEncabezadoTexto(std::ostream& f, std::size_t N, const std::uint32_t* ids) {
+    f << "# " << std::setw(9) << "t";
+    for (std::size_t i = 0; i < N; i++) {
+        const std::string n = std::to_string(ids ? ids[i] : i);
+        f << std::setw(15) << "x" + n
+          << std::setw(15) << "y" + n
+          << std::setw(15) << "vx" + n
+          << std::setw(15) << "vy" + n;
+    }
+    f << "\n";
+}
+
+/**
+ * @brief Escribe una fila de datos.
+ *
+ * El formato de punto fijo se fija una sola vez por fila; solo el ancho
+ * de campo (que no es persistente) se repite en cada valor.
+ */
+void EscribaFilaTexto(std::ostream& f, double t, const double* x, const double* y,
+                      const double* vx, const double* vy, std::size_t N) {
+    f << std::fixed << std::setprecision(4) << std::setw(10) << t << std::setprecision(6);
+    for (std::size_t i = 0; i < N; ++i) {
+        f << std::setw(15) << x[i]
+          << std::setw(15) << y[i]
+          << std::setw(15) << vx[i]
+          << std::setw(15) << vy[i];
+    }
+    f << "\n";
+}
+
+/**
+ * @brief Abre el archivo de texto y escribe los parámetros como comentarios.
+ * @param ruta Ruta del archivo.
+ * @param cab Parámetros de la corrida.
+ */
+EscritorTexto::EscritorTexto(const std::string& ruta, const CabeceraTrayectoria& cab)
+    : f(ruta), por_bola(cab.variable) {
+    if (!f)
+        throw std::runtime_error("No se pudo abrir el archivo de salida: " + ruta);
+    f << "# W: " << cab.W << "\n";
+    f << "# H: " << cab.H << "\n";
+    f << "# R_BOLA: " << cab.R << "\n";
+    f << "# N_BOLAS: " << cab.N << "\n";
+    f << "# DT_FRAME: " << cab.dt_frame << "\n";
+    if (cab.capacidad > 0)
+        f << "# CAPACIDAD_MAXIMA_RECOMENDADA: " << cab.capacidad << "\n";
+    if (por_bola) {
+        f << "# " << std::setw(9) << "t" << std::setw(10) << "id" << std::setw(15) << "x" << std::setw(15) << "y"
+          << std::setw(15) << "vx" << std::setw(15) << "vy" << "\n";
+        return;
+    }
+    if (!cab.ids.empty() && cab.ids.size() != cab.N)
+        throw std::invalid_argument("La cabecera debe tener un id por bola.");
+    EscribaEncabezadoTexto(f, cab.N, cab.ids.empty() ? nullptr : cab.ids.data());
+}
+
+/** @brief Escribe un cuadro como una fila de texto, o como una línea por bola. */
+void EscritorTexto::Escriba(const Cuadro& c) {
+    if (!por_bola) {
+        EscribaFilaTexto(f, c.t, c.x.data(), c.y.data(), c.vx.data(), c.vy.data(), c.Tamano());
+        return;
+    }
+    const bool con_id = c.id.size() == c.Tamano();
+    for (std::size_t i = 0; i < c.Tamano(); ++i) {
+        f << std::fixed << std::setprecision(4) << std::setw(10) << c.t
+          << std::setw(10) << (con_id ? c.id[i] : i) << std::setprecision(6)
+          << std::setw(15) << c.x[i] << std::setw(15) << c.y[i]
+          << std::setw(15) << c.vx[i] << std::setw(15) << c.vy[i] << "\n";
+    }
+}
+
+/** @brief Cierra el archivo de texto. */
+void EscritorTexto::Cierre() {
+    if (f.is_open()) f.close();
+}
+
+// ==========================================================
+//                   CONTEO POR CUADRO
+// ==========================================================
+
+/**
+ * @brief Abre el archivo de conteos.
+ * @param ruta Ruta del archivo.
+ */
+EscritorConteo::EscritorConteo(const std::string& ruta) : f(ruta) {
+    if (!f)
+        throw std::runtime_error("No se pudo abrir el archivo de salida: " + ruta);
+    f << "# t n\n";
+}
+
+/** @brief Escribe el instante y el número de bolas del cuadro. */
+void EscritorConteo::Escriba(const Cuadro& c) {
+    f << std::fixed << std::setprecision(4) << c.t << ' ' << c.Tamano() << '\n';
+}
+
+/** @brief Cierra el archivo de conteos. */
+void EscritorConteo::Cierre() {
+    if (f.is_open()) f.close();
+}
+
+// ==========================================================
+//                    VARIOS ESCRITORES
+// ==========================================================
+
+/**
+ * @brief Agrega un escritor a la lista.
+ * @param destino Escritor (se ignora si es nulo).
+ */
+void EscritorMultiple::Agregue(std::unique_ptr<Escritor> destino) {
+    if (destino) destinos.push_back(std::move(destino));
+}
+
+/**
+ * @brief Entrega el cuadro a cada escritor, en orden.
+ * @param c Cuadro a escribir.
+ */
+void EscritorMultiple::Escriba(const Cuadro& c) {
+    for (auto& d : destinos)
+        d->Escriba(c);
+}
+
+/** @brief Cierra todos los escritores. */
+void EscritorMultiple::Cierre() {
+    for (auto& d : destinos)
+        d->Cierre();
+}
+
+// ==========================================================
+//                      FORMATO BINARIO
+// ==========================================================
+
+/**
+ * @brief Abre el archivo binario y escribe la cabecera.
+ * @param ruta Ruta del archivo.
+ * @param cab Parámetros de la corrida.
+ * @param bytes_real_ 4 (float32) u 8 (float64).
+ */
+EscritorBinario::EscritorBinario(const std::string& ruta, const CabeceraTrayectoria& cab, int bytes_real_)
+    : f(ruta, std::ios::binary), bytes_real(bytes_real_), N(cab.N) {
+    if (bytes_real != 4 && bytes_real != 8)
+        throw std::invalid_argument("El formato binario solo admite reales de 4 u 8 bytes.");
+    if (!f)
+        throw std::runtime_error("No se pudo abrir el archivo de salida: " + ruta);
+
+    CabeceraDisco d{};
+    std::memcpy(d.magia, "BILLARTJ", 8);
+    d.version = 1;
+    d.bytes_real = static_cast<std::uint32_t>(bytes_real);
+    d.campos = 4;
+    d.banderas = 0;
+    d.N = cab.N;
+    d.W = cab.W;
+    d.H = cab.H;
+    d.R = cab.R;
+    d.dt_frame = cab.dt_frame;
+    f.write(reinterpret_cast<const char*>(&d), sizeof(d));
+
+    buffer.resize(sizeof(double) + 4 * N * bytes_real);
+}
+
+/**
+ * @brief Empaqueta el cuadro en el búfer y lo escribe con una sola llamada.
+ * @param c Cuadro con N bolas.
+ */
+void EscritorBinario::Escriba(const Cuadro& c) {
+    if (c.Tamano() != N)
+        throw std::invalid_argument("El cuadro no tiene el número de bolas declarado en la cabecera.");
+    char* p = buffer.data();
+    std::memcpy(p, &c.t, sizeof(double));
+    p += sizeof(double);
+    if (bytes_real == 4) Empaquete<float>(p, c);
+    else Empaquete<double>(p, c);
+    f.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+/** @brief Cierra el archivo binario. */
+void EscritorBinario::Cierre() {
+    if (f.is_open()) f.close();
+}
@@ -0,0 +1,122 @@
+/**
+ * @file Vecinos.cpp
+ * @brief Implementación de las listas de vecinos con piel.
+ */
+
+#include "Vecinos.h"
+#include "Bola.h"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Define la piel de la lista y la invalida.
+ * @param p Piel.
+ */
+void ListaVecinos::DefinaPiel(double p) {
+    if (!(p > 0.0))
+        throw std::invalid_argument("La piel de la lista de vecinos debe ser positiva.");
+    piel = p;
+    valida = false;
+}
+
+/**
+ * @brief Compara el desplazamiento de cada bola desde la construcción con piel/2.
+ *
+ * El desplazamiento incluye todo lo que movió a la bola: el avance, el espejo
+ * en las paredes y las correcciones de superposición.
+ *
+ * @param bolas Bolas del sistema.
+ */
+template <class Real>
+bool ListaVecinos::DebeReconstruir(const ParticulasT<Real>& bolas) const {
+    const std::size_t N = bolas.Tamano();
+    if (!valida || x0.size() != N)
+        return true;
+    const double limite2 = 0.25 * piel * piel;
+    for (std::size_t i = 0; i < N; ++i) {
+        const double dx = bolas.x[i] - x0[i];
+        const double dy = bolas.y[i] - y0[i];
+        if (dx * dx + dy * dy > limite2)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Reconstruye la lista a partir de una rejilla de celdas si hace falta.
+ * @param bolas Bolas del sistema.
+ * @param C Caja.
+ * @return true si se reconstruyó.
+ */
+template <class Real>
+bool ListaVecinos::Actualice(const ParticulasT<Real>& bolas, const Caja& C) {
+    if (!DebeReconstruir(bolas))
+        return false;
+
+    const int N = static_cast<int>(bolas.Tamano());
+    double r_max = 0.0;
+    for (double r : bolas.r)
+        r_max = std::max(r_max, r);
+    celdas.Defina(C, 2.0 * r_max + piel);
+    celdas.Construya(bolas);
+
+    inicio.resize(static_cast<std::size_t>(N) + 1);
+    socios.clear();
+    for (int i = 0; i < N; ++i) {
+        inicio[i] = static_cast<int>(socios.size());
+        const double xi = bolas.x[i], yi = bolas.y[i], ri = bolas.r[i];
+        celdas.RecorraVecinas(i, [&](int j) {
+            if (j <= i) return;
+            const double dx = bolas.x[j] - xi;
+            const double dy = bolas.y[j] - yi;
+            const double alcance = ri + bolas.r[j] + piel;
+            if (dx * dx + dy * dy < alcance * alcance)
+                socios.push_back(j);
+        });
+    }
+    inicio[N] = static_cast<int>(socios.size());
+
+    x0.assign(bolas.x.begin(), bolas.x.end());
+    y0.assign(bolas.y.begin(), bolas.y.end());
+    valida = true;
+    ++construcciones;
+    return true;
+}
+
+/**
+ * @brief Recorre la lista en orden de i creciente.
+ * @param bolas Bolas del sistema.
+ * @return Pares probados.
+ */
+template <class Real>
+ConteoChoques ListaVecinos::ResuelvaChoques(ParticulasT<Real>& bolas) {
+    const int N = static_cast<int>(inicio.size()) - 1;
+    ConteoChoques conteo;
+    for (int i = 0; i < N; ++i) {
+        BolaT<Real> bi(bolas, i);
+        for (int k = inicio[i]; k < inicio[i + 1]; ++k) {
+            const unsigned efecto = bi.ChoqueElastico(BolaT<Real>(bolas, socios[k]));
+            if constexpr (INSTRUMENTACION_ACTIVA)
+                conteo.Agregue(efecto);
+        }
+    }
+    conteo.pruebas = socios.size();
+    ++usos;
+    entradas += socios.size();
+    return conteo;
+}
+
+template bool ListaVecinos::Actualice<double>(const Particulas&, const Caja&);
+template bool ListaVecinos::Actualice<float>(const ParticulasT<float>&, const Caja&);
+template ConteoChoques ListaVecinos::ResuelvaChoques<double>(Particulas&);
+template ConteoChoques ListaVecinos::ResuelvaChoques<float>(ParticulasT<float>&);
+
+/**
+ * @brief Pares por bola promediados sobre los usos.
+ * @param N Número de bolas.
+ */
+double ListaVecinos::GetLargoMedio(std::size_t N) const {
+    if (usos == 0 || N == 0)
+        return 0.0;
+    return static_cast<double>(entradas) / (static_cast<double>(usos) * N);
+}